@@ -0,0 +1,120 @@
+#include "BotPlayer.hpp"
+
+#include <iostream>
+
+using namespace Bitboards;
+
+/**
+ * @brief Parameterized constructor.
+ * @param limits The limits of every search the bot runs for its own moves
+ * @param table The transposition table to search with, possibly shared with other searchers
+ */
+BotPlayer::BotPlayer(const SearchLimits& limits, std::shared_ptr<TranspositionTable> table)
+    : searcher_{table}, limits_{limits}, ponder_enabled_{true}, book_{nullptr}, ponder_result_{EngineMove(), 0, 0, 0, 0, {}} {}
+
+/**
+ * @brief Destructor. Stops any pondering search.
+ */
+BotPlayer::~BotPlayer() {
+    setPondering(false);
+}
+
+/**
+ * @brief Makes the bot play moves from `book` while it has any. nullptr disables the book.
+ *        The book must outlive the bot.
+ */
+void BotPlayer::setBook(PolyglotBook* book) {
+    book_ = book;
+}
+
+/**
+ * @brief Enables / disables pondering. Disabling it stops any pondering search.
+ */
+void BotPlayer::setPondering(bool enabled) {
+    ponder_enabled_ = enabled;
+    if (!enabled && ponder_thread_.joinable()) {
+        searcher_.stop();
+        ponder_thread_.join();
+        searcher_.resetRequests();
+    }
+}
+
+/**
+ * @return True while a pondering search runs in the background
+ */
+bool BotPlayer::isPondering() const {
+    return ponder_thread_.joinable();
+}
+
+/**
+ * @brief Plays the book move, or else the best move found by searching, for the side to move of `board`,
+ *        then starts pondering on the expected reply if pondering is enabled
+ * @return True if a move was played. False if there was no move to play.
+ */
+bool BotPlayer::playRound(ChessBoard& board) {
+    Position position = Position::fromBoard(board);
+
+    const bool ponder_hit = finishPondering(position);
+
+    SearchResult result{EngineMove(), 0, 0, 0, 0, {}, {}};
+    EngineMove book_move = book_ ? book_->probe(position) : EngineMove();
+    if (!book_move.isNull()) {
+        // Book moves come without an expected reply, so the bot does not ponder after them
+        result.best_move = book_move;
+        result.pv.push_back(book_move);
+    } else {
+        result = ponder_hit ? ponder_result_ : searcher_.search(position, limits_);
+    }
+    if (result.best_move.isNull()) { return false; }
+
+    const int from = result.best_move.from();
+    const int to = result.best_move.to();
+    if (!board.attemptMove(rowOf(from), colOf(from), rowOf(to), colOf(to))) { return false; }
+    std::cout << "[BOT] Moved (" << rowOf(from) << "," << colOf(from) << ") to (" << rowOf(to) << "," << colOf(to) << ")" << std::endl;
+
+    if (ponder_enabled_) { startPondering(Position::fromBoard(board), result); }
+    return true;
+}
+
+/**
+ * @brief Starts pondering on the position after `best_move` and the expected reply, if any
+ * @param position The position the bot just played `result.best_move` in
+ */
+void BotPlayer::startPondering(const Position& position, const SearchResult& result) {
+    if (result.pv.size() < 2) { return; }
+
+    ponder_position_ = position;
+    MoveList replies;
+    MoveGen::generateLegal(ponder_position_, replies);
+    if (!replies.contains(result.pv[1])) { return; }
+
+    UndoInfo undo;
+    ponder_position_.makeMove(result.pv[1], undo);
+    // A ChessBoard never allows en passant, so the position on the board will not have it either
+    ponder_position_.setEnPassantSquare(NO_SQUARE);
+
+    SearchLimits limits = limits_;
+    limits.ponder = true;
+    ponder_thread_ = std::thread([this, limits]() {
+        Position searched = ponder_position_;
+        ponder_result_ = searcher_.search(searched, limits);
+    });
+}
+
+/**
+ * @brief Waits for the pondering search, if any, after telling it whether `position` was hit
+ * @return True if the pondering search searched `position`: its result is in ponder_result_
+ */
+bool BotPlayer::finishPondering(const Position& position) {
+    if (!ponder_thread_.joinable()) { return false; }
+
+    const bool hit = (position.key() == ponder_position_.key());
+    if (hit) {
+        searcher_.ponderhit();
+    } else {
+        searcher_.stop();
+    }
+    ponder_thread_.join();
+    searcher_.resetRequests();
+    return hit;
+}
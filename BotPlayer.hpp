@@ -0,0 +1,87 @@
+/**
+ * @class BotPlayer
+ * @brief Plays moves on a ChessBoard with the search engine, and thinks on the opponent's time.
+ *
+ * After each of its moves, the bot predicts the opponent's reply (the second move of its
+ * principal variation) and starts searching the resulting position on a background thread
+ * while the opponent is still thinking ("pondering").
+ *
+ * Positions found in an opening book, if one is set, are played from the book without searching.
+ *
+ * When the bot is asked for its next move, the pondering search either:
+ *  - searched the position actually on the board (a "ponder hit"): it is told so through
+ *    Searcher::ponderhit(), carries on with the normal time limits, and its result is played.
+ *  - searched another position: it is stopped and a fresh search is run. It was not wasted
+ *    entirely, since both searches share the transposition table.
+ */
+
+#pragma once
+
+#include <memory>
+#include <thread>
+
+#include "ChessBoard.hpp"
+#include "engine_module.hpp"
+
+class BotPlayer {
+    private:
+        Searcher searcher_;
+        SearchLimits limits_;   // Limits of every move the bot plays
+        bool ponder_enabled_;
+        PolyglotBook* book_;    // Opening book to play from first, if any (not owned)
+
+        std::thread ponder_thread_;  // Runs the pondering search, if any
+        Position ponder_position_;   // The position being pondered
+        SearchResult ponder_result_; // Written by the pondering search, read once it is joined
+
+        /**
+         * @brief Starts pondering on the position after `best_move` and the expected reply, if any
+         * @param position The position the bot just played `result.best_move` in
+         */
+        void startPondering(const Position& position, const SearchResult& result);
+
+        /**
+         * @brief Waits for the pondering search, if any, after telling it whether `position` was hit
+         * @return True if the pondering search searched `position`: its result is in ponder_result_
+         */
+        bool finishPondering(const Position& position);
+
+    public:
+        /**
+         * @brief Parameterized constructor.
+         * @param limits The limits of every search the bot runs for its own moves
+         * @param table The transposition table to search with, possibly shared with other searchers
+         */
+        BotPlayer(const SearchLimits& limits, std::shared_ptr<TranspositionTable> table = nullptr);
+
+        /**
+         * @brief Destructor. Stops any pondering search.
+         */
+        ~BotPlayer();
+
+        BotPlayer(const BotPlayer&) = delete;
+        BotPlayer& operator=(const BotPlayer&) = delete;
+
+        /**
+         * @brief Makes the bot play moves from `book` while it has any. nullptr disables the book.
+         *        The book must outlive the bot.
+         */
+        void setBook(PolyglotBook* book);
+
+        /**
+         * @brief Enables / disables pondering. Disabling it stops any pondering search.
+         */
+        void setPondering(bool enabled);
+
+        /**
+         * @return True while a pondering search runs in the background
+         */
+        bool isPondering() const;
+
+        /**
+         * @brief Plays the book move, or else the best move found by searching, for the side to move of `board`,
+         *        then starts pondering on the expected reply if pondering is enabled
+         * @return True if a move was played. False if there was no move to play.
+         */
+        bool playRound(ChessBoard& board);
+};
@@ -1,4 +1,7 @@
 #include "ChessBoard.hpp"
+#include "engine/Stats.hpp"
+
+#include <iterator>
 
 /**
  * Colors the given text using the specified color code.
@@ -10,26 +13,63 @@
  * @return The colored text string, or the original text if the color is not found.
  */
 std::string BoardColorizer::colorText(const std::string& text, const std::string& color) {
-    std::unordered_map<std::string, std::string> COLOR_CODES = {
-        {"BLACK", "\033[1;90m"},
-        {"RED", "\033[1;31m"},
-        {"GREEN", "\033[1;32m"},
-        {"YELLOW", "\033[1;33m"},
-        {"BLUE", "\033[1;34m"},
-        {"MAGENTA", "\033[1;35m"},
-        {"CYAN", "\033[1;36m"},
-        {"WHITE", "\033[1;37m"}
-    };
-    
-    const std::string& code = COLOR_CODES[color];
+    const std::string_view code = colorCode(color);
     if (code.empty()) { return text; }
-    return code + text + "\033[0m";
+    return std::string(code) + text + std::string(RESET_CODE);
+}
+
+/**
+ * Looks up the ANSI escape sequence of a color, without allocating.
+ *
+ * @param color The color name.
+ * @return The escape sequence, or an empty view if the color is not found.
+ */
+std::string_view BoardColorizer::colorCode(const std::string& color) {
+    for (const ColorCode& entry : COLOR_CODES) {
+        if (color == entry.name) { return entry.code; }
+    }
+    return {};
+}
+
+namespace {
+    /**
+     * @brief Appends the decimal digits of `number` (non-negative) to `buffer`
+     */
+    void appendNumber(std::string& buffer, int number) {
+        char digits[12];
+        int count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + number % 10);
+            number /= 10;
+        } while (number > 0);
+        while (count > 0) { buffer += digits[--count]; }
+    }
+
+    const char SNAPSHOT_MAGIC[4] = {'P', '6', 'C', 'B'};
+    const size_t SNAPSHOT_HEADER_SIZE = 15;
+    const uint8_t NO_INDEX = 0xFF;  // No cell, or no piece
+
+    // Bits of a piece's first byte, after its kind
+    const uint8_t PLAYER_ONE_BIT = 1 << 3;
+    const uint8_t MOVING_UP_BIT = 1 << 4;
+    const uint8_t MOVED_BIT = 1 << 5;
+    const uint8_t ON_BOARD_BIT = 1 << 6;
+
+    /**
+     * @return The index of `color` in BoardColorizer::COLOR_CODES, or NO_INDEX if it has none
+     */
+    uint8_t colorIndex(const std::string& color) {
+        for (size_t i = 0; i < std::size(BoardColorizer::COLOR_CODES); i++) {
+            if (color == BoardColorizer::COLOR_CODES[i].name) { return static_cast<uint8_t>(i); }
+        }
+        return NO_INDEX;
+    }
 }
 
 /**
     * Default constructor. 
     * @post The board is setup with the following restrictions:
-    * 1) board is initialized to a 8x8 2D vector of ChessPiece pointers
+    * 1) board is initialized to a Geometry::ROW_COUNT x Geometry::COLUMN_COUNT (8x8) 2D vector of ChessPiece pointers
     *      - ChessPiece derived classes are dynamically allocated and constructed as follows:
     *          - Pieces on the BOTTOM half of the board are set to have color "BLACK"
     *          - Pieces on the UPPER half of the board are set to have color "WHITE"
@@ -52,12 +92,16 @@ std::string BoardColorizer::colorText(const std::string& text, const std::string
     *              0 1 2 3 4 5 6 7
     *      
     *          (With * denoting empty cells)
+    *
+    *          The back ranks follow Geometry::BACK_RANK, and pawns fill the rows next to them.
     * 
     * 2) playerOneTurn is set to true.
     * 3) p1_color is set to "BLACK", and p2_color is set to "WHITE"
     */
-ChessBoard::ChessBoard(const std::string& assignedColorP1, const std::string& assignedColorP2)
-    : playerOneTurn{true}, p1_color{assignedColorP1}, p2_color{assignedColorP2}, board{std::vector(8, std::vector<ChessPiece*>(8)) } {
+template <class Geometry>
+BasicChessBoard<Geometry>::BasicChessBoard(const std::string& assignedColorP1, const std::string& assignedColorP2)
+    : playerOneTurn{true}, p1_color{assignedColorP1}, p2_color{assignedColorP2}, log_{&std::cout},
+      board{Board(Geometry::ROW_COUNT, std::vector<BasicChessPiece<Geometry>*>(Geometry::COLUMN_COUNT))} {
         
         // If the colors used are not available, or if we've specified the same color for Player One & Two
         // default to BLACK and WHITE
@@ -68,39 +112,40 @@ ChessBoard::ChessBoard(const std::string& assignedColorP1, const std::string& as
         }
 
         // Allocate pieces
-        auto add_mirrored = [this] (const int& i, const std::string& type) {
-            if (type == "PAWN") {
-                board[1][i] = new Pawn(p1_color, 1, i, true);
-                board[6][i] = new Pawn(p2_color, 6, i);
-            } else if (type == "ROOK") {
-                board[0][i] = new Rook(p1_color, 0, i);
-                board[7][i] = new Rook(p2_color, 7, i);
-            } else if (type == "KNIGHT") {
-                board[0][i] = new Knight(p1_color, 0, i);
-                board[7][i] = new Knight(p2_color, 7, i);            
-            } else if (type == "BISHOP") {
-                board[0][i] = new Bishop(p1_color, 0, i);
-                board[7][i] = new Bishop(p2_color, 7, i);
-            } else if (type == "KING") {
-                board[0][i] = new King(p1_color, 0, i);
-                board[7][i] = new King(p2_color, 7, i);
-            } else if (type == "QUEEN") {
-                board[0][i] = new Queen(p1_color, 0, i);
-                board[7][i] = new Queen(p2_color, 7, i);
+        const int last_row = Geometry::ROW_COUNT - 1;
+        auto add_mirrored = [this, last_row] (const int& i, const char& type) {
+            if (type == 'P') {
+                board[1][i] = new BasicPawn<Geometry>(p1_color, 1, i, true);
+                board[last_row - 1][i] = new BasicPawn<Geometry>(p2_color, last_row - 1, i);
+            } else if (type == 'R') {
+                board[0][i] = new BasicRook<Geometry>(p1_color, 0, i);
+                board[last_row][i] = new BasicRook<Geometry>(p2_color, last_row, i);
+            } else if (type == 'N') {
+                board[0][i] = new BasicKnight<Geometry>(p1_color, 0, i);
+                board[last_row][i] = new BasicKnight<Geometry>(p2_color, last_row, i);
+            } else if (type == 'B') {
+                board[0][i] = new BasicBishop<Geometry>(p1_color, 0, i);
+                board[last_row][i] = new BasicBishop<Geometry>(p2_color, last_row, i);
+            } else if (type == 'K') {
+                board[0][i] = new BasicKing<Geometry>(p1_color, 0, i);
+                board[last_row][i] = new BasicKing<Geometry>(p2_color, last_row, i);
+            } else if (type == 'Q') {
+                board[0][i] = new BasicQueen<Geometry>(p1_color, 0, i);
+                board[last_row][i] = new BasicQueen<Geometry>(p2_color, last_row, i);
             }
         };
 
-        std::vector<std::string> inner_pieces = {"ROOK", "KNIGHT", "BISHOP", "KING", "QUEEN", "BISHOP", "KNIGHT", "ROOK"};
-        for (size_t i = 0; i < BOARD_LENGTH; i++) {
-            add_mirrored(i, "PAWN");
-            add_mirrored(i, inner_pieces[i]);
+        for (int i = 0; i < Geometry::COLUMN_COUNT; i++) {
+            add_mirrored(i, 'P');
+            add_mirrored(i, Geometry::BACK_RANK[i]);
         }
 
         // Track all added pieces from the board.
-        for (size_t row = 0; row < BOARD_LENGTH; row++) {
-            for (size_t col = 0; col < BOARD_LENGTH; col++) {
+        for (int row = 0; row < Geometry::ROW_COUNT; row++) {
+            for (int col = 0; col < Geometry::COLUMN_COUNT; col++) {
                 if (!board[row][col]) { continue; }
                 pieces.push_front(board[row][col]);
+                addToList(*board[row][col], Geometry::cell(row, col));
             }
         }
     }
@@ -115,12 +160,14 @@ ChessBoard::ChessBoard(const std::string& assignedColorP1, const std::string& as
  *                 2D vector of ChessPiece* pointers.
  * @param p1Turn   A boolean indicating whether it's Player 1's turn to play.
  */
-ChessBoard::ChessBoard(const std::vector<std::vector<ChessPiece*>>& instance, const bool& p1Turn) : playerOneTurn{p1Turn}, p1_color{"BLACK"}, p2_color{"WHITE"}, board{instance} {
+template <class Geometry>
+BasicChessBoard<Geometry>::BasicChessBoard(const Board& instance, const bool& p1Turn) : playerOneTurn{p1Turn}, p1_color{"BLACK"}, p2_color{"WHITE"}, log_{&std::cout}, board{instance} {
     // Track all added pieces from the board.
-    for (size_t row = 0; row < BOARD_LENGTH; row++) {
-        for (size_t col = 0; col < BOARD_LENGTH; col++) {
+    for (int row = 0; row < Geometry::ROW_COUNT; row++) {
+        for (int col = 0; col < Geometry::COLUMN_COUNT; col++) {
             if (!board[row][col]) { continue; }
             pieces.push_front(board[row][col]);
+            addToList(*board[row][col], Geometry::cell(row, col));
         }
     }
 }
@@ -132,14 +179,16 @@ ChessBoard::ChessBoard(const std::vector<std::vector<ChessPiece*>>& instance, co
  * @param col The column of the cell
  * @return ChessPiece* A pointer to the ChessPiece* at the cell specified by (row, col) on the board
  */
-ChessPiece* ChessBoard::getCell(const int& row, const int& col) const {
+template <class Geometry>
+BasicChessPiece<Geometry>* BasicChessBoard<Geometry>::getCell(const int& row, const int& col) const {
     return board[row][col];
 }
 
 /**
  * @brief Getter for board_ member
  */
-std::vector<std::vector<ChessPiece*>> ChessBoard::getBoardState() const {
+template <class Geometry>
+typename BasicChessBoard<Geometry>::Board BasicChessBoard<Geometry>::getBoardState() const {
     return board;
 }
 
@@ -147,7 +196,8 @@ std::vector<std::vector<ChessPiece*>> ChessBoard::getBoardState() const {
  * @brief Destructor. 
  * @post Deallocates all ChessPiece pointers that were ever used on the board.
  */
-ChessBoard::~ChessBoard() {
+template <class Geometry>
+BasicChessBoard<Geometry>::~BasicChessBoard() {
     for (auto& piece_ptr : pieces) {
         if (!piece_ptr) { continue; }
         delete piece_ptr;
@@ -164,39 +214,80 @@ ChessBoard::~ChessBoard() {
  * @post Display row / column headers & symbols for pieces on the board
  *       where each piece is colored based on the color representing the 
  *       player they belong to
+ *
+ * @param out The stream to print to. The board is rendered (see render()) into a
+ *        per-thread buffer first, then written with a single write & flush.
+ * @param colored Whether to color the pieces. Otherwise, plain text is printed.
  */
-void ChessBoard::display() const {
-    // Extract piece symbol logic
-    // 1) Nullptr (empty space) -> *
-    // 2) Knight -> N; otherwise get first character of type
-    auto getPieceSymbol = [this](ChessPiece* piece) {
-        if (!piece) { return std::string(1, '*'); }
-        
-        char symbol = 
-        (piece->getType() == "KNIGHT") 
-            ? 'N' 
-            : piece->getType()[0];
-        
-        // Give colored text based on piece color
-        return BoardColorizer::colorText(std::string(1, symbol), piece->getColor());
-    };
+template <class Geometry>
+void BasicChessBoard<Geometry>::display(std::ostream& out, bool colored) const {
+    thread_local std::string buffer;
+    render(buffer, colored);
+    out.write(buffer.data(), buffer.size());
+    out.flush();
+}
+
+/**
+ * @brief Formats the board exactly as display() prints it into `buffer`, replacing its contents
+ * @param buffer Reserved to RENDER_CAPACITY characters, so that a buffer reused
+ *        across calls never allocates again
+ * @param colored Whether to wrap each piece in the ANSI escape sequence of its color
+ */
+template <class Geometry>
+void BasicChessBoard<Geometry>::render(std::string& buffer, bool colored) const {
+    buffer.clear();
+    buffer.reserve(RENDER_CAPACITY);
+
+    // Both players' sequences are looked up once, not per piece
+    const std::string_view p1_code = colored ? BoardColorizer::colorCode(p1_color) : std::string_view();
+    const std::string_view p2_code = colored ? BoardColorizer::colorCode(p2_color) : std::string_view();
 
     // Print frame & cells
-    for (int row = BOARD_LENGTH - 1; row >= 0; row--) {
-        std::cout << row << " | ";
-        for (size_t col = 0; col < BOARD_LENGTH; col++) {
-            std::cout << getPieceSymbol(board[row][col]) << " ";
+    for (int row = Geometry::ROW_COUNT - 1; row >= 0; row--) {
+        appendNumber(buffer, row);
+        buffer += " | ";
+        for (int col = 0; col < Geometry::COLUMN_COUNT; col++) {
+            const BasicChessPiece<Geometry>* piece = board[row][col];
+            if (!piece) {
+                buffer += "* ";
+                continue;
+            }
+
+            // A piece of unknown kind shows the first letter of its type
+            const char glyph = (piece->kind() == PieceKind::NONE)
+                ? piece->getType()[0]
+                : BoardColorizer::PIECE_GLYPHS[static_cast<int>(piece->kind())];
+            std::string_view code;
+            if (colored) {
+                if (piece->hasColor(p1_color)) { code = p1_code; }
+                else if (piece->hasColor(p2_color)) { code = p2_code; }
+                else { code = BoardColorizer::colorCode(piece->getColor()); }
+            }
+
+            if (code.empty()) {
+                buffer += glyph;
+            } else {
+                buffer += code;
+                buffer += glyph;
+                buffer += BoardColorizer::RESET_CODE;
+            }
+            buffer += ' ';
         }
-        std::cout << std::endl;
+        buffer += '\n';
     }
 
     // Pad left with spaces, add horizontal line
-    std::cout << std::string(4, ' ') << std::string(15, '-') << std::endl;
-    std::cout << std::string(4, ' ');
-    
+    buffer.append(4, ' ');
+    buffer.append(2 * Geometry::COLUMN_COUNT - 1, '-');
+    buffer += '\n';
+    buffer.append(4, ' ');
+
     // Label columns
-    for (size_t col = 0; col < BOARD_LENGTH; col++) { std::cout << col << " "; }
-    std::cout << std::endl;
+    for (int col = 0; col < Geometry::COLUMN_COUNT; col++) {
+        appendNumber(buffer, col);
+        buffer += ' ';
+    }
+    buffer += '\n';
 }
 
 /**
@@ -205,7 +296,7 @@ void ChessBoard::display() const {
 * @return True if the move was successfullcol executed. 
 * 
 *      A move is possible if:
-*      1) (row,col) is a valid space on the board ( ie. within [0, BOARD_LENGTH) )
+*      1) (row,col) is a valid space on the board ( ie. Geometry::contains(row, col) )
 *      2) There exists a piece at (row,col)
 *      3) The color of the piece equals the color of the current player whose turn it is
 *      4) The piece "can move" to the target location (new_row, new_col) 
@@ -218,24 +309,27 @@ void ChessBoard::display() const {
 *      - The moved piece's row and col members are updated to reflect the move
 *      If a pawn is moved from its start position, its double_jumpable_ flag is set to false.. 
 */
-bool ChessBoard::move(const int& row, const int& col, const int& new_row, const int& new_col) {
-    if (row < 0 || col < 0 || row >= BOARD_LENGTH || col >= BOARD_LENGTH) { 
+template <class Geometry>
+bool BasicChessBoard<Geometry>::move(const int& row, const int& col, const int& new_row, const int& new_col) {
+    Stats::increment(Stats::BOARD_MOVES);
+    if (!Geometry::contains(row, col)) { 
         return false; 
     }
-    if (new_row < 0 || new_col < 0 || new_row >= BOARD_LENGTH || new_col >= BOARD_LENGTH) { 
+    if (!Geometry::contains(new_row, new_col)) { 
         return false; 
     }
-    ChessPiece* movingPiece = board[row][col];
+    BasicChessPiece<Geometry>* movingPiece = board[row][col];
     const std::string& colorInPlay = (playerOneTurn) ? p1_color : p2_color;
     // If there is no piece to move or it is of the opposite color, terminate
     if (!movingPiece) { return false; }
     if (movingPiece->getColor() != colorInPlay) { return false; }
 
     // If we can't move, terminate
-    if (!movingPiece->canMove(new_row, new_col, board)) { return false; }
+    Stats::increment(Stats::CAN_MOVE_CALLS);
+    if (!MoveRules::canMove(*movingPiece, new_row, new_col, board)) { return false; }
 
     // Store captured piece
-    ChessPiece* captured_piece = board[new_row][new_col];
+    BasicChessPiece<Geometry>* captured_piece = board[new_row][new_col];
 
     // Cannot capture a King in chess
     if (captured_piece && captured_piece->getType() == "KING") { return false; }
@@ -249,6 +343,9 @@ bool ChessBoard::move(const int& row, const int& col, const int& new_row, const
     movingPiece->setRow(new_row);
     movingPiece->setColumn(new_col);
     movingPiece->flagMoved();
+
+    if (captured_piece) { removeFromList(*captured_piece, Geometry::cell(new_row, new_col)); }
+    moveInList(*movingPiece, Geometry::cell(row, col), Geometry::cell(new_row, new_col));
     
     return true;
 }
@@ -272,7 +369,8 @@ bool ChessBoard::move(const int& row, const int& col, const int& new_row, const
  *      - Or a move was successfully undone.
  * @post The `past_moves_` stack & `playerOneTurn` members are updated as described above
  */
-bool ChessBoard::attemptRound() {
+template <class Geometry>
+bool BasicChessBoard<Geometry>::attemptRound() {
     //Initialize user input variables
     int initial_row, initial_col, selected_row, selected_col;
 
@@ -308,15 +406,8 @@ bool ChessBoard::attemptRound() {
         return false;
     }
 
-    //Step 5: Attempt to execute the move
-    ChessPiece* moved_piece1 = getPieceAt(initial_row, initial_col);
-    ChessPiece* captured_piece1 = getPieceAt(selected_row, selected_col);
-    if ((move(initial_row, initial_col, selected_row, selected_col))) {
-        //Step 6: If the move was executed succesfully, push a Move to past_moves_
-        Move move({initial_row, initial_col}, {selected_row, selected_col}, moved_piece1, captured_piece1);
-        past_moves_.push(move);
-        //Step 7: If the move was executed successfully, toggle the playerOneTurn member of ChessBoard
-        playerOneTurn = !playerOneTurn; 
+    //Steps 5-7: Attempt to execute the move, record it and toggle the turn
+    if (attemptMove(initial_row, initial_col, selected_row, selected_col)) {
         std::cout << "Moved (" << initial_row << "," << initial_col << ") to (" << selected_row << "," << selected_col << ")" << std::endl;
         return true;
     /// If the move was not executed successfully, print that it was unable to move the piece.     
@@ -327,6 +418,28 @@ bool ChessBoard::attemptRound() {
     } 
 }
 
+/**
+ * @brief Plays a full move for the player whose turn it is, without prompting:
+ *        attempts the move using move(), and if it succeeds, records it by pushing
+ *        a Move to past_moves_ and toggles `playerOneTurn` (steps 5 to 7 of attemptRound)
+ * 
+ * @return True if the move was executed. False otherwise (nothing changes).
+ */
+template <class Geometry>
+bool BasicChessBoard<Geometry>::attemptMove(const int& row, const int& col, const int& new_row, const int& new_col) {
+    //Step 5: Attempt to execute the move
+    BasicChessPiece<Geometry>* moved_piece = getPieceAt(row, col);
+    BasicChessPiece<Geometry>* captured_piece = getPieceAt(new_row, new_col);
+    if (!move(row, col, new_row, new_col)) { return false; }
+
+    //Step 6: If the move was executed succesfully, push a Move to past_moves_
+    past_moves_.push_back(BasicMove<Geometry>({row, col}, {new_row, new_col}, moved_piece, captured_piece));
+
+    //Step 7: If the move was executed successfully, toggle the playerOneTurn member of ChessBoard
+    playerOneTurn = !playerOneTurn;
+    return true;
+}
+
 /**
  * @brief Reverts the most recent action executed by a player,
  *        if there is a `Move` object in the `past_moves_` stack
@@ -346,22 +459,24 @@ bool ChessBoard::attemptRound() {
  *       3) The most recent `Move` object is removed from the `past_moves_`
  *          stack 
  */ 
- bool ChessBoard::undo() {
+template <class Geometry>
+ bool BasicChessBoard<Geometry>::undo() {
+    Stats::increment(Stats::BOARD_UNDOS);
     //If the stack is empty (ie. no moves to undo), return false
     if (past_moves_.empty()) {
-        std::cout << "No moves to undo." << std::endl;
+        if (log_) { *log_ << "No moves to undo." << std::endl; }
         return false;
     }
 
     //Pop the most recent move
-    Move last_move = past_moves_.top();
-    past_moves_.pop();
+    BasicMove<Geometry> last_move = past_moves_.back();
+    past_moves_.pop_back();
 
     //Get relevant data to undo move
     Square from = last_move.getOriginalPosition(); 
     Square to = last_move.getTargetPosition();     
-    ChessPiece* moved_piece = last_move.getMovedPiece();
-    ChessPiece* captured_piece = last_move.getCapturedPiece();
+    BasicChessPiece<Geometry>* moved_piece = last_move.getMovedPiece();
+    BasicChessPiece<Geometry>* captured_piece = last_move.getCapturedPiece();
 
     //Revert the piece(s) to their original position
     board[from.first][from.second] = moved_piece;
@@ -376,21 +491,303 @@ bool ChessBoard::attemptRound() {
         captured_piece->setColumn(to.second);
     } 
 
+    //Put the piece(s) back in their lists
+    if (moved_piece != nullptr) { moveInList(*moved_piece, Geometry::cell(to.first, to.second), Geometry::cell(from.first, from.second)); }
+    if (captured_piece != nullptr) { addToList(*captured_piece, Geometry::cell(to.first, to.second)); }
+
     //Toggle player one turn back
     playerOneTurn = !playerOneTurn;
 
-    std::cout << "Undo move from (" << from.first << ", " << from.second << ")" << std::endl;
+    if (log_) { *log_ << "Undo move from (" << from.first << ", " << from.second << ")" << std::endl; }
     return true;
 }
 
-bool ChessBoard::isPlayerOneTurn() const{
+template <class Geometry>
+
+bool BasicChessBoard<Geometry>::isPlayerOneTurn() const{
     return playerOneTurn;
 }
 
-ChessPiece* ChessBoard::getPieceAt(int row, int col) const {
-    if (row < 0 || col < 0 || row >= BOARD_LENGTH || col >= BOARD_LENGTH) {
+/**
+ * @brief Sets where undo() reports what it did
+ * @param log The stream to write to, or nullptr to stay silent (std::cout by default)
+ */
+template <class Geometry>
+void BasicChessBoard<Geometry>::setLog(std::ostream* log) {
+    log_ = log;
+}
+
+/**
+ * @brief Getter for p1_color member
+ * @return The color used by Player One's pieces
+ */
+template <class Geometry>
+std::string BasicChessBoard<Geometry>::getPlayerOneColor() const {
+    return p1_color;
+}
+
+template <class Geometry>
+BasicChessPiece<Geometry>* BasicChessBoard<Geometry>::getPieceAt(int row, int col) const {
+    if (!Geometry::contains(row, col)) {
         return nullptr;
     }
     return board[row][col];
 }
 
+/**
+ * @brief Gets the cells of a player's pieces of one kind still on the board, kept up to date by move() & undo()
+ * @param player_one True for Player One's pieces, false for Player Two's
+ * @return The list of cells, in no particular order (empty for PieceKind::NONE)
+ */
+template <class Geometry>
+const typename BasicChessBoard<Geometry>::PieceList& BasicChessBoard<Geometry>::pieceList(bool player_one, PieceKind kind) const {
+    return piece_lists_[player_one ? 0 : 1][static_cast<int>(kind)];
+}
+
+/**
+ * @return A new piece of `kind` (which is not PieceKind::NONE), off the board. It is not owned yet.
+ */
+template <class Geometry>
+BasicChessPiece<Geometry>* BasicChessBoard<Geometry>::newPiece(PieceKind kind) {
+    switch (kind) {
+        case PieceKind::PAWN: return new BasicPawn<Geometry>("BLACK");
+        case PieceKind::KNIGHT: return new BasicKnight<Geometry>("BLACK");
+        case PieceKind::BISHOP: return new BasicBishop<Geometry>("BLACK");
+        case PieceKind::ROOK: return new BasicRook<Geometry>("BLACK");
+        case PieceKind::QUEEN: return new BasicQueen<Geometry>("BLACK");
+        default: return new BasicKing<Geometry>("BLACK");
+    }
+}
+
+/**
+ * @brief Saves the whole game into `buffer`, replacing its contents: the turn, the players'
+ *        colors, every piece (including the captured ones moves can bring back) & the moves
+ *        undo() can take back. See ChessBoard.hpp for the layout.
+ * @return False, leaving `buffer` empty, if the board has more than 254 pieces or a color with no code
+ */
+template <class Geometry>
+bool BasicChessBoard<Geometry>::snapshot(std::string& buffer) const {
+    buffer.clear();
+    const uint8_t p1_index = colorIndex(p1_color);
+    const uint8_t p2_index = colorIndex(p2_color);
+    if (p1_index == NO_INDEX || p2_index == NO_INDEX || pieces.size() >= NO_INDEX) { return false; }
+
+    // Only the pieces on the board or in a move are saved. They are looked up by address,
+    // in `owned` sorted by address, & numbered in the order of `pieces`.
+    std::pair<const BasicChessPiece<Geometry>*, int> owned[NO_INDEX];
+    int owned_count = 0;
+    for (const BasicChessPiece<Geometry>* piece : pieces) {
+        owned[owned_count] = {piece, owned_count};
+        owned_count++;
+    }
+    std::sort(owned, owned + owned_count);
+    const auto find = [&owned, owned_count](const BasicChessPiece<Geometry>* piece) {
+        return std::lower_bound(owned, owned + owned_count, std::make_pair(piece, 0))->second;
+    };
+
+    bool saved[NO_INDEX] = {};
+    for (int row = 0; row < Geometry::ROW_COUNT; row++) {
+        for (int col = 0; col < Geometry::COLUMN_COUNT; col++) {
+            if (board[row][col]) { saved[find(board[row][col])] = true; }
+        }
+    }
+    for (const BasicMove<Geometry>& past_move : past_moves_) {
+        saved[find(past_move.getMovedPiece())] = true;
+        if (past_move.getCapturedPiece()) { saved[find(past_move.getCapturedPiece())] = true; }
+    }
+    uint8_t saved_index[NO_INDEX];
+    int saved_count = 0;
+    for (int i = 0; i < owned_count; i++) {
+        if (saved[i]) { saved_index[i] = static_cast<uint8_t>(saved_count++); }
+    }
+
+    const uint32_t move_count = static_cast<uint32_t>(past_moves_.size());
+    buffer.reserve(SNAPSHOT_HEADER_SIZE + saved_count * 2 + move_count * 4);
+    buffer.append(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    buffer += static_cast<char>(SNAPSHOT_VERSION);
+    buffer += static_cast<char>(Geometry::ROW_COUNT);
+    buffer += static_cast<char>(Geometry::COLUMN_COUNT);
+    buffer += static_cast<char>(playerOneTurn ? 1 : 0);
+    buffer += static_cast<char>(p1_index);
+    buffer += static_cast<char>(p2_index);
+    buffer += static_cast<char>(saved_count);
+    for (int shift = 0; shift < 32; shift += 8) { buffer += static_cast<char>((move_count >> shift) & 0xFF); }
+
+    int index = 0;
+    for (const BasicChessPiece<Geometry>* piece : pieces) {
+        if (!saved[index++]) { continue; }
+        const int row = piece->getRow(), col = piece->getColumn();
+        const bool on_cell = Geometry::contains(row, col);
+        uint8_t flags = static_cast<uint8_t>(piece->kind());
+        if (piece->hasColor(p1_color)) { flags |= PLAYER_ONE_BIT; }
+        if (piece->isMovingUp()) { flags |= MOVING_UP_BIT; }
+        if (piece->hasMoved()) { flags |= MOVED_BIT; }
+        if (on_cell && board[row][col] == piece) { flags |= ON_BOARD_BIT; }
+        buffer += static_cast<char>(flags);
+        buffer += static_cast<char>(on_cell ? Geometry::cell(row, col) : NO_INDEX);
+    }
+
+    for (const BasicMove<Geometry>& past_move : past_moves_) {
+        const Square from = past_move.getOriginalPosition();
+        const Square to = past_move.getTargetPosition();
+        buffer += static_cast<char>(Geometry::cell(from.first, from.second));
+        buffer += static_cast<char>(Geometry::cell(to.first, to.second));
+        buffer += static_cast<char>(saved_index[find(past_move.getMovedPiece())]);
+        buffer += static_cast<char>(past_move.getCapturedPiece() ? saved_index[find(past_move.getCapturedPiece())] : NO_INDEX);
+    }
+    return true;
+}
+
+/**
+ * @brief Replaces the whole game with the one saved in `blob` by snapshot(), on a board of the same geometry.
+ *        The pieces the board already owns are reused, so restoring a standard game onto any board
+ *        that started as one allocates no piece (only the move history may grow); a piece is only allocated when the board has no
+ *        unused piece of its kind left.
+ * @return False, leaving the board unchanged, if `blob` is not a valid snapshot of this version & geometry
+ */
+template <class Geometry>
+bool BasicChessBoard<Geometry>::restore(std::string_view blob) {
+    const auto byte = [&blob](size_t i) { return static_cast<uint8_t>(blob[i]); };
+
+    // Check everything before touching the board
+    if (blob.size() < SNAPSHOT_HEADER_SIZE || blob.compare(0, sizeof(SNAPSHOT_MAGIC), SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) { return false; }
+    if (byte(4) != SNAPSHOT_VERSION || byte(5) != Geometry::ROW_COUNT || byte(6) != Geometry::COLUMN_COUNT || byte(7) > 1) { return false; }
+    const uint8_t p1_index = byte(8), p2_index = byte(9);
+    const size_t color_count = std::size(BoardColorizer::COLOR_CODES);
+    if (p1_index >= color_count || p2_index >= color_count || p1_index == p2_index) { return false; }
+    const int piece_count = byte(10);
+    if (piece_count == NO_INDEX) { return false; }
+    uint32_t move_count = 0;
+    for (int i = 0; i < 4; i++) { move_count |= static_cast<uint32_t>(byte(11 + i)) << (8 * i); }
+    const size_t moves_at = SNAPSHOT_HEADER_SIZE + piece_count * 2;
+    if (blob.size() < moves_at || (blob.size() - moves_at) / 4 != move_count || (blob.size() - moves_at) % 4 != 0) { return false; }
+
+    bool occupied[Geometry::CELL_COUNT] = {};
+    for (int i = 0; i < piece_count; i++) {
+        const uint8_t flags = byte(SNAPSHOT_HEADER_SIZE + i * 2);
+        const uint8_t cell = byte(SNAPSHOT_HEADER_SIZE + i * 2 + 1);
+        const uint8_t kind = flags & 0x07;
+        if (kind == static_cast<uint8_t>(PieceKind::NONE) || kind >= KIND_COUNT || flags > 0x7F) { return false; }
+        if (cell != NO_INDEX && cell >= Geometry::CELL_COUNT) { return false; }
+        if (flags & ON_BOARD_BIT) {
+            if (cell == NO_INDEX || occupied[cell]) { return false; }
+            occupied[cell] = true;
+        }
+    }
+
+    // Take the moves back one by one, newest first, on a board of piece indices: each must find
+    // its piece on its target cell & its origin empty, so that undo() can always take it back
+    int occupant[Geometry::CELL_COUNT];
+    bool placed[NO_INDEX] = {};
+    std::fill(occupant, occupant + Geometry::CELL_COUNT, -1);
+    for (int i = 0; i < piece_count; i++) {
+        if (!(byte(SNAPSHOT_HEADER_SIZE + i * 2) & ON_BOARD_BIT)) { continue; }
+        occupant[byte(SNAPSHOT_HEADER_SIZE + i * 2 + 1)] = i;
+        placed[i] = true;
+    }
+    for (size_t at = blob.size(); at > moves_at; ) {
+        at -= 4;
+        const uint8_t from = byte(at), to = byte(at + 1), moved = byte(at + 2), captured = byte(at + 3);
+        if (from >= Geometry::CELL_COUNT || to >= Geometry::CELL_COUNT || from == to) { return false; }
+        if (occupant[to] != moved || occupant[from] != -1) { return false; }
+        occupant[from] = moved;
+        occupant[to] = -1;
+        if (captured == NO_INDEX) { continue; }
+        if (captured >= piece_count || placed[captured]) { return false; }
+        occupant[to] = captured;
+        placed[captured] = true;
+    }
+
+    // Hand each saved piece one of the board's own pieces of its kind, scanning the saved
+    // pieces of each kind in order, then allocate the ones left over
+    BasicChessPiece<Geometry>* restored[NO_INDEX] = {};
+    int next_of_kind[KIND_COUNT] = {};
+    for (BasicChessPiece<Geometry>* piece : pieces) {
+        const int kind = static_cast<int>(piece->kind());
+        int& next = next_of_kind[kind];
+        while (next < piece_count && (byte(SNAPSHOT_HEADER_SIZE + next * 2) & 0x07) != kind) { next++; }
+        if (next < piece_count) { restored[next++] = piece; }
+        else { piece->setRow(-1); piece->setColumn(-1); } // Unused: off the board, out of every list & move
+    }
+    for (int i = 0; i < piece_count; i++) {
+        if (restored[i]) { continue; }
+        restored[i] = newPiece(static_cast<PieceKind>(byte(SNAPSHOT_HEADER_SIZE + i * 2) & 0x07));
+        pieces.push_back(restored[i]);
+    }
+
+    // Rebuild the board, the piece lists & the moves
+    playerOneTurn = byte(7) == 1;
+    p1_color = BoardColorizer::COLOR_CODES[p1_index].name;
+    p2_color = BoardColorizer::COLOR_CODES[p2_index].name;
+    for (std::vector<BasicChessPiece<Geometry>*>& row : board) { std::fill(row.begin(), row.end(), nullptr); }
+    for (auto& player_lists : piece_lists_) {
+        for (PieceList& list : player_lists) { list.count = 0; }
+    }
+
+    for (int i = 0; i < piece_count; i++) {
+        const uint8_t flags = byte(SNAPSHOT_HEADER_SIZE + i * 2);
+        const uint8_t cell = byte(SNAPSHOT_HEADER_SIZE + i * 2 + 1);
+        BasicChessPiece<Geometry>* piece = restored[i];
+        const std::string& color = (flags & PLAYER_ONE_BIT) ? p1_color : p2_color;
+        if (!piece->hasColor(color)) { piece->setColor(color); }
+        piece->setMovingUp((flags & MOVING_UP_BIT) != 0);
+        piece->setMoved((flags & MOVED_BIT) != 0);
+        piece->setRow(cell == NO_INDEX ? -1 : Geometry::rowOf(cell));
+        piece->setColumn(cell == NO_INDEX ? -1 : Geometry::columnOf(cell));
+        if (flags & ON_BOARD_BIT) {
+            board[Geometry::rowOf(cell)][Geometry::columnOf(cell)] = piece;
+            addToList(*piece, cell);
+        }
+    }
+
+    past_moves_.clear();
+    past_moves_.reserve(move_count);
+    for (size_t at = moves_at; at < blob.size(); at += 4) {
+        const Square from = {Geometry::rowOf(byte(at)), Geometry::columnOf(byte(at))};
+        const Square to = {Geometry::rowOf(byte(at + 1)), Geometry::columnOf(byte(at + 1))};
+        past_moves_.push_back(BasicMove<Geometry>(from, to, restored[byte(at + 2)], byte(at + 3) == NO_INDEX ? nullptr : restored[byte(at + 3)]));
+    }
+    return true;
+}
+
+/**
+ * @return The list `piece` belongs to, by its color & kind
+ */
+template <class Geometry>
+typename BasicChessBoard<Geometry>::PieceList& BasicChessBoard<Geometry>::listOf(const BasicChessPiece<Geometry>& piece) {
+    return piece_lists_[piece.hasColor(p1_color) ? 0 : 1][static_cast<int>(piece.kind())];
+}
+
+/**
+ * @brief Appends `cell`, the cell of `piece`, to its list
+ */
+template <class Geometry>
+void BasicChessBoard<Geometry>::addToList(const BasicChessPiece<Geometry>& piece, int cell) {
+    PieceList& list = listOf(piece);
+    list_index_[cell] = list.count;
+    list.cells[list.count++] = cell;
+}
+
+/**
+ * @brief Removes `cell`, the cell of `piece`, from its list by moving the list's last cell into its slot
+ */
+template <class Geometry>
+void BasicChessBoard<Geometry>::removeFromList(const BasicChessPiece<Geometry>& piece, int cell) {
+    PieceList& list = listOf(piece);
+    const int last = list.cells[--list.count];
+    list.cells[list_index_[cell]] = last;
+    list_index_[last] = list_index_[cell];
+}
+
+/**
+ * @brief Replaces `from` by `to` in the list of `piece`, which moved between them
+ */
+template <class Geometry>
+void BasicChessBoard<Geometry>::moveInList(const BasicChessPiece<Geometry>& piece, int from, int to) {
+    PieceList& list = listOf(piece);
+    list.cells[list_index_[from]] = to;
+    list_index_[to] = list_index_[from];
+}
+
+template class BasicChessBoard<StandardGeometry>;
+template class BasicChessBoard<CapablancaGeometry>;
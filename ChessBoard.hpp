@@ -1,10 +1,12 @@
 /**
- * @class ChessBoard
- * @brief Represents an 8x8 board of Chess Pieces used to play chess
+ * @class BasicChessBoard
+ * @brief Represents a board of Chess Pieces used to play chess, sized by its Geometry (see BoardGeometry.hpp).
+ *        ChessBoard is the standard 8x8 board.
  */
 
 #pragma once
 
+#include <cstdint>
 #include <limits>
 #include <iostream>
 #include <vector>
@@ -14,6 +16,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <stack>
+#include <string_view>
 
 #include "pieces_module.hpp"
 #include "Move.hpp"
@@ -24,6 +27,39 @@ namespace BoardColorizer {
     */
     const std::unordered_set<std::string> ALLOWED_COLORS({"BLACK", "RED", "GREEN", "YELLOW", "BLUE", "MAGENTA", "CYAN", "WHITE"});
 
+    /*
+    The ANSI escape sequence coloring text in each color, & the one resetting it.
+    */
+    struct ColorCode {
+        const char* name;
+        const char* code;
+    };
+    constexpr ColorCode COLOR_CODES[] = {
+        {"BLACK", "\033[1;90m"},
+        {"RED", "\033[1;31m"},
+        {"GREEN", "\033[1;32m"},
+        {"YELLOW", "\033[1;33m"},
+        {"BLUE", "\033[1;34m"},
+        {"MAGENTA", "\033[1;35m"},
+        {"CYAN", "\033[1;36m"},
+        {"WHITE", "\033[1;37m"}
+    };
+    constexpr std::string_view RESET_CODE = "\033[0m";
+    constexpr int MAX_CODE_LENGTH = 7; // Length of the longest sequence of COLOR_CODES
+
+    /*
+    The symbol of each PieceKind on the board ('*' for an empty cell).
+    */
+    constexpr char PIECE_GLYPHS[] = {'*', 'P', 'N', 'B', 'R', 'Q', 'K'};
+
+    /**
+     * Looks up the ANSI escape sequence of a color, without allocating.
+     *
+     * @param color The color name.
+     * @return The escape sequence, or an empty view if the color is not found.
+     */
+    std::string_view colorCode(const std::string& color);
+
     /**
      * Colors the given text using the specified color code.
      *
@@ -35,21 +71,68 @@ namespace BoardColorizer {
      */
     std::string colorText(const std::string& text, const std::string& color);
 };
-class ChessBoard {
+template <class Geometry>
+class BasicChessBoard {
+    public:
+        using Board = typename BasicChessPiece<Geometry>::Board;
+
+        /**
+         * @brief The cells (see BoardGeometry::cell()) of one player's live pieces of one kind, stored contiguously
+         */
+        struct PieceList {
+            int cells[Geometry::CELL_COUNT];
+            int count = 0;
+
+            const int* begin() const { return cells; }
+            const int* end() const { return cells + count; }
+            int size() const { return count; }
+        };
+
     private:
-        // Define board size (8x8)
-        static const int BOARD_LENGTH = 8;
-        
+        static const int KIND_COUNT = static_cast<int>(PieceKind::KING) + 1;
+
         bool playerOneTurn;
         
         std::string p1_color;
         std::string p2_color;
 
-        // Track the board state & all pieces that were ever in play
-        std::vector<std::vector<ChessPiece*>> board;
-        std::list<ChessPiece*> pieces;
+        std::ostream* log_; // Where undo() reports what it did, if anywhere
+
+        // Track the board state & all pieces that were ever in play (they are owned by the board)
+        Board board;
+        std::list<BasicChessPiece<Geometry>*> pieces;
+
+        std::vector<BasicMove<Geometry>> past_moves_; // Stores all previously executed moves, used as a stack
+
+        // The live pieces by [0: Player One, 1: Player Two][kind], & where the piece on each cell
+        // sits in its list, so that adding, removing & moving a piece are all O(1)
+        PieceList piece_lists_[2][KIND_COUNT];
+        int list_index_[Geometry::CELL_COUNT];
+
+        /**
+         * @return The list `piece` belongs to, by its color & kind
+         */
+        PieceList& listOf(const BasicChessPiece<Geometry>& piece);
+
+        /**
+         * @brief Appends `cell`, the cell of `piece`, to its list
+         */
+        void addToList(const BasicChessPiece<Geometry>& piece, int cell);
+
+        /**
+         * @brief Removes `cell`, the cell of `piece`, from its list by moving the list's last cell into its slot
+         */
+        void removeFromList(const BasicChessPiece<Geometry>& piece, int cell);
+
+        /**
+         * @brief Replaces `from` by `to` in the list of `piece`, which moved between them
+         */
+        void moveInList(const BasicChessPiece<Geometry>& piece, int from, int to);
 
-        std::stack<Move> past_moves_; // Stores all previously executed moves
+        /**
+         * @return A new piece of `kind` (which is not PieceKind::NONE), off the board. It is not owned yet.
+         */
+        static BasicChessPiece<Geometry>* newPiece(PieceKind kind);
 
     public:
         /**
@@ -60,7 +143,7 @@ class ChessBoard {
          * @param assignedColorP2 A string denoting the color to use for Player Two
          * 
          * @post The board is setup with the following restrictions:
-         * 1) board is initialized to a 8x8 2D vector of ChessPiece pointers
+         * 1) board is initialized to a Geometry::ROW_COUNT x Geometry::COLUMN_COUNT (8x8) 2D vector of ChessPiece pointers
          *      - ChessPiece derived classes are dynamically allocated and constructed as follows:
          *          - Pieces on the BOTTOM half of the board are set to be "moving up" | of color "BLACK"
          *          - Pieces on the UPPER half of the board are set to be NOT "moving up"| of color "WHITE"
@@ -81,11 +164,13 @@ class ChessBoard {
          *              0 1 2 3 4 5 6 7
          *      
          *          (With * denoting empty cells)
+         *
+         *          The back ranks follow Geometry::BACK_RANK, and pawns fill the rows next to them.
          * 
          * 2) playerOneTurn is set to true.
          * 3) p1_color is set to "BLACK", and p2_color is set to "WHITE" if not provided, or they are equal
          */
-        ChessBoard(const std::string& assignedColorP1 = "BLACK", const std::string& assignedColorP2 = "WHITE");
+        BasicChessBoard(const std::string& assignedColorP1 = "BLACK", const std::string& assignedColorP2 = "WHITE");
 
         /**
          * Constructs a ChessBoard object.
@@ -97,12 +182,12 @@ class ChessBoard {
          *                 2D vector of ChessPiece* pointers.
          * @param p1Turn   A boolean indicating whether it's Player 1's turn to play.
          */
-        ChessBoard(const std::vector<std::vector<ChessPiece*>>& board, const bool& p1Turn);
+        BasicChessBoard(const Board& board, const bool& p1Turn);
 
         /**
          * @brief Getter for board_ member
          */
-        std::vector<std::vector<ChessPiece*>> getBoardState() const;
+        Board getBoardState() const;
 
         /**
         * @brief Moves the piece at (row,col) to (new_row, new_col), if possible
@@ -110,7 +195,7 @@ class ChessBoard {
         * @return True if the move was successfullcol executed. 
         * 
         *      A move is possible if:
-        *      1) (row,col) is a valid space on the board ( ie. within [0, BOARD_LENGTH) )
+        *      1) (row,col) is a valid space on the board ( ie. Geometry::contains(row, col) )
         *      2) There exists a piece at (row,col)
         *      3) The color of the piece equals the color of the current player whose turn it is
         *      4) The piece "can move" to the target location (new_row, new_col) 
@@ -132,13 +217,13 @@ class ChessBoard {
          * @param col The column of the cell
          * @return ChessPiece* A pointer to the ChessPiece* at the cell specified by (row, col) on the board
          */
-        ChessPiece* getCell(const int& row, const int& col) const;
+        BasicChessPiece<Geometry>* getCell(const int& row, const int& col) const;
 
         /**
          * @brief Destructor. 
          * @post Deallocates all ChessPiece pointers that were ever used on the board.
          */
-        ~ChessBoard();
+        ~BasicChessBoard();
         
         /**
          * @brief Utility display function that prints out colored text
@@ -149,8 +234,55 @@ class ChessBoard {
          * @post Display row / column headers & symbols for pieces on the board
          *       where each piece is colored based on the color representing the 
          *       player they belong to
+         *
+         * @param out The stream to print to. The board is rendered (see render()) into a
+         *        per-thread buffer first, then written with a single write & flush.
+         * @param colored Whether to color the pieces. Otherwise, plain text is printed.
+         */
+        void display(std::ostream& out = std::cout, bool colored = true) const;
+
+        /**
+         * @brief Formats the board exactly as display() prints it into `buffer`, replacing its contents
+         * @param buffer Reserved to RENDER_CAPACITY characters, so that a buffer reused
+         *        across calls never allocates again
+         * @param colored Whether to wrap each piece in the ANSI escape sequence of its color
+         */
+        void render(std::string& buffer, bool colored = true) const;
+
+        // Upper bound of the length of a rendering: each row holds its number, a frame &
+        // colored cells, followed by the frame & column numbers at the bottom
+        static constexpr size_t RENDER_CAPACITY =
+            Geometry::ROW_COUNT * (6 + Geometry::COLUMN_COUNT * (BoardColorizer::MAX_CODE_LENGTH + 6))
+            + 4 * Geometry::COLUMN_COUNT + 16;
+
+        // Version written in (& the only one read from) snapshots. Bump it whenever their layout changes.
+        static constexpr uint8_t SNAPSHOT_VERSION = 1;
+
+        /**
+         * @brief Saves the whole game into `buffer`, replacing its contents: the turn, the players'
+         *        colors, every piece (including the captured ones moves can bring back) & the moves
+         *        undo() can take back. Layout, in bytes:
+         *
+         *          "P6CB", SNAPSHOT_VERSION, ROW_COUNT, COLUMN_COUNT, flags (bit 0: Player One's turn),
+         *          Player One's & Player Two's color (as indices of BoardColorizer::COLOR_CODES),
+         *          piece count, move count (32 bits, little-endian),
+         *          per piece: kind | Player One's << 3 | moving up << 4 | moved << 5 | on the board << 6, cell,
+         *          per move, oldest first: from cell, to cell, moved piece, captured piece (0xFF: none)
+         *
+         *        Cells are BoardGeometry::cell() indices (0xFF: off the board) & pieces are indices in the piece section.
+         *        A standard game takes at most 79 bytes plus 4 per move.
+         * @return False, leaving `buffer` empty, if the board has more than 254 pieces or a color with no code
+         */
+        bool snapshot(std::string& buffer) const;
+
+        /**
+         * @brief Replaces the whole game with the one saved in `blob` by snapshot(), on a board of the same geometry.
+         *        The pieces the board already owns are reused, so restoring a standard game onto any board
+         *        that started as one allocates no piece (only the move history may grow); a piece is only allocated when the board has no
+         *        unused piece of its kind left.
+         * @return False, leaving the board unchanged, if `blob` is not a valid snapshot of this version & geometry
          */
-        void display() const;
+        bool restore(std::string_view blob);
 
         /**
         * @brief Attempts to execute a round of play on the chessboard. A round consists of the 
@@ -173,6 +305,15 @@ class ChessBoard {
          */
         bool attemptRound();
 
+        /**
+         * @brief Plays a full move for the player whose turn it is, without prompting:
+         *        attempts the move using move(), and if it succeeds, records it by pushing
+         *        a Move to past_moves_ and toggles `playerOneTurn` (steps 5 to 7 of attemptRound)
+         * 
+         * @return True if the move was executed. False otherwise (nothing changes).
+         */
+        bool attemptMove(const int& row, const int& col, const int& new_row, const int& new_col);
+
         /**
          * @brief Reverts the most recent action executed by a player,
          *        if there is a `Move` object in the `past_moves_` stack
@@ -196,5 +337,29 @@ class ChessBoard {
 
         bool isPlayerOneTurn() const;
 
-        ChessPiece* getPieceAt(int row, int col) const;
-};
\ No newline at end of file
+        /**
+         * @brief Sets where undo() reports what it did
+         * @param log The stream to write to, or nullptr to stay silent (std::cout by default)
+         */
+        void setLog(std::ostream* log);
+
+        /**
+         * @brief Getter for p1_color member
+         * @return The color used by Player One's pieces
+         */
+        std::string getPlayerOneColor() const;
+
+        BasicChessPiece<Geometry>* getPieceAt(int row, int col) const;
+
+        /**
+         * @brief Gets the cells of a player's pieces of one kind still on the board, kept up to date by move() & undo()
+         * @param player_one True for Player One's pieces, false for Player Two's
+         * @return The list of cells, in no particular order (empty for PieceKind::NONE)
+         */
+        const PieceList& pieceList(bool player_one, PieceKind kind) const;
+};
+
+extern template class BasicChessBoard<StandardGeometry>;
+extern template class BasicChessBoard<CapablancaGeometry>;
+
+using ChessBoard = BasicChessBoard<StandardGeometry>;
@@ -0,0 +1,367 @@
+#include "GameHost.hpp"
+#include "engine/Notation.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    // A client whose unsent responses reach this size is not read from until they drain
+    const size_t MAX_PENDING_OUTPUT = 1 << 20;
+
+    /**
+     * @brief One connection of serveSocket()
+     */
+    struct Client {
+        std::string input;    // Received bytes not yet making a complete line
+        std::string output;   // Responses not yet accepted by the socket
+        bool closing = false; // Sent `quit`: close once `output` is sent
+    };
+
+    /**
+     * @brief Sends as much of `output` as the non-blocking socket `fd` takes now, erasing what was sent
+     * @return False if the peer is gone
+     */
+    bool sendPending(int fd, std::string& output) {
+        size_t sent = 0;
+        while (sent < output.size()) {
+            const ssize_t written = send(fd, output.data() + sent, output.size() - sent, MSG_NOSIGNAL);
+            if (written < 0 && errno == EINTR) { continue; }
+            if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) { break; }
+            if (written <= 0) { return false; }
+            sent += static_cast<size_t>(written);
+        }
+        output.erase(0, sent);
+        return true;
+    }
+
+    /**
+     * @return False if `fd` could not be made non-blocking
+     */
+    bool setNonBlocking(int fd) {
+        const int flags = fcntl(fd, F_GETFL, 0);
+        return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) >= 0;
+    }
+}
+
+// =============== Games ===============
+
+/**
+ * @return The game with id `id`, or nullptr if there is no such game in use
+ */
+GameHost::Game* GameHost::findGame(int id) {
+    if (id < 0 || id >= static_cast<int>(games_.size()) || !games_[id].in_use) { return nullptr; }
+    return &games_[id];
+}
+
+/**
+ * @brief Sets the position of `game` by playing its moves from its starting position
+ */
+void GameHost::replay(Game& game) {
+    game.position = game.root;
+    UndoInfo undo;
+    for (EngineMove move : game.moves) { game.position.makeMove(move, undo); }
+}
+
+/**
+ * @return True if the current position of `game` occurred twice before since the last irreversible move
+ */
+bool GameHost::isThreefold(const Game& game) {
+    // A position needs four reversible plies to come back, and it must come back twice
+    const size_t clock = static_cast<size_t>(game.position.halfmoveClock());
+    if (clock < 8) { return false; }
+
+    const size_t played = game.moves.size();
+    const size_t first = played - std::min(played, clock);
+    const uint64_t key = game.position.key();
+    Position position = game.root;
+    UndoInfo undo;
+    int count = 1;
+    for (size_t i = 0; i < played; i++) {
+        // Only positions with the same side to move can repeat the current one
+        if (i >= first && (played - i) % 2 == 0 && position.key() == key) { count++; }
+        position.makeMove(game.moves[i], undo);
+    }
+    return count >= 3;
+}
+
+/**
+ * @brief Sets the status of `game` from its current position
+ */
+void GameHost::updateStatus(Game& game) {
+    MoveList legal;
+    MoveGen::generateLegal(game.position, legal);
+    if (legal.empty()) { game.status = game.position.inCheck() ? Status::CHECKMATE : Status::STALEMATE; }
+    else if (!game.position.hasMatingMaterial()) { game.status = Status::INSUFFICIENT_MATERIAL; }
+    else if (game.position.halfmoveClock() >= 100) { game.status = Status::FIFTY_MOVES; }
+    else if (isThreefold(game)) { game.status = Status::REPETITION; }
+    else { game.status = Status::PLAYING; }
+}
+
+/**
+ * @return The bytes `game` takes, including its move list
+ */
+size_t GameHost::gameBytes(const Game& game) {
+    return sizeof(Game) + game.moves.capacity() * sizeof(EngineMove);
+}
+
+/**
+ * @return The response to `uci` having been played in game `id`, eg. "ok 3 e2e4 check"
+ */
+std::string GameHost::moveResponse(int id, const std::string& uci, const Game& game) {
+    std::string response = "ok " + std::to_string(id) + " " + uci;
+    switch (game.status) {
+        case Status::PLAYING: if (game.position.inCheck()) { response += " check"; } break;
+        case Status::CHECKMATE: response += " checkmate"; break;
+        case Status::STALEMATE: response += " stalemate"; break;
+        case Status::INSUFFICIENT_MATERIAL: response += " draw insufficient-material"; break;
+        case Status::FIFTY_MOVES: response += " draw fifty-moves"; break;
+        case Status::REPETITION: response += " draw repetition"; break;
+    }
+    return response;
+}
+
+/**
+ * @brief Starts a game from `fen`, or from the initial position if it is empty
+ * @return The id of the game, or -1 if `fen` is invalid
+ */
+int GameHost::newGame(const std::string& fen) {
+    Position root;
+    if (!fen.empty() && !root.setFromFen(fen)) { return -1; }
+
+    int id;
+    if (!free_ids_.empty()) {
+        id = free_ids_.back();
+        free_ids_.pop_back();
+    } else {
+        id = static_cast<int>(games_.size());
+        games_.emplace_back();
+    }
+
+    Game& game = games_[id];
+    game.root = root;
+    game.position = root;
+    game.moves.clear();
+    game.in_use = true;
+    updateStatus(game);
+    return id;
+}
+
+/**
+ * @brief Plays the move written as `uci` in game `id`
+ * @return False if there is no such game, the game is over or the move is illegal
+ */
+bool GameHost::playMove(int id, const std::string& uci) {
+    Game* game = findGame(id);
+    if (!game || game->status != Status::PLAYING) { return false; }
+    const EngineMove move = Notation::parseUci(game->position, uci);
+    if (move.isNull()) { return false; }
+
+    UndoInfo undo;
+    game->position.makeMove(move, undo);
+    game->moves.push_back(move);
+    updateStatus(*game);
+    return true;
+}
+
+/**
+ * @brief Ends game `id`, freeing its id for a later game
+ * @return False if there is no such game
+ */
+bool GameHost::endGame(int id) {
+    Game* game = findGame(id);
+    if (!game) { return false; }
+    game->in_use = false;
+    std::vector<EngineMove>().swap(game->moves); // Give back the move list, not just empty it
+    free_ids_.push_back(id);
+    return true;
+}
+
+/**
+ * @return The bytes taken by the games in use, including their move lists
+ */
+size_t GameHost::memoryUsage() const {
+    size_t bytes = 0;
+    for (const Game& game : games_) {
+        if (game.in_use) { bytes += gameBytes(game); }
+    }
+    return bytes;
+}
+
+// =============== Protocol ===============
+
+/**
+ * @brief Runs one command of the protocol
+ * @return The response line, without its newline. Empty for `quit`.
+ */
+std::string GameHost::handleLine(const std::string& line) {
+    std::istringstream args(line);
+    std::string command;
+    args >> command;
+
+    if (command == "quit") { return ""; }
+    if (command == "new") {
+        std::string fen;
+        std::getline(args >> std::ws, fen);
+        const int id = newGame(fen);
+        return id < 0 ? "error invalid fen" : "game " + std::to_string(id);
+    }
+    if (command == "stats") {
+        const size_t count = gameCount();
+        const size_t bytes = memoryUsage();
+        return "stats games " + std::to_string(count) + " bytes " + std::to_string(bytes)
+            + " bytes_per_game " + std::to_string(count ? bytes / count : 0);
+    }
+    if (command != "move" && command != "undo" && command != "fen" && command != "moves" && command != "end") {
+        return "error unknown command " + command;
+    }
+
+    int id = -1;
+    if (!(args >> id)) { return "error missing game id"; }
+    const std::string id_text = std::to_string(id);
+    Game* game = findGame(id);
+    if (!game) { return "error " + id_text + " unknown game"; }
+
+    if (command == "move") {
+        std::string uci;
+        args >> uci;
+        if (game->status != Status::PLAYING) { return "error " + id_text + " game over"; }
+        if (!playMove(id, uci)) { return "error " + id_text + " illegal move " + uci; }
+        return moveResponse(id, uci, *game);
+    }
+    if (command == "undo") {
+        if (game->moves.empty()) { return "error " + id_text + " nothing to undo"; }
+        game->moves.pop_back();
+        replay(*game);
+        updateStatus(*game);
+        return "ok " + id_text + " undo";
+    }
+    if (command == "fen") { return "fen " + id_text + " " + game->position.toFen(); }
+    if (command == "moves") {
+        MoveList legal;
+        MoveGen::generateLegal(game->position, legal);
+        std::string response = "moves " + id_text;
+        for (EngineMove move : legal) { response += " " + Notation::toUci(move); }
+        return response;
+    }
+    endGame(id);
+    return "ok " + id_text + " end";
+}
+
+/**
+ * @brief Answers the commands read from `in` on `out` until `quit` or the end of input
+ */
+void GameHost::serveStream(std::istream& in, std::ostream& out) {
+    std::string line;
+    while (std::getline(in, line)) {
+        const std::string response = handleLine(line);
+        if (response.empty()) { break; }
+        out << response << '\n';
+
+        // Flush only once the input read so far is handled, so that piped batches are written in one go
+        if (in.rdbuf()->in_avail() <= 0) { out.flush(); }
+    }
+    out.flush();
+}
+
+/**
+ * @brief Listens on the Unix-domain socket `path` and answers every client until interrupted.
+ *        A client's `quit` closes its connection only.
+ * @return False if the socket cannot be created, or once poll() fails
+ */
+bool GameHost::serveSocket(const std::string& path) {
+    sockaddr_un address{};
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) { return false; }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) { return false; }
+    unlink(path.c_str());
+    if (bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0
+        || listen(listener, SOMAXCONN) < 0) {
+        close(listener);
+        return false;
+    }
+
+    // Entry 0 is the listener; every other entry is a client, with its buffers in the same entry of `clients`.
+    // Clients are non-blocking, so one that reads slowly only ever delays itself.
+    std::vector<pollfd> fds = { { listener, POLLIN, 0 } };
+    std::vector<Client> clients(1);
+    char chunk[4096];
+
+    while (true) {
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) { continue; }
+            break;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            const int client = accept(listener, nullptr, nullptr);
+            if (client >= 0 && setNonBlocking(client)) {
+                fds.push_back({ client, POLLIN, 0 });
+                clients.emplace_back();
+            } else if (client >= 0) {
+                close(client);
+            }
+        }
+
+        for (size_t i = 1; i < fds.size(); i++) {
+            if (!fds[i].revents) { continue; }
+            Client& client = clients[i];
+
+            bool open = !(fds[i].revents & (POLLERR | POLLNVAL));
+            if (open && (fds[i].revents & (POLLIN | POLLHUP))) {
+                const ssize_t received = recv(fds[i].fd, chunk, sizeof(chunk), 0);
+                if (received > 0) {
+                    client.input.append(chunk, static_cast<size_t>(received));
+
+                    // Queue the answers to every complete line of the chunk, to be sent in one write
+                    size_t start = 0;
+                    for (size_t end = client.input.find('\n'); end != std::string::npos; end = client.input.find('\n', start)) {
+                        std::string line = client.input.substr(start, end - start);
+                        if (!line.empty() && line.back() == '\r') { line.pop_back(); }
+                        start = end + 1;
+
+                        const std::string response = handleLine(line);
+                        if (response.empty()) { client.closing = true; break; }
+                        client.output += response;
+                        client.output += '\n';
+                    }
+                    client.input.erase(0, client.closing ? client.input.size() : start);
+                } else if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                    open = false;
+                }
+            }
+
+            if (open && !client.output.empty()) { open = sendPending(fds[i].fd, client.output); }
+            if (client.closing && client.output.empty()) { open = false; }
+
+            if (!open) {
+                close(fds[i].fd);
+                fds[i] = fds.back();
+                fds.pop_back();
+                clients[i] = std::move(clients.back());
+                clients.pop_back();
+                i--; // Look at the client moved into this entry
+                continue;
+            }
+
+            // Wait for room to send while responses are pending, and stop reading while too many are
+            fds[i].events = 0;
+            if (!client.closing && client.output.size() < MAX_PENDING_OUTPUT) { fds[i].events |= POLLIN; }
+            if (!client.output.empty()) { fds[i].events |= POLLOUT; }
+        }
+    }
+
+    for (const pollfd& entry : fds) { close(entry.fd); }
+    unlink(path.c_str());
+    return false;
+}
@@ -0,0 +1,135 @@
+/**
+ * @class GameHost
+ * @brief Keeps thousands of independent games in one process, driven by a line protocol.
+ *
+ * Each game is a few hundred bytes: its starting Position, its current Position and the
+ * moves played, 2 bytes each. Taking a move back or checking for repetition replays the
+ * moves from the start, so no per-ply undo information is kept. Moves are checked against
+ * the engine's legal move generator, and a game ends as soon as its outcome is certain:
+ * checkmate, stalemate, insufficient material, the fifty-move rule or threefold repetition.
+ *
+ * One line per command, one line per response:
+ *   new [<fen>]           -> game <id>
+ *   move <id> <uci>       -> ok <id> <uci> [check | checkmate | stalemate | draw <reason>]
+ *   undo <id>             -> ok <id> undo
+ *   fen <id>              -> fen <id> <fen>
+ *   moves <id>            -> moves <id> <uci> ...
+ *   end <id>              -> ok <id> end
+ *   stats                 -> stats games <count> bytes <total> bytes_per_game <average>
+ *   quit                  ends the session
+ * Any failure is answered with `error [<id>] <reason>`.
+ *
+ * serveStream() reads commands from a stream (eg. stdin). serveSocket() runs an event loop
+ * over a Unix-domain socket: poll() wakes it whenever a client sends data, and each complete
+ * line is dispatched to its game, so any number of clients share the games of the host.
+ * Client sockets are non-blocking: responses the socket cannot take yet wait in the client's
+ * output buffer until poll() reports room, so a client that reads slowly never stalls the others.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "engine_module.hpp"
+
+class GameHost {
+    private:
+        /**
+         * @brief Where a game stands. Every status but PLAYING ends the game.
+         */
+        enum class Status : uint8_t { PLAYING, CHECKMATE, STALEMATE, INSUFFICIENT_MATERIAL, FIFTY_MOVES, REPETITION };
+
+        /**
+         * @brief The whole state of one game
+         */
+        struct Game {
+            Position root;                  // The position the game started from
+            Position position;              // The position after every move of `moves`
+            std::vector<EngineMove> moves;
+            Status status = Status::PLAYING;
+            bool in_use = false;            // False once ended, until its id is reused
+        };
+
+        std::vector<Game> games_;  // Indexed by id
+        std::vector<int> free_ids_; // Ids of ended games, reused first
+
+        /**
+         * @return The game with id `id`, or nullptr if there is no such game in use
+         */
+        Game* findGame(int id);
+
+        /**
+         * @brief Sets the position of `game` by playing its moves from its starting position
+         */
+        static void replay(Game& game);
+
+        /**
+         * @return True if the current position of `game` occurred twice before since the last irreversible move
+         */
+        static bool isThreefold(const Game& game);
+
+        /**
+         * @brief Sets the status of `game` from its current position
+         */
+        static void updateStatus(Game& game);
+
+        /**
+         * @return The bytes `game` takes, including its move list
+         */
+        static size_t gameBytes(const Game& game);
+
+        /**
+         * @return The response to `uci` having been played in game `id`, eg. "ok 3 e2e4 check"
+         */
+        static std::string moveResponse(int id, const std::string& uci, const Game& game);
+
+    public:
+        /**
+         * @brief Starts a game from `fen`, or from the initial position if it is empty
+         * @return The id of the game, or -1 if `fen` is invalid
+         */
+        int newGame(const std::string& fen = "");
+
+        /**
+         * @brief Plays the move written as `uci` in game `id`
+         * @return False if there is no such game, the game is over or the move is illegal
+         */
+        bool playMove(int id, const std::string& uci);
+
+        /**
+         * @brief Ends game `id`, freeing its id for a later game
+         * @return False if there is no such game
+         */
+        bool endGame(int id);
+
+        /**
+         * @return The number of games in use
+         */
+        size_t gameCount() const { return games_.size() - free_ids_.size(); }
+
+        /**
+         * @return The bytes taken by the games in use, including their move lists
+         */
+        size_t memoryUsage() const;
+
+        /**
+         * @brief Runs one command of the protocol
+         * @return The response line, without its newline. Empty for `quit`.
+         */
+        std::string handleLine(const std::string& line);
+
+        /**
+         * @brief Answers the commands read from `in` on `out` until `quit` or the end of input
+         */
+        void serveStream(std::istream& in = std::cin, std::ostream& out = std::cout);
+
+        /**
+         * @brief Listens on the Unix-domain socket `path` and answers every client until interrupted.
+         *        A client's `quit` closes its connection only.
+         * @return False if the socket cannot be created, or once poll() fails
+         */
+        bool serveSocket(const std::string& path);
+};
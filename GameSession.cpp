@@ -0,0 +1,102 @@
+#include "GameSession.hpp"
+
+#include <cstdlib>
+
+namespace {
+    /**
+     * @brief Reads two integers, and nothing else, from `line`
+     * @return False if `line` is anything else
+     */
+    bool readCell(const std::string& line, int& row, int& col) {
+        const char* cursor = line.c_str();
+        char* end = nullptr;
+        row = static_cast<int>(std::strtol(cursor, &end, 10));
+        if (end == cursor) { return false; }
+        cursor = end;
+        col = static_cast<int>(std::strtol(cursor, &end, 10));
+        if (end == cursor) { return false; }
+        for (; *end; end++) {
+            if (*end != ' ' && *end != '\t' && *end != '\r') { return false; }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Appends "(<row>,<col>)" to `out`
+     */
+    void appendCell(std::string& out, int row, int col) {
+        out += '(';
+        out += std::to_string(row);
+        out += ',';
+        out += std::to_string(col);
+        out += ')';
+    }
+}
+
+/**
+ * @brief Parameterized constructor. Starts a game on a new board (see ChessBoard's constructor).
+ */
+GameSession::GameSession(const std::string& p1_color, const std::string& p2_color)
+    : board_(p1_color, p2_color), state_{State::SELECT_PIECE}, from_row_{-1}, from_col_{-1}, undoable_{0} {
+    board_.setLog(nullptr); // The session reports undos itself, in its output
+}
+
+/**
+ * @brief Appends the prompt of the current step to `out`
+ */
+void GameSession::prompt(std::string& out) const {
+    out += board_.isPlayerOneTurn() ? "[PLAYER 1] " : "[PLAYER 2] ";
+    out += state_ == State::SELECT_PIECE ? "Select a piece" : "Specify a square to move to";
+    out += " (Enter two integers: '<row> <col>'), or any other input to undo the last action.\n";
+}
+
+/**
+ * @brief Takes back the last move, if any, reporting the outcome in `out`
+ * @return True if a move was taken back
+ */
+bool GameSession::undoLast(std::string& out) {
+    state_ = State::SELECT_PIECE;
+    if (undoable_ == 0) {
+        out += "No moves to undo.\nUndo failed.\n";
+        return false;
+    }
+    board_.undo();
+    undoable_--;
+    out += "Undid the last move.\n";
+    return true;
+}
+
+/**
+ * @brief Appends the first prompt of the session to `out`
+ */
+void GameSession::start(std::string& out) const {
+    prompt(out);
+}
+
+/**
+ * @brief Runs the current step with `line` as its input, then appends the next prompt
+ * @param out Receives the messages attemptRound() would have printed
+ * @return True if the line completed a round: a piece was moved, or a move was undone
+ */
+bool GameSession::feed(const std::string& line, std::string& out) {
+    int row, col;
+    bool completed = false;
+    if (!readCell(line, row, col)) {
+        completed = undoLast(out);
+    } else if (state_ == State::SELECT_PIECE) {
+        from_row_ = row;
+        from_col_ = col;
+        state_ = State::SELECT_TARGET;
+    } else {
+        state_ = State::SELECT_PIECE;
+        completed = board_.attemptMove(from_row_, from_col_, row, col);
+        out += completed ? "Moved " : "Unable to move piece at ";
+        appendCell(out, from_row_, from_col_);
+        out += " to ";
+        appendCell(out, row, col);
+        out += '\n';
+        if (completed) { undoable_++; }
+    }
+    prompt(out);
+    return completed;
+}
@@ -0,0 +1,67 @@
+/**
+ * @class GameSession
+ * @brief The flow of ChessBoard::attemptRound() as a resumable state machine.
+ *
+ * attemptRound() blocks on std::cin twice per round, so every game needs a thread (or a
+ * process) of its own. A GameSession runs the same steps, but is handed its input one line
+ * at a time and returns as soon as it needs the next one:
+ *
+ *   SELECT_PIECE  --"<row> <col>"-->  SELECT_TARGET  --"<row> <col>"-->  move, switch turn
+ *        \                                  \
+ *         `-- anything else: undo            `-- anything else: undo
+ *
+ * Every round ends back in SELECT_PIECE, and the prompt of the next step is appended to
+ * the output of every line, so a client always knows what is expected of it. The moves are
+ * played & taken back by ChessBoard::attemptMove() & ChessBoard::undo().
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "ChessBoard.hpp"
+
+class GameSession {
+    private:
+        enum class State : uint8_t { SELECT_PIECE, SELECT_TARGET };
+
+        ChessBoard board_;
+        State state_;
+        int from_row_, from_col_; // The cell selected in SELECT_PIECE
+        int undoable_;            // Moves the board can take back
+
+        /**
+         * @brief Appends the prompt of the current step to `out`
+         */
+        void prompt(std::string& out) const;
+
+        /**
+         * @brief Takes back the last move, if any, reporting the outcome in `out`
+         * @return True if a move was taken back
+         */
+        bool undoLast(std::string& out);
+
+    public:
+        /**
+         * @brief Parameterized constructor. Starts a game on a new board (see ChessBoard's constructor).
+         */
+        GameSession(const std::string& p1_color = "BLACK", const std::string& p2_color = "WHITE");
+
+        GameSession(const GameSession&) = delete;
+        GameSession& operator=(const GameSession&) = delete;
+
+        /**
+         * @brief Appends the first prompt of the session to `out`
+         */
+        void start(std::string& out) const;
+
+        /**
+         * @brief Runs the current step with `line` as its input, then appends the next prompt
+         * @param out Receives the messages attemptRound() would have printed
+         * @return True if the line completed a round: a piece was moved, or a move was undone
+         */
+        bool feed(const std::string& line, std::string& out);
+
+        const ChessBoard& board() const { return board_; }
+};
@@ -13,13 +13,15 @@
 *        Nullptr is also used if we have no piece that was captured.
 * @post The private members of the Move are updated accordingly.
 */
-Move::Move(const Square& from, const Square& to, ChessPiece* moved_piece, ChessPiece* captured_piece) : from_(from), to_(to), moved_piece_(moved_piece), captured_piece_(captured_piece) {}
+template <class Geometry>
+BasicMove<Geometry>::BasicMove(const Square& from, const Square& to, BasicChessPiece<Geometry>* moved_piece, BasicChessPiece<Geometry>* captured_piece) : from_(from), to_(to), moved_piece_(moved_piece), captured_piece_(captured_piece) {}
 
 /**
  * Gets the original position (starting square) of the move.
  * @return The original position as a Square (std::pair<int, int>).
  */
-Square Move::getOriginalPosition() const {
+template <class Geometry>
+Square BasicMove<Geometry>::getOriginalPosition() const {
     return from_;
 }
 
@@ -27,7 +29,8 @@ Square Move::getOriginalPosition() const {
   * Gets the target position (destination square) of the move.
   * @return The target position as a Square (std::pair<int, int>).
   */
-Square Move::getTargetPosition() const {
+template <class Geometry>
+Square BasicMove<Geometry>::getTargetPosition() const {
     return to_;
 }
  
@@ -35,7 +38,8 @@ Square Move::getTargetPosition() const {
   * Gets a pointer to the ChessPiece that was moved.
   * @return A pointer to the moved ChessPiece.
   */
-ChessPiece* Move::getMovedPiece() const {
+template <class Geometry>
+BasicChessPiece<Geometry>* BasicMove<Geometry>::getMovedPiece() const {
     return moved_piece_;
 }
  
@@ -43,6 +47,10 @@ ChessPiece* Move::getMovedPiece() const {
   * Gets a pointer to the ChessPiece that was captured during the move.
   * @return A pointer to the captured ChessPiece, or nullptr if no piece was captured.
   */
-ChessPiece* Move::getCapturedPiece() const {
+template <class Geometry>
+BasicChessPiece<Geometry>* BasicMove<Geometry>::getCapturedPiece() const {
     return captured_piece_;
-}
\ No newline at end of file
+}
+
+template class BasicMove<StandardGeometry>;
+template class BasicMove<CapablancaGeometry>;
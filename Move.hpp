@@ -8,14 +8,15 @@
  * and the second to the `column` */ 
  typedef std::pair<int,int> Square;
 
-class Move {
+template <class Geometry>
+class BasicMove {
     private:
         Square from_; // Represents the original square that `moved_piece_` started from
         Square to_; // Represents the destination square that `moved_piece_` moved to
-        ChessPiece* moved_piece_;  // A pointer to the piece that moved
-        ChessPiece* captured_piece_;  // A pointer to the piece that was captured (or nullptr if none)
+        BasicChessPiece<Geometry>* moved_piece_;  // A pointer to the piece that moved
+        BasicChessPiece<Geometry>* captured_piece_;  // A pointer to the piece that was captured (or nullptr if none)
     public: 
-        Move() = delete; // Default constructor
+        BasicMove() = delete; // Default constructor
 
         /**
          * Constructs a Move object representing a move on a chessboard.
@@ -30,7 +31,7 @@ class Move {
          *        Nullptr is also used if we have no piece that was captured.
          * @post The private members of the Move are updated accordingly.
          */
-        Move(const Square& from, const Square& to, ChessPiece* moved_piece, ChessPiece* captured_piece = nullptr);
+        BasicMove(const Square& from, const Square& to, BasicChessPiece<Geometry>* moved_piece, BasicChessPiece<Geometry>* captured_piece = nullptr);
 
         /**
          * Gets the original position (starting square) of the move.
@@ -48,12 +49,16 @@ class Move {
          * Gets a pointer to the ChessPiece that was moved.
          * @return A pointer to the moved ChessPiece.
          */
-        ChessPiece* getMovedPiece() const;
+        BasicChessPiece<Geometry>* getMovedPiece() const;
 
         /**
          * Gets a pointer to the ChessPiece that was captured during the move.
          * @return A pointer to the captured ChessPiece, or nullptr if no piece was captured.
          */
-        ChessPiece* getCapturedPiece() const;
+        BasicChessPiece<Geometry>* getCapturedPiece() const;
 };
 
+extern template class BasicMove<StandardGeometry>;
+extern template class BasicMove<CapablancaGeometry>;
+
+using Move = BasicMove<StandardGeometry>;
@@ -0,0 +1,122 @@
+#include "SessionPool.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief Starts the workers
+ * @param threads The number of worker threads (0: one per hardware thread)
+ * @param output Receives the output of every session
+ */
+SessionPool::SessionPool(unsigned threads, OutputCallback output)
+    : output_{std::move(output)}, stopping_{false}, pending_{0} {
+    if (threads == 0) { threads = std::max(1u, std::thread::hardware_concurrency()); }
+    for (unsigned thread = 0; thread < threads; thread++) {
+        workers_.emplace_back(&SessionPool::work, this);
+    }
+}
+
+/**
+ * @brief Destructor. Stops the workers once they finish the session they run; lines not fed yet are dropped.
+ */
+SessionPool::~SessionPool() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        stopping_ = true;
+    }
+    queue_ready_.notify_all();
+    for (std::thread& worker : workers_) { worker.join(); }
+}
+
+/**
+ * @brief Body of a worker thread: runs slots from the run queue until the pool stops
+ */
+void SessionPool::work() {
+    while (true) {
+        Slot* slot;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_ready_.wait(lock, [this]() { return stopping_ || !run_queue_.empty(); });
+            if (stopping_) { return; }
+            slot = run_queue_.front();
+            run_queue_.pop_front();
+        }
+        run(*slot);
+    }
+}
+
+/**
+ * @brief Feeds `slot` its inbox until it is empty, then takes it off the run queue
+ */
+void SessionPool::run(Slot& slot) {
+    std::vector<std::string> lines;
+    std::string output;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(slot.mutex);
+            lines.clear();
+            lines.swap(slot.inbox); // Hand the slot the (already reserved) batch fed last time
+            if (lines.empty()) {
+                slot.scheduled = false;
+                return;
+            }
+        }
+
+        output.clear();
+        for (const std::string& line : lines) { slot.session.feed(line, output); }
+        output_(slot.id, output);
+
+        if (pending_.fetch_sub(lines.size()) == lines.size()) {
+            // Take the lock so that the notification cannot slip in between drain()'s check & its wait
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            idle_.notify_all();
+        }
+    }
+}
+
+/**
+ * @brief Opens a session on a new board. Its first prompt goes to the output callback.
+ * @return The id of the session
+ */
+int SessionPool::open() {
+    const int id = static_cast<int>(slots_.size());
+    slots_.push_back(std::make_unique<Slot>(id));
+
+    std::string output;
+    slots_.back()->session.start(output);
+    output_(id, output);
+    return id;
+}
+
+/**
+ * @brief Queues `line` as the next input of session `session`
+ * @return False if there is no such session
+ */
+bool SessionPool::post(int session, std::string line) {
+    if (session < 0 || session >= static_cast<int>(slots_.size())) { return false; }
+    Slot& slot = *slots_[session];
+    pending_++;
+
+    bool schedule;
+    {
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        slot.inbox.push_back(std::move(line));
+        schedule = !slot.scheduled;
+        slot.scheduled = true;
+    }
+    if (schedule) {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            run_queue_.push_back(&slot);
+        }
+        queue_ready_.notify_one();
+    }
+    return true;
+}
+
+/**
+ * @brief Waits until every line posted so far has been fed to its session
+ */
+void SessionPool::drain() {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    idle_.wait(lock, [this]() { return pending_ == 0; });
+}
@@ -0,0 +1,117 @@
+/**
+ * @class SessionPool
+ * @brief Drives many GameSessions on a few worker threads.
+ *
+ * Each session has an inbox of input lines. Posting a line to a session whose inbox was
+ * idle puts the session on a shared run queue. A worker takes it from there, feeds it
+ * every line of its inbox, including the ones posted meanwhile, and hands the output to
+ * the output callback in one call. A session is on the run queue at most once, so only
+ * one worker runs it at a time and its board needs no lock. A session waiting for input
+ * costs no thread at all.
+ *
+ * Sessions are opened & posted to from one thread (eg. the one reading the input), while
+ * the workers run them.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GameSession.hpp"
+
+class SessionPool {
+    public:
+        /**
+         * @brief Receives the output of a session: the messages & prompts of one or more lines.
+         *        Called from the worker threads, concurrently for different sessions.
+         */
+        using OutputCallback = std::function<void(int session, const std::string& output)>;
+
+    private:
+        /**
+         * @brief A session & its pending input
+         */
+        struct Slot {
+            int id;
+            GameSession session;
+            std::mutex mutex;               // Guards inbox & scheduled
+            std::vector<std::string> inbox; // Lines posted & not yet fed
+            bool scheduled = false;         // Whether the slot is on the run queue or being run
+
+            explicit Slot(int slot_id) : id{slot_id} {}
+        };
+
+        std::vector<std::unique_ptr<Slot>> slots_; // Indexed by session id
+        OutputCallback output_;
+
+        std::mutex queue_mutex_;                // Guards run_queue_ & stopping_
+        std::condition_variable queue_ready_;   // Signalled when run_queue_ gets a slot, or on stop
+        std::condition_variable idle_;          // Signalled when pending_ drops to 0
+        std::deque<Slot*> run_queue_;
+        bool stopping_;
+        std::atomic<uint64_t> pending_;         // Lines posted & not yet fed, over all sessions
+
+        std::vector<std::thread> workers_;
+
+        /**
+         * @brief Body of a worker thread: runs slots from the run queue until the pool stops
+         */
+        void work();
+
+        /**
+         * @brief Feeds `slot` its inbox until it is empty, then takes it off the run queue
+         */
+        void run(Slot& slot);
+
+    public:
+        /**
+         * @brief Starts the workers
+         * @param threads The number of worker threads (0: one per hardware thread)
+         * @param output Receives the output of every session
+         */
+        SessionPool(unsigned threads, OutputCallback output);
+
+        /**
+         * @brief Destructor. Stops the workers once they finish the session they run; lines not fed yet are dropped.
+         */
+        ~SessionPool();
+
+        SessionPool(const SessionPool&) = delete;
+        SessionPool& operator=(const SessionPool&) = delete;
+
+        /**
+         * @brief Opens a session on a new board. Its first prompt goes to the output callback.
+         * @return The id of the session
+         */
+        int open();
+
+        /**
+         * @brief Queues `line` as the next input of session `session`
+         * @return False if there is no such session
+         */
+        bool post(int session, std::string line);
+
+        /**
+         * @brief Waits until every line posted so far has been fed to its session
+         */
+        void drain();
+
+        /**
+         * @return The number of sessions opened
+         */
+        size_t size() const { return slots_.size(); }
+
+        /**
+         * @return Session `session`, which must exist. Only safe to read while the pool is drained.
+         */
+        const GameSession& session(int session) const { return slots_[session]->session; }
+};
@@ -0,0 +1,350 @@
+#include "UciEngine.hpp"
+#include "engine/Notation.hpp"
+
+#include <chrono>
+
+/**
+ * @brief Parameterized constructor.
+ * @param in The stream commands are read from
+ * @param out The stream responses are written to
+ */
+UciEngine::UciEngine(std::istream& in, std::ostream& out)
+    : in_{in}, out_{out}, table_{std::make_shared<TranspositionTable>()}, searcher_{table_},
+      own_book_{false}, multi_pv_{1}, stop_received_{false}, pondering_{false}, quit_{false} {
+    searcher_.setPollCallback([this]() { pollInput(); });
+    searcher_.setIterationCallback([this](const SearchResult& result) { reportIteration(result); });
+}
+
+/**
+ * @brief Processes commands until `quit` or the end of input
+ * @return The process exit code
+ */
+int UciEngine::run() {
+    reader_ = std::thread(&UciEngine::readInput, this);
+    while (!quit_) {
+        handleCommand(nextCommand());
+    }
+    reader_.join();
+    return 0;
+}
+
+/**
+ * @brief Body of the input thread: forwards every line of input to the queue.
+ *        End of input is forwarded as "quit".
+ */
+void UciEngine::readInput() {
+    std::string line;
+    bool quit = false;
+    while (!quit) {
+        if (!std::getline(in_, line)) { line = "quit"; }
+        quit = (line.rfind("quit", 0) == 0);
+
+        // The engine thread drains the queue at least once per millisecond, so a full queue is short-lived
+        while (!input_.push(line)) { std::this_thread::yield(); }
+    }
+}
+
+/**
+ * @brief Waits for the next command, taking deferred ones first
+ */
+std::string UciEngine::nextCommand() {
+    if (!deferred_.empty()) {
+        std::string command = deferred_.front();
+        deferred_.pop_front();
+        return command;
+    }
+    return readCommand();
+}
+
+/**
+ * @brief Waits for the next line of the input thread, skipping deferred commands
+ */
+std::string UciEngine::readCommand() {
+    std::string command;
+    while (!input_.pop(command)) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    return command;
+}
+
+/**
+ * @brief Called by the search every time it polls its limits.
+ *        Answers `isready`, acts on `stop` / `ponderhit` / `quit` and defers anything else.
+ */
+void UciEngine::pollInput() {
+    std::string command;
+    while (input_.pop(command)) {
+        if (command == "isready") {
+            out_ << "readyok" << std::endl;
+        } else if (command == "stop") {
+            stop_received_ = true;
+            searcher_.stop();
+        } else if (command == "ponderhit") {
+            pondering_ = false;
+            searcher_.ponderhit();
+        } else if (command == "quit") {
+            stop_received_ = true;
+            quit_ = true;
+            searcher_.stop();
+        } else {
+            deferred_.push_back(command);
+        }
+    }
+}
+
+void UciEngine::handleCommand(const std::string& line) {
+    std::istringstream args(line);
+    std::string command;
+    args >> command;
+
+    if (command == "uci") {
+        out_ << "id name p6-235" << std::endl;
+        out_ << "id author p6-235 contributors" << std::endl;
+        out_ << "option name Hash type spin default " << TranspositionTable::DEFAULT_SIZE_MB << " min 1 max 4096" << std::endl;
+        out_ << "option name Clear Hash type button" << std::endl;
+        out_ << "option name Ponder type check default false" << std::endl;
+        out_ << "option name OwnBook type check default false" << std::endl;
+        out_ << "option name Book File type string default <empty>" << std::endl;
+        out_ << "option name Tablebase Path type string default <empty>" << std::endl;
+        out_ << "option name EvalFile type string default <empty>" << std::endl;
+        out_ << "option name Move Overhead type spin default " << TimeManager::DEFAULT_MOVE_OVERHEAD_MS << " min 0 max 1000" << std::endl;
+        out_ << "option name MultiPV type spin default 1 min 1 max " << MAX_MULTI_PV << std::endl;
+        out_ << "uciok" << std::endl;
+    } else if (command == "isready") {
+        out_ << "readyok" << std::endl;
+    } else if (command == "ucinewgame") {
+        table_->clear();
+        position_ = Position();
+    } else if (command == "setoption") {
+        handleSetOption(args);
+    } else if (command == "position") {
+        handlePosition(args);
+    } else if (command == "go") {
+        handleGo(args);
+    } else if (command == "stats") {
+        handleStats(args);
+    } else if (command == "quit") {
+        quit_ = true;
+    } else if (command == "stop" || command == "ponderhit" || command.empty()) {
+        // Nothing is being searched: nothing to stop
+    } else {
+        out_ << "info string unknown command " << command << std::endl;
+    }
+}
+
+/**
+ * setoption name <name with spaces> [value <value>]
+ */
+void UciEngine::handleSetOption(std::istringstream& args) {
+    std::string token, name, value;
+    args >> token; // "name"
+    while (args >> token && token != "value") { name += (name.empty() ? "" : " ") + token; }
+    while (args >> token) { value += (value.empty() ? "" : " ") + token; }
+
+    std::istringstream value_stream(value);
+    int64_t number = 0;
+    const bool is_number = static_cast<bool>(value_stream >> number);
+
+    if (name == "Hash" && is_number && number > 0) {
+        table_->resize(static_cast<size_t>(number));
+    } else if (name == "Clear Hash") {
+        table_->clear();
+    } else if (name == "Ponder") {
+        // Pondering is driven by `go ponder`: nothing to set up
+    } else if (name == "OwnBook") {
+        own_book_ = (value == "true");
+    } else if (name == "Book File") {
+        if (!book_.open(value)) { out_ << "info string cannot open book " << value << std::endl; }
+    } else if (name == "Tablebase Path") {
+        // Tables are loaded into a fresh set so no search ever sees one half-loaded
+        auto tablebases = std::make_shared<Tablebase::Tablebases>();
+        out_ << "info string loaded " << tablebases->loadDirectory(value) << " tablebases" << std::endl;
+        tablebases_ = tablebases;
+        searcher_.setTablebases(tablebases_);
+    } else if (name == "EvalFile") {
+        // An empty value goes back to the hand-crafted evaluation
+        auto network = std::make_shared<Nnue::Network>();
+        if (value.empty() || value == "<empty>") {
+            searcher_.setNetwork(nullptr);
+        } else if (network->load(value)) {
+            out_ << "info string loaded network " << value << (Nnue::usesAvx2() ? " (AVX2)" : "") << std::endl;
+            searcher_.setNetwork(network);
+        } else {
+            out_ << "info string cannot load network " << value << std::endl;
+        }
+    } else if (name == "Move Overhead" && is_number) {
+        searcher_.timeManager().setMoveOverhead(number);
+    } else if (name == "MultiPV" && is_number && number >= 1) {
+        multi_pv_ = static_cast<int>(std::min<int64_t>(number, MAX_MULTI_PV));
+    } else {
+        out_ << "info string invalid option " << name << std::endl;
+    }
+}
+
+/**
+ * position [startpos | fen <fen>] [moves <move> ...]
+ */
+void UciEngine::handlePosition(std::istringstream& args) {
+    std::string token, fen;
+    args >> token;
+    if (token == "startpos") {
+        fen = START_FEN;
+        args >> token; // "moves", if any
+    } else if (token == "fen") {
+        while (args >> token && token != "moves") { fen += token + " "; }
+    } else {
+        return;
+    }
+
+    Position position;
+    if (!position.setFromFen(fen)) {
+        out_ << "info string invalid fen " << fen << std::endl;
+        return;
+    }
+
+    UndoInfo undo;
+    std::vector<uint64_t> history;
+    while (args >> token) {
+        EngineMove move = Notation::parseUci(position, token);
+        if (move.isNull()) {
+            out_ << "info string illegal move " << token << std::endl;
+            break;
+        }
+        history.push_back(position.key());
+        position.makeMove(move, undo);
+    }
+    position_ = position;
+    searcher_.setHistory(std::move(history));
+}
+
+/**
+ * go [wtime <ms>] [btime <ms>] [winc <ms>] [binc <ms>] [movestogo <n>]
+ *    [depth <n>] [nodes <n>] [movetime <ms>] [infinite] [ponder]
+ * go perft <depth>
+ */
+void UciEngine::handleGo(std::istringstream& args) {
+    SearchLimits limits;
+    limits.multi_pv = multi_pv_;
+    const bool player_one = position_.sideToMove() == PLAYER_ONE;
+    std::string token;
+    while (args >> token) {
+        if (token == "perft") {
+            int depth = 1;
+            args >> depth;
+            handlePerft(depth);
+            return;
+        }
+        if (token == "infinite") { limits.infinite = true; continue; }
+        if (token == "ponder") { limits.ponder = true; continue; }
+
+        int64_t value = 0;
+        if (!(args >> value)) { break; }
+        if (token == "wtime" && player_one) { limits.time_left_ms = value; }
+        else if (token == "btime" && !player_one) { limits.time_left_ms = value; }
+        else if (token == "winc" && player_one) { limits.increment_ms = value; }
+        else if (token == "binc" && !player_one) { limits.increment_ms = value; }
+        else if (token == "movestogo") { limits.moves_to_go = static_cast<int>(value); }
+        else if (token == "depth") { limits.depth = static_cast<int>(value); }
+        else if (token == "nodes") { limits.nodes = static_cast<uint64_t>(value); }
+        else if (token == "movetime") { limits.move_time_ms = value; }
+    }
+
+    // Book moves are played instantly, unless the GUI wants the engine to think until told otherwise
+    if (own_book_ && !limits.infinite && !limits.ponder) {
+        Position position = position_;
+        EngineMove book_move = book_.probe(position);
+        if (!book_move.isNull()) {
+            out_ << "bestmove " << Notation::toUci(book_move) << std::endl;
+            return;
+        }
+    }
+
+    stop_received_ = false;
+    pondering_ = limits.ponder;
+    Position position = position_;
+    SearchResult result = searcher_.search(position, limits);
+
+    // In infinite mode, or while still pondering, the best move may only be sent once the GUI says stop / ponderhit.
+    // Commands deferred so far wait behind it, so this reads the input itself.
+    while ((limits.infinite || pondering_) && !stop_received_ && !quit_) {
+        std::string command = readCommand();
+        if (command == "stop") { break; }
+        if (command == "quit") { quit_ = true; break; }
+        if (command == "ponderhit") {
+            pondering_ = false;
+            if (limits.infinite) { continue; }
+            break;
+        }
+        if (command == "isready") { out_ << "readyok" << std::endl; continue; }
+        deferred_.push_back(command);
+    }
+
+    pondering_ = false;
+    out_ << "bestmove " << Notation::toUci(result.best_move);
+    if (result.pv.size() > 1) { out_ << " ponder " << Notation::toUci(result.pv[1]); }
+    out_ << std::endl;
+}
+
+/**
+ * @brief Counts the leaf positions `depth` plies below the current position, per root move
+ */
+void UciEngine::handlePerft(int depth) {
+    Position position = position_;
+    MoveList moves;
+    MoveGen::generateLegal(position, moves);
+
+    uint64_t total = 0;
+    UndoInfo undo;
+    for (EngineMove move : moves) {
+        position.makeMove(move, undo);
+        const uint64_t leaves = MoveGen::perft(position, std::max(0, depth - 1));
+        position.unmakeMove(move, undo);
+        out_ << Notation::toUci(move) << ": " << leaves << std::endl;
+        total += leaves;
+    }
+    out_ << std::endl << "Nodes searched: " << total << std::endl;
+}
+
+/**
+ * stats [json] [reset]: prints the hot-path counters of every thread so far, then optionally zeroes them
+ */
+void UciEngine::handleStats(std::istringstream& args) {
+    bool json = false, reset = false;
+    std::string token;
+    while (args >> token) {
+        json |= token == "json";
+        reset |= token == "reset";
+    }
+    const Stats::Snapshot stats = Stats::collect();
+    out_ << (json ? stats.toJson() + "\n" : stats.toTable()) << std::flush;
+    if (reset) { Stats::reset(); }
+}
+
+/**
+ * @brief Prints an `info` line for a completed iteration, or one per line with MultiPV
+ */
+void UciEngine::reportIteration(const SearchResult& result) {
+    const int64_t time_ms = std::max<int64_t>(1, result.time_ms);
+    for (size_t line = 0; line < result.lines.size(); line++) {
+        out_ << "info depth " << result.depth;
+        if (multi_pv_ > 1) { out_ << " multipv " << line + 1; }
+        out_ << " score " << formatScore(result.lines[line].score)
+             << " nodes " << result.nodes
+             << " nps " << result.nodes * 1000 / time_ms
+             << " time " << result.time_ms
+             << " hashfull " << table_->hashfull()
+             << " pv";
+        for (EngineMove move : result.lines[line].pv) { out_ << ' ' << Notation::toUci(move); }
+        out_ << '\n';
+    }
+    out_.flush();
+}
+
+/**
+ * @return `score` in UCI form: "cp <centipawns>" or "mate <moves>"
+ */
+std::string UciEngine::formatScore(int score) {
+    if (score >= MATE_BOUND) { return "mate " + std::to_string((MATE_SCORE - score + 1) / 2); }
+    if (score <= -MATE_BOUND) { return "mate " + std::to_string(-(MATE_SCORE + score) / 2); }
+    return "cp " + std::to_string(score);
+}
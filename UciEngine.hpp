@@ -0,0 +1,115 @@
+/**
+ * @class UciEngine
+ * @brief Runs the search engine as a long-lived process speaking the Universal Chess Interface.
+ *
+ * Supported commands: uci, isready, ucinewgame, setoption, position, go, stop, ponderhit, stats & quit.
+ * `go ponder` searches on the opponent's time until `ponderhit` (the time limits start)
+ * or `stop` (the GUI expected another move). `go perft <depth>` counts leaf positions instead
+ * of searching, to check move generation. `stats [json] [reset]` prints the hot-path
+ * counters (see Stats.hpp) as a text table or JSON, then optionally zeroes them.
+ * With the MultiPV option above 1, every iteration reports that many lines, each tagged `multipv <n>`.
+ *
+ * Input is read on a dedicated thread and handed to the engine thread through a
+ * lock-free queue. The search runs on the engine thread and drains that queue each
+ * time it polls its limits (every TimeManager::NODES_PER_POLL nodes), so `stop` and
+ * `isready` are answered within a fraction of a millisecond even mid-search.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "engine_module.hpp"
+#include "engine/SpscQueue.hpp"
+
+class UciEngine {
+    private:
+        static const size_t INPUT_QUEUE_CAPACITY = 256;
+        static const int MAX_MULTI_PV = 256; // More than any position has legal moves
+
+        std::istream& in_;
+        std::ostream& out_;
+
+        SpscQueue<std::string, INPUT_QUEUE_CAPACITY> input_; // Input thread -> engine thread
+        std::thread reader_;
+        std::deque<std::string> deferred_; // Commands received mid-search, handled once it ends
+
+        std::shared_ptr<TranspositionTable> table_;
+        std::shared_ptr<Tablebase::Tablebases> tablebases_;
+        Searcher searcher_;
+        Position position_;
+        PolyglotBook book_;
+        bool own_book_; // Whether to play moves from book_ when it has any
+        int multi_pv_;  // Number of lines searched & reported (the MultiPV option)
+
+        bool stop_received_;
+        bool pondering_; // Between `go ponder` and `ponderhit`
+        bool quit_;
+
+        /**
+         * @brief Body of the input thread: forwards every line of input to the queue.
+         *        End of input is forwarded as "quit".
+         */
+        void readInput();
+
+        /**
+         * @brief Waits for the next command, taking deferred ones first
+         */
+        std::string nextCommand();
+
+        /**
+         * @brief Waits for the next line of the input thread, skipping deferred commands
+         */
+        std::string readCommand();
+
+        /**
+         * @brief Called by the search every time it polls its limits.
+         *        Answers `isready`, acts on `stop` / `ponderhit` / `quit` and defers anything else.
+         */
+        void pollInput();
+
+        void handleCommand(const std::string& line);
+        void handleSetOption(std::istringstream& args);
+        void handlePosition(std::istringstream& args);
+        void handleGo(std::istringstream& args);
+
+        /**
+         * @brief Counts the leaf positions `depth` plies below the current position, per root move
+         */
+        void handlePerft(int depth);
+
+        /**
+         * @brief Prints the hot-path counters as a text table or JSON, then optionally zeroes them
+         */
+        void handleStats(std::istringstream& args);
+
+        /**
+         * @brief Prints an `info` line for a completed iteration, or one per line with MultiPV
+         */
+        void reportIteration(const SearchResult& result);
+
+        /**
+         * @return `score` in UCI form: "cp <centipawns>" or "mate <moves>"
+         */
+        static std::string formatScore(int score);
+
+    public:
+        /**
+         * @brief Parameterized constructor.
+         * @param in The stream commands are read from
+         * @param out The stream responses are written to
+         */
+        UciEngine(std::istream& in = std::cin, std::ostream& out = std::cout);
+
+        /**
+         * @brief Processes commands until `quit` or the end of input
+         * @return The process exit code
+         */
+        int run();
+};
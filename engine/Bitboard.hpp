@@ -0,0 +1,185 @@
+/**
+ * @file Bitboard.hpp
+ * @brief 64-bit square sets and precomputed attack tables.
+ *
+ * Bit `row * 8 + col` of a Bitboard is set when the square (row, col) belongs to the set.
+ * All tables are built at compile time, so there is nothing to initialize at startup.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "Types.hpp"
+
+typedef uint64_t Bitboard;
+
+namespace Bitboards {
+    const int BOARD_LENGTH = 8;
+    const int SQUARE_COUNT = BOARD_LENGTH * BOARD_LENGTH;
+
+    const Bitboard EMPTY = 0;
+    const Bitboard ROW_0 = 0xFFULL;
+    const Bitboard ROW_7 = ROW_0 << 56;
+    const Bitboard COL_0 = 0x0101010101010101ULL;
+
+    constexpr int square(int row, int col) { return row * BOARD_LENGTH + col; }
+    constexpr int rowOf(int sq) { return sq >> 3; }
+    constexpr int colOf(int sq) { return sq & 7; }
+    constexpr Bitboard bit(int sq) { return 1ULL << sq; }
+    constexpr bool onBoard(int row, int col) { return row >= 0 && row < BOARD_LENGTH && col >= 0 && col < BOARD_LENGTH; }
+
+    inline int popCount(Bitboard b) { return __builtin_popcountll(b); }
+    inline int lsb(Bitboard b) { return __builtin_ctzll(b); }
+    inline int msb(Bitboard b) { return 63 - __builtin_clzll(b); }
+
+    /**
+     * @brief Removes the least significant square from the set
+     * @return The index of the removed square
+     * @pre b is not empty
+     */
+    inline int popLsb(Bitboard& b) {
+        int sq = lsb(b);
+        b &= b - 1;
+        return sq;
+    }
+
+    /**
+     * Sliding directions. The first four increase the square index (so the nearest
+     * blocker along them is the least significant bit), the last four decrease it.
+     */
+    enum Direction { NORTH, EAST, NORTH_EAST, NORTH_WEST, SOUTH, WEST, SOUTH_EAST, SOUTH_WEST };
+    constexpr int DIRECTION_ROW[8] = { 1, 0, 1, 1, -1, 0, -1, -1 };
+    constexpr int DIRECTION_COL[8] = { 0, 1, 1, -1, 0, -1, 1, -1 };
+    constexpr Direction OPPOSITE[8] = { SOUTH, WEST, SOUTH_WEST, SOUTH_EAST, NORTH, EAST, NORTH_WEST, NORTH_EAST };
+
+    // ================ Compile-time table construction ================
+
+    constexpr Bitboard leaperMask(int sq, const int (&d_row)[8], const int (&d_col)[8]) {
+        Bitboard mask = 0;
+        for (int i = 0; i < 8; i++) {
+            int row = rowOf(sq) + d_row[i];
+            int col = colOf(sq) + d_col[i];
+            if (onBoard(row, col)) { mask |= bit(square(row, col)); }
+        }
+        return mask;
+    }
+
+    constexpr int KNIGHT_ROW[8] = { 1, 2, 2, 1, -1, -2, -2, -1 };
+    constexpr int KNIGHT_COL[8] = { 2, 1, -1, -2, -2, -1, 1, 2 };
+    constexpr int KING_ROW[8] = { 1, 1, 1, 0, 0, -1, -1, -1 };
+    constexpr int KING_COL[8] = { -1, 0, 1, -1, 1, -1, 0, 1 };
+
+    constexpr std::array<Bitboard, SQUARE_COUNT> makeLeaperTable(const int (&d_row)[8], const int (&d_col)[8]) {
+        std::array<Bitboard, SQUARE_COUNT> table{};
+        for (int sq = 0; sq < SQUARE_COUNT; sq++) { table[sq] = leaperMask(sq, d_row, d_col); }
+        return table;
+    }
+
+    constexpr std::array<std::array<Bitboard, SQUARE_COUNT>, 2> makePawnAttackTable() {
+        std::array<std::array<Bitboard, SQUARE_COUNT>, 2> table{};
+        for (int sq = 0; sq < SQUARE_COUNT; sq++) {
+            for (int side = 0; side < 2; side++) {
+                int row = rowOf(sq) + (side == PLAYER_ONE ? 1 : -1);
+                for (int d_col = -1; d_col <= 1; d_col += 2) {
+                    int col = colOf(sq) + d_col;
+                    if (onBoard(row, col)) { table[side][sq] |= bit(square(row, col)); }
+                }
+            }
+        }
+        return table;
+    }
+
+    constexpr std::array<std::array<Bitboard, SQUARE_COUNT>, 8> makeRayTable() {
+        std::array<std::array<Bitboard, SQUARE_COUNT>, 8> table{};
+        for (int dir = 0; dir < 8; dir++) {
+            for (int sq = 0; sq < SQUARE_COUNT; sq++) {
+                int row = rowOf(sq) + DIRECTION_ROW[dir];
+                int col = colOf(sq) + DIRECTION_COL[dir];
+                while (onBoard(row, col)) {
+                    table[dir][sq] |= bit(square(row, col));
+                    row += DIRECTION_ROW[dir];
+                    col += DIRECTION_COL[dir];
+                }
+            }
+        }
+        return table;
+    }
+
+    /**
+     * BETWEEN[a][b]: the squares strictly between `a` and `b` if they share a row, column or
+     * diagonal, else empty. LINE[a][b]: the whole row, column or diagonal through both, else empty.
+     */
+    constexpr std::array<std::array<Bitboard, SQUARE_COUNT>, SQUARE_COUNT> makeBetweenTable(bool whole_line) {
+        std::array<std::array<Bitboard, SQUARE_COUNT>, SQUARE_COUNT> table{};
+        const std::array<std::array<Bitboard, SQUARE_COUNT>, 8> rays = makeRayTable();
+        for (int from = 0; from < SQUARE_COUNT; from++) {
+            for (int dir = 0; dir < 8; dir++) {
+                Bitboard between = 0;
+                int row = rowOf(from) + DIRECTION_ROW[dir];
+                int col = colOf(from) + DIRECTION_COL[dir];
+                while (onBoard(row, col)) {
+                    const int to = square(row, col);
+                    table[from][to] = whole_line ? (rays[dir][from] | rays[OPPOSITE[dir]][from] | bit(from)) : between;
+                    between |= bit(to);
+                    row += DIRECTION_ROW[dir];
+                    col += DIRECTION_COL[dir];
+                }
+            }
+        }
+        return table;
+    }
+
+    inline constexpr std::array<Bitboard, SQUARE_COUNT> KNIGHT_ATTACKS = makeLeaperTable(KNIGHT_ROW, KNIGHT_COL);
+    inline constexpr std::array<Bitboard, SQUARE_COUNT> KING_ATTACKS = makeLeaperTable(KING_ROW, KING_COL);
+    inline constexpr std::array<std::array<Bitboard, SQUARE_COUNT>, 2> PAWN_ATTACKS = makePawnAttackTable();
+    inline constexpr std::array<std::array<Bitboard, SQUARE_COUNT>, 8> RAYS = makeRayTable();
+    inline constexpr std::array<std::array<Bitboard, SQUARE_COUNT>, SQUARE_COUNT> BETWEEN = makeBetweenTable(false);
+    inline constexpr std::array<std::array<Bitboard, SQUARE_COUNT>, SQUARE_COUNT> LINE = makeBetweenTable(true);
+
+    // ================ Attack lookups ================
+
+    /**
+     * @brief Squares reached from `sq` along `dir`, up to and including the first occupied square
+     */
+    inline Bitboard rayAttacks(int sq, Bitboard occupied, int dir) {
+        Bitboard ray = RAYS[dir][sq];
+        Bitboard blockers = ray & occupied;
+        if (!blockers) { return ray; }
+        int blocker = (dir < SOUTH) ? lsb(blockers) : msb(blockers);
+        return ray ^ RAYS[dir][blocker];
+    }
+
+    inline Bitboard knightAttacks(int sq) { return KNIGHT_ATTACKS[sq]; }
+    inline Bitboard kingAttacks(int sq) { return KING_ATTACKS[sq]; }
+    inline Bitboard pawnAttacks(Side side, int sq) { return PAWN_ATTACKS[side][sq]; }
+
+    inline Bitboard rookAttacks(int sq, Bitboard occupied) {
+        return rayAttacks(sq, occupied, NORTH) | rayAttacks(sq, occupied, EAST)
+             | rayAttacks(sq, occupied, SOUTH) | rayAttacks(sq, occupied, WEST);
+    }
+
+    inline Bitboard bishopAttacks(int sq, Bitboard occupied) {
+        return rayAttacks(sq, occupied, NORTH_EAST) | rayAttacks(sq, occupied, NORTH_WEST)
+             | rayAttacks(sq, occupied, SOUTH_EAST) | rayAttacks(sq, occupied, SOUTH_WEST);
+    }
+
+    inline Bitboard queenAttacks(int sq, Bitboard occupied) {
+        return rookAttacks(sq, occupied) | bishopAttacks(sq, occupied);
+    }
+
+    /**
+     * @brief Attacks of a non-pawn piece type standing on `sq`
+     */
+    inline Bitboard attacks(PieceType type, int sq, Bitboard occupied) {
+        switch (type) {
+            case KNIGHT: return knightAttacks(sq);
+            case BISHOP: return bishopAttacks(sq, occupied);
+            case ROOK: return rookAttacks(sq, occupied);
+            case QUEEN: return queenAttacks(sq, occupied);
+            case KING: return kingAttacks(sq);
+            default: return EMPTY;
+        }
+    }
+};
@@ -0,0 +1,244 @@
+#include "Evaluation.hpp"
+
+#include <algorithm>
+
+using namespace Bitboards;
+
+namespace {
+    /**
+     * Piece-square bonuses, drawn as seen by Player One with its back rank at the bottom:
+     * the first line of each table is row 7, the last line is row 0.
+     * Player Two reads the same tables upside down.
+     */
+    const int PAWN_TABLE[64] = {
+         0,  0,  0,  0,  0,  0,  0,  0,
+        50, 50, 50, 50, 50, 50, 50, 50,
+        10, 10, 20, 30, 30, 20, 10, 10,
+         5,  5, 10, 25, 25, 10,  5,  5,
+         0,  0,  0, 20, 20,  0,  0,  0,
+         5, -5,-10,  0,  0,-10, -5,  5,
+         5, 10, 10,-20,-20, 10, 10,  5,
+         0,  0,  0,  0,  0,  0,  0,  0
+    };
+
+    const int KNIGHT_TABLE[64] = {
+        -50,-40,-30,-30,-30,-30,-40,-50,
+        -40,-20,  0,  0,  0,  0,-20,-40,
+        -30,  0, 10, 15, 15, 10,  0,-30,
+        -30,  5, 15, 20, 20, 15,  5,-30,
+        -30,  0, 15, 20, 20, 15,  0,-30,
+        -30,  5, 10, 15, 15, 10,  5,-30,
+        -40,-20,  0,  5,  5,  0,-20,-40,
+        -50,-40,-30,-30,-30,-30,-40,-50
+    };
+
+    const int BISHOP_TABLE[64] = {
+        -20,-10,-10,-10,-10,-10,-10,-20,
+        -10,  0,  0,  0,  0,  0,  0,-10,
+        -10,  0,  5, 10, 10,  5,  0,-10,
+        -10,  5,  5, 10, 10,  5,  5,-10,
+        -10,  0, 10, 10, 10, 10,  0,-10,
+        -10, 10, 10, 10, 10, 10, 10,-10,
+        -10,  5,  0,  0,  0,  0,  5,-10,
+        -20,-10,-10,-10,-10,-10,-10,-20
+    };
+
+    const int ROOK_TABLE[64] = {
+         0,  0,  0,  0,  0,  0,  0,  0,
+         5, 10, 10, 10, 10, 10, 10,  5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+         0,  0,  0,  5,  5,  0,  0,  0
+    };
+
+    const int QUEEN_TABLE[64] = {
+        -20,-10,-10, -5, -5,-10,-10,-20,
+        -10,  0,  0,  0,  0,  0,  0,-10,
+        -10,  0,  5,  5,  5,  5,  0,-10,
+         -5,  0,  5,  5,  5,  5,  0, -5,
+         -5,  0,  5,  5,  5,  5,  0,  0,
+        -10,  0,  5,  5,  5,  5,  5,-10,
+        -10,  0,  0,  0,  0,  5,  0,-10,
+        -20,-10,-10, -5, -5,-10,-10,-20
+    };
+
+    const int KING_MIDDLEGAME_TABLE[64] = {
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -20,-30,-30,-40,-40,-30,-30,-20,
+        -10,-20,-20,-20,-20,-20,-20,-10,
+         20, 20,  0,  0,  0,  0, 20, 20,
+         20, 30, 10,  0,  0, 10, 30, 20
+    };
+
+    const int KING_ENDGAME_TABLE[64] = {
+        -50,-40,-30,-20,-20,-30,-40,-50,
+        -30,-20,-10,  0,  0,-10,-20,-30,
+        -30,-10, 20, 30, 30, 20,-10,-30,
+        -30,-10, 30, 40, 40, 30,-10,-30,
+        -30,-10, 30, 40, 40, 30,-10,-30,
+        -30,-10, 20, 30, 30, 20,-10,-30,
+        -30,-30,  0,  0,  0,  0,-30,-30,
+        -50,-30,-30,-30,-30,-30,-30,-50
+    };
+
+    const int* const PIECE_TABLES[5] = { PAWN_TABLE, KNIGHT_TABLE, BISHOP_TABLE, ROOK_TABLE, QUEEN_TABLE };
+
+    // Game phase weight of each piece type: 24 with all minor & major pieces on the board
+    const int PHASE_WEIGHTS[6] = { 0, 1, 1, 2, 4, 0 };
+    const int MAX_PHASE = 24;
+
+    // Index into the tables above for a piece of `side` standing on `sq`
+    int tableIndex(Side side, int sq) {
+        int row = (side == PLAYER_ONE) ? 7 - rowOf(sq) : rowOf(sq);
+        return row * BOARD_LENGTH + colOf(sq);
+    }
+
+    // Pawn structure terms (middlegame, endgame). Passed pawn bonuses are indexed by how
+    // many rows the pawn has advanced from its own back rank.
+    const int PASSED_MIDDLEGAME[8] = { 0, 5, 10, 15, 25, 45, 70, 0 };
+    const int PASSED_ENDGAME[8] = { 0, 10, 15, 30, 50, 80, 120, 0 };
+    const int DOUBLED_MIDDLEGAME = -10, DOUBLED_ENDGAME = -20;
+    const int ISOLATED_MIDDLEGAME = -10, ISOLATED_ENDGAME = -15;
+    const int BACKWARD_MIDDLEGAME = -8, BACKWARD_ENDGAME = -12;
+
+    // Squares strictly in front of `sq` (rows ahead of it) from `side`'s point of view
+    Bitboard rowsAhead(Side side, int sq) {
+        const int row = rowOf(sq);
+        if (side == PLAYER_ONE) { return row == 7 ? EMPTY : ~EMPTY << ((row + 1) * BOARD_LENGTH); }
+        return (1ULL << (row * BOARD_LENGTH)) - 1;
+    }
+
+    // Columns next to the column of `sq`
+    Bitboard adjacentCols(int sq) {
+        const int col = colOf(sq);
+        return (col > 0 ? COL_0 << (col - 1) : EMPTY) | (col < 7 ? COL_0 << (col + 1) : EMPTY);
+    }
+}
+
+// =============== Pawn structure ===============
+
+/**
+ * @param entries Number of entries, rounded down to a power of two
+ */
+Evaluation::PawnTable::PawnTable(size_t entries) : probes_{0}, hits_{0} {
+    size_t size = 1;
+    while (size * 2 <= entries) { size *= 2; }
+    entries_.resize(size);
+    clear();
+}
+
+/**
+ * @return The pawn structure score of `position`, computed & stored if not cached
+ */
+const Evaluation::PawnEntry& Evaluation::PawnTable::probe(const Position& position) {
+    PawnEntry& entry = entries_[position.pawnKey() & (entries_.size() - 1)];
+    probes_++;
+    if (entry.key == position.pawnKey()) {
+        hits_++;
+    } else {
+        evaluatePawns(position, entry);
+    }
+    return entry;
+}
+
+void Evaluation::PawnTable::clear() {
+    // A key of 0 means no pawns, whose structure is worth 0: empty entries are correct as they are
+    for (PawnEntry& entry : entries_) { entry = PawnEntry{0, 0, 0}; }
+    probes_ = hits_ = 0;
+}
+
+/**
+ * @brief Scores the pawn structure of `position` from scratch
+ * @post `entry` holds the score & the position's pawn key
+ */
+void Evaluation::evaluatePawns(const Position& position, PawnEntry& entry) {
+    int middlegame = 0;
+    int endgame = 0;
+    for (int side = PLAYER_ONE; side <= PLAYER_TWO; side++) {
+        const Side us = static_cast<Side>(side);
+        const int sign = (us == PLAYER_ONE) ? 1 : -1;
+        const Bitboard ours = position.pieces(us, PAWN);
+        const Bitboard theirs = position.pieces(opponent(us), PAWN);
+
+        Bitboard pawns = ours;
+        while (pawns) {
+            const int sq = popLsb(pawns);
+            const Bitboard col = COL_0 << colOf(sq);
+            const Bitboard ahead = rowsAhead(us, sq);
+            const Bitboard neighbours = adjacentCols(sq);
+
+            if (ours & col & ahead) {
+                // Only the rear pawn of a doubled pair is penalized: it cannot be passed either
+                middlegame += sign * DOUBLED_MIDDLEGAME;
+                endgame += sign * DOUBLED_ENDGAME;
+            } else if (!(theirs & (col | neighbours) & ahead)) {
+                const int advance = (us == PLAYER_ONE) ? rowOf(sq) : 7 - rowOf(sq);
+                middlegame += sign * PASSED_MIDDLEGAME[advance];
+                endgame += sign * PASSED_ENDGAME[advance];
+            }
+
+            if (!(ours & neighbours)) {
+                middlegame += sign * ISOLATED_MIDDLEGAME;
+                endgame += sign * ISOLATED_ENDGAME;
+            } else if (!(ours & neighbours & ~ahead)) {
+                // No neighbour level with it or behind can ever defend it: backward if it cannot safely advance
+                const int stop = (us == PLAYER_ONE) ? sq + BOARD_LENGTH : sq - BOARD_LENGTH;
+                if (pawnAttacks(us, stop) & theirs) {
+                    middlegame += sign * BACKWARD_MIDDLEGAME;
+                    endgame += sign * BACKWARD_ENDGAME;
+                }
+            }
+        }
+    }
+    entry = PawnEntry{position.pawnKey(), static_cast<int16_t>(middlegame), static_cast<int16_t>(endgame)};
+}
+
+// =============== Evaluation ===============
+
+/**
+ * @brief Scores the position from the point of view of the side to move
+ * @param pawn_table Where pawn structure scores are cached, if anywhere
+ * @return A score in centipawns: positive if the side to move stands better
+ */
+int Evaluation::evaluate(const Position& position, PawnTable* pawn_table) {
+    int score = 0; // From Player One's point of view
+    int king_middlegame = 0;
+    int king_endgame = 0;
+    int phase = 0;
+
+    for (int side = PLAYER_ONE; side <= PLAYER_TWO; side++) {
+        const int sign = (side == PLAYER_ONE) ? 1 : -1;
+        for (int type = PAWN; type <= QUEEN; type++) {
+            Bitboard pieces = position.pieces(static_cast<Side>(side), static_cast<PieceType>(type));
+            phase += PHASE_WEIGHTS[type] * popCount(pieces);
+            while (pieces) {
+                int sq = popLsb(pieces);
+                score += sign * (PIECE_VALUES[type] + PIECE_TABLES[type][tableIndex(static_cast<Side>(side), sq)]);
+            }
+        }
+
+        int king = position.kingSquare(static_cast<Side>(side));
+        if (king != NO_SQUARE) {
+            king_middlegame += sign * KING_MIDDLEGAME_TABLE[tableIndex(static_cast<Side>(side), king)];
+            king_endgame += sign * KING_ENDGAME_TABLE[tableIndex(static_cast<Side>(side), king)];
+        }
+    }
+
+    PawnEntry computed;
+    if (!pawn_table) { evaluatePawns(position, computed); }
+    const PawnEntry& pawns = pawn_table ? pawn_table->probe(position) : computed;
+
+    // Blend the king tables & pawn structure by how much material is left
+    phase = std::min(phase, MAX_PHASE);
+    const int middlegame = king_middlegame + pawns.middlegame;
+    const int endgame = king_endgame + pawns.endgame;
+    score += (middlegame * phase + endgame * (MAX_PHASE - phase)) / MAX_PHASE;
+
+    return (position.sideToMove() == PLAYER_ONE) ? score : -score;
+}
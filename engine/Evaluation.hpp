@@ -0,0 +1,79 @@
+/**
+ * @file Evaluation.hpp
+ * @brief Static evaluation of a Position: material, piece-square tables & pawn structure,
+ *        tapered between middlegame and endgame.
+ *
+ * Pawn structure (passed, isolated, doubled & backward pawns) only changes when a pawn
+ * moves or is captured, which few moves of a search do. Its score can therefore be cached
+ * in a PawnTable keyed by the position's pawn key, and is almost always found there.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Types.hpp"
+#include "Position.hpp"
+
+namespace Evaluation {
+    /**
+     * Material value of each piece type in centipawns, indexed by PieceType.
+     * The king is priceless, so it is valued at 0 (it is never captured).
+     */
+    const int PIECE_VALUES[7] = { 100, 320, 330, 500, 900, 0, 0 };
+
+    inline int pieceValue(PieceType type) { return PIECE_VALUES[type]; }
+
+    /**
+     * @brief A pawn structure score, from Player One's point of view
+     */
+    struct PawnEntry {
+        uint64_t key;
+        int16_t middlegame;
+        int16_t endgame;
+    };
+
+    /**
+     * @class PawnTable
+     * @brief A direct-mapped cache of pawn structure scores. Not thread-safe: one per search thread.
+     */
+    class PawnTable {
+        private:
+            std::vector<PawnEntry> entries_;
+            uint64_t probes_;
+            uint64_t hits_;
+
+        public:
+            static const size_t DEFAULT_ENTRIES = 1 << 16;  // 1 MB
+
+            /**
+             * @param entries Number of entries, rounded down to a power of two
+             */
+            explicit PawnTable(size_t entries = DEFAULT_ENTRIES);
+
+            /**
+             * @return The pawn structure score of `position`, computed & stored if not cached
+             */
+            const PawnEntry& probe(const Position& position);
+
+            void clear();
+
+            uint64_t probes() const { return probes_; }
+            uint64_t hits() const { return hits_; }
+    };
+
+    /**
+     * @brief Scores the pawn structure of `position` from scratch
+     * @post `entry` holds the score & the position's pawn key
+     */
+    void evaluatePawns(const Position& position, PawnEntry& entry);
+
+    /**
+     * @brief Scores the position from the point of view of the side to move
+     * @param pawn_table Where pawn structure scores are cached, if anywhere
+     * @return A score in centipawns: positive if the side to move stands better
+     */
+    int evaluate(const Position& position, PawnTable* pawn_table = nullptr);
+};
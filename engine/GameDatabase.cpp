@@ -0,0 +1,264 @@
+#include "GameDatabase.hpp"
+#include "MoveGen.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace GameDb {
+    namespace {
+        uint64_t readLittleEndian(const uint8_t* data, int bytes) {
+            uint64_t value = 0;
+            for (int i = bytes - 1; i >= 0; i--) { value = (value << 8) | data[i]; }
+            return value;
+        }
+
+        void appendLittleEndian(std::vector<uint8_t>& bytes, uint64_t value, int count) {
+            for (int i = 0; i < count; i++) { bytes.push_back(static_cast<uint8_t>(value >> (8 * i))); }
+        }
+
+        void writeLittleEndian(std::ofstream& out, uint64_t value, int bytes) {
+            for (int i = 0; i < bytes; i++) { out.put(static_cast<char>((value >> (8 * i)) & 0xFF)); }
+        }
+
+        /**
+         * @return The key ordering the legal moves of a position: origin, destination, then promotion
+         */
+        uint32_t moveKey(EngineMove move) {
+            const uint32_t promotion = move.isPromotion() ? move.promotion() - KNIGHT + 1 : 0;
+            return (static_cast<uint32_t>(move.from()) << 9) | (static_cast<uint32_t>(move.to()) << 3) | promotion;
+        }
+
+        /**
+         * @brief Writes the 16-byte header shared by both files
+         */
+        void writeFileHeader(std::ofstream& out, const char* magic, uint64_t count) {
+            out.write(magic, 4);
+            writeLittleEndian(out, VERSION, 4);
+            writeLittleEndian(out, count, 8);
+        }
+
+        /**
+         * @return True if `file` starts with a valid header carrying `magic`. Reads the game count into `count`.
+         */
+        bool readFileHeader(const MappedFile& file, const char* magic, uint64_t& count) {
+            if (file.size() < FILE_HEADER_SIZE || std::memcmp(file.data(), magic, 4) != 0) { return false; }
+            if (readLittleEndian(file.data() + 4, 4) != VERSION) { return false; }
+            count = readLittleEndian(file.data() + 8, 8);
+            return true;
+        }
+    }
+
+    /**
+     * @return The result written as `text` in PGN ("1-0", "0-1", "1/2-1/2", anything else is unknown)
+     */
+    Result parseResult(const std::string& text) {
+        if (text == "1-0") { return RESULT_PLAYER_ONE_WINS; }
+        if (text == "0-1") { return RESULT_PLAYER_TWO_WINS; }
+        if (text == "1/2-1/2") { return RESULT_DRAW; }
+        return RESULT_UNKNOWN;
+    }
+
+    /**
+     * @return `result` as written in PGN
+     */
+    std::string resultText(Result result) {
+        switch (result) {
+            case RESULT_PLAYER_ONE_WINS: return "1-0";
+            case RESULT_PLAYER_TWO_WINS: return "0-1";
+            case RESULT_DRAW: return "1/2-1/2";
+            default: return "*";
+        }
+    }
+
+    /**
+     * @return The position the game starts from
+     */
+    Position Game::startPosition() const {
+        Position position;
+        if (!start_fen.empty()) { position.setFromFen(start_fen); }
+        return position;
+    }
+
+    /**
+     * @brief Encodes `game` as it is stored in the games file
+     * @return False if a move is illegal, the game has 65536 plies or more, or its FEN is invalid / too long
+     */
+    bool encode(const Game& game, std::vector<uint8_t>& bytes) {
+        bytes.clear();
+        if (game.moves.size() > UINT16_MAX || game.start_fen.size() > UINT8_MAX) { return false; }
+
+        Position position;
+        if (!game.start_fen.empty() && !position.setFromFen(game.start_fen)) { return false; }
+
+        appendLittleEndian(bytes, game.moves.size(), 2);
+        bytes.push_back(game.result);
+        bytes.push_back(game.start_fen.empty() ? 0 : FLAG_FEN);
+        appendLittleEndian(bytes, game.ratings[PLAYER_ONE], 2);
+        appendLittleEndian(bytes, game.ratings[PLAYER_TWO], 2);
+        if (!game.start_fen.empty()) {
+            bytes.push_back(static_cast<uint8_t>(game.start_fen.size()));
+            bytes.insert(bytes.end(), game.start_fen.begin(), game.start_fen.end());
+        }
+
+        // Each move becomes the number of legal moves ordered before it
+        MoveList legal;
+        UndoInfo undo;
+        for (EngineMove move : game.moves) {
+            legal.clear();
+            MoveGen::generateLegal(position, legal);
+            if (!legal.contains(move)) { return false; }
+
+            const uint32_t key = moveKey(move);
+            int rank = 0;
+            for (EngineMove other : legal) { rank += moveKey(other) < key; }
+            bytes.push_back(static_cast<uint8_t>(rank));
+            position.makeMove(move, undo);
+        }
+        return true;
+    }
+
+    // =============== Writer ===============
+
+    /**
+     * @brief Destructor. Finishes the database if close() was not called.
+     */
+    Writer::~Writer() {
+        if (games_.is_open()) { close(); }
+    }
+
+    /**
+     * @brief Creates the database `path` (without extension), replacing any existing one
+     * @return True if the games file could be created
+     */
+    bool Writer::open(const std::string& path) {
+        if (games_.is_open()) { close(); }
+        games_.open(path + GAMES_EXTENSION, std::ios::binary | std::ios::trunc);
+        if (!games_) { return false; }
+
+        path_ = path;
+        offsets_.clear();
+        writeFileHeader(games_, GAMES_MAGIC, 0); // The count is filled in by close()
+        size_ = FILE_HEADER_SIZE;
+        return true;
+    }
+
+    /**
+     * @brief Appends a game
+     * @return False if the game cannot be encoded (nothing is written then) or the write failed
+     */
+    bool Writer::add(const Game& game) {
+        std::vector<uint8_t> bytes;
+        return encode(game, bytes) && addEncoded(bytes);
+    }
+
+    /**
+     * @brief Appends a game already encoded with encode()
+     */
+    bool Writer::addEncoded(const std::vector<uint8_t>& bytes) {
+        if (!games_.is_open()) { return false; }
+        offsets_.push_back(size_);
+        games_.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        size_ += bytes.size();
+        return static_cast<bool>(games_);
+    }
+
+    /**
+     * @brief Writes the game count & the index file
+     * @return True if both files were completed
+     */
+    bool Writer::close() {
+        if (!games_.is_open()) { return false; }
+        games_.seekp(0);
+        writeFileHeader(games_, GAMES_MAGIC, offsets_.size());
+        games_.close();
+        bool written = !games_.fail();
+
+        std::ofstream index(path_ + INDEX_EXTENSION, std::ios::binary | std::ios::trunc);
+        writeFileHeader(index, INDEX_MAGIC, offsets_.size());
+        for (uint64_t offset : offsets_) { writeLittleEndian(index, offset, 8); }
+        return written && static_cast<bool>(index);
+    }
+
+    // =============== Database ===============
+
+    /**
+     * @brief Maps the database `path` (without extension)
+     * @return True if both files are valid and agree with each other
+     */
+    bool Database::open(const std::string& path) {
+        uint64_t games = 0, indexed = 0;
+        size_ = 0;
+        if (!games_.open(path + GAMES_EXTENSION) || !index_.open(path + INDEX_EXTENSION)) { return false; }
+        if (!readFileHeader(games_, GAMES_MAGIC, games) || !readFileHeader(index_, INDEX_MAGIC, indexed)) { return false; }
+        if (games != indexed || index_.size() != FILE_HEADER_SIZE + 8 * indexed) { return false; }
+        size_ = games;
+        return true;
+    }
+
+    /**
+     * @brief Decodes game `id`, replaying its moves
+     * @return False if `id` is out of range or the game data is corrupt
+     */
+    bool Database::read(uint64_t id, Game& game) const {
+        if (id >= size_) { return false; }
+        const uint64_t offset = readLittleEndian(index_.data() + FILE_HEADER_SIZE + 8 * id, 8);
+        if (offset + GAME_HEADER_SIZE > games_.size()) { return false; }
+
+        const uint8_t* data = games_.data() + offset;
+        const uint8_t* end = games_.data() + games_.size();
+        const size_t plies = readLittleEndian(data, 2);
+        game.result = static_cast<Result>(data[2]);
+        game.ratings[PLAYER_ONE] = static_cast<uint16_t>(readLittleEndian(data + 4, 2));
+        game.ratings[PLAYER_TWO] = static_cast<uint16_t>(readLittleEndian(data + 6, 2));
+        const uint8_t flags = data[3];
+        data += GAME_HEADER_SIZE;
+
+        game.start_fen.clear();
+        if (flags & FLAG_FEN) {
+            if (data >= end || data + 1 + *data > end) { return false; }
+            game.start_fen.assign(reinterpret_cast<const char*>(data + 1), *data);
+            data += 1 + *data;
+        }
+        if (data + plies > end) { return false; }
+
+        Position position = game.startPosition();
+        game.moves.clear();
+        MoveList legal;
+        UndoInfo undo;
+        uint32_t keys[MoveList::MAX_MOVES];
+        for (size_t ply = 0; ply < plies; ply++) {
+            legal.clear();
+            MoveGen::generateLegal(position, legal);
+            const int rank = data[ply];
+            if (rank >= legal.size()) { return false; }
+
+            // The stored rank is the move's position in (from, to, promotion) order
+            for (int i = 0; i < legal.size(); i++) { keys[i] = moveKey(legal[i]); }
+            std::nth_element(keys, keys + rank, keys + legal.size());
+            for (EngineMove move : legal) {
+                if (moveKey(move) != keys[rank]) { continue; }
+                game.moves.push_back(move);
+                position.makeMove(move, undo);
+                break;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @return A hash of where game `count - 1` ends in the games file and of its stored bytes,
+     *         to recognise a database whose first `count` games were recreated (0 if `count` is 0)
+     */
+    uint64_t Database::fingerprint(uint64_t count) const {
+        if (count == 0 || count > size_) { return 0; }
+        const uint64_t begin = readLittleEndian(index_.data() + FILE_HEADER_SIZE + 8 * (count - 1), 8);
+        const uint64_t end = (count < size_) ? readLittleEndian(index_.data() + FILE_HEADER_SIZE + 8 * count, 8) : games_.size();
+        if (begin > end || end > games_.size()) { return 0; }
+
+        // FNV-1a over the end offset, then the game's bytes
+        uint64_t hash = 14695981039346656037ull;
+        for (int i = 0; i < 8; i++) { hash = (hash ^ ((end >> (8 * i)) & 0xFF)) * 1099511628211ull; }
+        for (uint64_t i = begin; i < end; i++) { hash = (hash ^ games_.data()[i]) * 1099511628211ull; }
+        return hash;
+    }
+}
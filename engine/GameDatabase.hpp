@@ -0,0 +1,156 @@
+/**
+ * @file GameDatabase.hpp
+ * @brief A compact binary game database, memory-mapped for random access by game id.
+ *
+ * A database is a pair of files:
+ *  - `<name>.p6g`: the games, back to back. Each game is a fixed 8-byte header (number of
+ *    plies, result, flags, both ratings), the start position as a FEN if it is not the
+ *    standard one, then one byte per move.
+ *  - `<name>.p6i`: the offset of every game in the games file, so game `id` is found in O(1).
+ *
+ * A move is stored as its rank among the legal moves of the position, ordered by
+ * (from, to, promotion). That order does not depend on the move generator's output order,
+ * so databases stay readable when the generator changes. With at most 218 legal moves in
+ * any chess position, a rank always fits in one byte.
+ *
+ * Both files start with a 16-byte header: magic, version and number of games.
+ * All integers are little-endian.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Types.hpp"
+#include "Position.hpp"
+#include "MappedFile.hpp"
+
+namespace GameDb {
+    static const size_t FILE_HEADER_SIZE = 16;
+    static const size_t GAME_HEADER_SIZE = 8;
+    static const uint32_t VERSION = 2;     // 2: move ranks count castling moves
+    static const char GAMES_MAGIC[4] = {'P', '6', 'G', 'D'};
+    static const char INDEX_MAGIC[4] = {'P', '6', 'G', 'I'};
+    static const char* const GAMES_EXTENSION = ".p6g";
+    static const char* const INDEX_EXTENSION = ".p6i";
+
+    enum Result : uint8_t { RESULT_UNKNOWN = 0, RESULT_PLAYER_ONE_WINS = 1, RESULT_PLAYER_TWO_WINS = 2, RESULT_DRAW = 3 };
+    static const uint8_t FLAG_FEN = 1; // The game starts from a FEN stored after its header
+
+    /**
+     * @return The result written as `text` in PGN ("1-0", "0-1", "1/2-1/2", anything else is unknown)
+     */
+    Result parseResult(const std::string& text);
+
+    /**
+     * @return `result` as written in PGN
+     */
+    std::string resultText(Result result);
+
+    /**
+     * @brief One game, as stored in or read from a database
+     */
+    struct Game {
+        std::string start_fen;          // Empty for the standard starting position
+        std::vector<EngineMove> moves;
+        Result result = RESULT_UNKNOWN;
+        uint16_t ratings[2] = {0, 0};   // Of Player One (White) & Player Two, 0 if unknown
+
+        /**
+         * @return The position the game starts from
+         */
+        Position startPosition() const;
+    };
+
+    /**
+     * @brief Encodes `game` as it is stored in the games file
+     * @return False if a move is illegal, the game has 65536 plies or more, or its FEN is invalid / too long
+     */
+    bool encode(const Game& game, std::vector<uint8_t>& bytes);
+
+    /**
+     * @class Writer
+     * @brief Appends games to a new database
+     */
+    class Writer {
+        private:
+            std::ofstream games_;
+            std::vector<uint64_t> offsets_;
+            uint64_t size_;      // Bytes written to the games file so far
+            std::string path_;
+
+        public:
+            Writer() : size_{0} {}
+
+            /**
+             * @brief Destructor. Finishes the database if close() was not called.
+             */
+            ~Writer();
+
+            /**
+             * @brief Creates the database `path` (without extension), replacing any existing one
+             * @return True if the games file could be created
+             */
+            bool open(const std::string& path);
+
+            /**
+             * @brief Appends a game
+             * @return False if the game cannot be encoded (nothing is written then) or the write failed
+             */
+            bool add(const Game& game);
+
+            /**
+             * @brief Appends a game already encoded with encode()
+             */
+            bool addEncoded(const std::vector<uint8_t>& bytes);
+
+            /**
+             * @return The number of games added so far
+             */
+            uint64_t size() const { return offsets_.size(); }
+
+            /**
+             * @brief Writes the game count & the index file
+             * @return True if both files were completed
+             */
+            bool close();
+    };
+
+    /**
+     * @class Database
+     * @brief Read-only, memory-mapped access to a database
+     */
+    class Database {
+        private:
+            MappedFile games_;
+            MappedFile index_;
+            uint64_t size_ = 0;
+
+        public:
+            /**
+             * @brief Maps the database `path` (without extension)
+             * @return True if both files are valid and agree with each other
+             */
+            bool open(const std::string& path);
+
+            /**
+             * @return The number of games
+             */
+            uint64_t size() const { return size_; }
+
+            /**
+             * @brief Decodes game `id`, replaying its moves
+             * @return False if `id` is out of range or the game data is corrupt
+             */
+            bool read(uint64_t id, Game& game) const;
+
+            /**
+             * @return A hash of where game `count - 1` ends in the games file and of its stored bytes,
+             *         to recognise a database whose first `count` games were recreated (0 if `count` is 0)
+             */
+            uint64_t fingerprint(uint64_t count) const;
+    };
+}
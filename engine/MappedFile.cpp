@@ -0,0 +1,67 @@
+#include "MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile() : data_{nullptr}, size_{0} {}
+
+/**
+ * @brief Destructor. Unmaps the file, if any.
+ */
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept : data_{other.data_}, size_{other.size_} {
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = other.data_;
+        size_ = other.size_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+/**
+ * @brief Maps the file at `path`, replacing any previous mapping
+ * @return True if the file was mapped. False if it could not be opened, is empty
+ *         or could not be mapped (nothing is mapped then).
+ */
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) { return false; }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    // The mapping stays valid once the descriptor is closed
+    void* address = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) { return false; }
+
+    data_ = static_cast<const uint8_t*>(address);
+    size_ = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+/**
+ * @brief Unmaps the file, if any
+ */
+void MappedFile::close() {
+    if (data_) { munmap(const_cast<uint8_t*>(data_), size_); }
+    data_ = nullptr;
+    size_ = 0;
+}
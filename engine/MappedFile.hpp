@@ -0,0 +1,50 @@
+/**
+ * @class MappedFile
+ * @brief A read-only memory mapping of a whole file.
+ *
+ * Mapping a file costs the same no matter how large it is: nothing is read up front,
+ * and the operating system pages data in as it is touched (and may evict it again under
+ * memory pressure, since clean file-backed pages never go to swap). Large on-disk tables
+ * such as opening books can therefore be used in place, without parsing or copying them.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class MappedFile {
+    private:
+        const uint8_t* data_;
+        size_t size_;
+
+    public:
+        MappedFile();
+
+        /**
+         * @brief Destructor. Unmaps the file, if any.
+         */
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        /**
+         * @brief Maps the file at `path`, replacing any previous mapping
+         * @return True if the file was mapped. False if it could not be opened, is empty
+         *         or could not be mapped (nothing is mapped then).
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Unmaps the file, if any
+         */
+        void close();
+
+        bool isOpen() const { return data_ != nullptr; }
+        const uint8_t* data() const { return data_; }
+        size_t size() const { return size_; }
+};
@@ -0,0 +1,374 @@
+#include "MoveGen.hpp"
+#include "Stats.hpp"
+
+using namespace Bitboards;
+
+/**
+ * @return True if `move` is in the list
+ */
+bool MoveList::contains(EngineMove move) const {
+    for (EngineMove m : *this) {
+        if (m == move) { return true; }
+    }
+    return false;
+}
+
+namespace {
+    // Square offset of a single pawn push for `side`
+    int pawnPush(Side side) { return (side == PLAYER_ONE) ? BOARD_LENGTH : -BOARD_LENGTH; }
+
+    Bitboard shiftForward(Bitboard b, Side side) { return (side == PLAYER_ONE) ? (b << 8) : (b >> 8); }
+
+    // The row pawns of `side` promote on, and the row its double pushes land on
+    Bitboard promotionRow(Side side) { return (side == PLAYER_ONE) ? ROW_7 : ROW_0; }
+    Bitboard doublePushRow(Side side) { return (side == PLAYER_ONE) ? (ROW_0 << 24) : (ROW_0 << 32); }
+
+    void addPromotions(MoveList& moves, int from, int to, bool capture, bool queen, bool under) {
+        int base = capture ? EngineMove::PROMOTION_CAPTURE : EngineMove::PROMOTION;
+        if (queen) { moves.push(EngineMove(from, to, base + (QUEEN - KNIGHT))); }
+        if (under) {
+            moves.push(EngineMove(from, to, base + (KNIGHT - KNIGHT)));
+            moves.push(EngineMove(from, to, base + (BISHOP - KNIGHT)));
+            moves.push(EngineMove(from, to, base + (ROOK - KNIGHT)));
+        }
+    }
+
+    void addMoves(MoveList& moves, int from, Bitboard targets, int flags) {
+        while (targets) { moves.push(EngineMove(from, popLsb(targets), flags)); }
+    }
+
+    /**
+     * @return True if the side to move may play `castling`: it holds the right, the squares between
+     *         its king & rook are empty, and its king does not start on, cross or land on an attacked square
+     */
+    bool canCastle(const Position& position, const Castling& castling) {
+        if (!(position.castlingRights() & castling.right) || (position.occupied() & castling.empty)) { return false; }
+        Bitboard safe = castling.safe;
+        while (safe) {
+            if (position.isSquareAttacked(popLsb(safe), opponent(position.sideToMove()))) { return false; }
+        }
+        return true;
+    }
+
+    /**
+     * Appends the castling moves of the side to move. They are always legal.
+     */
+    void generateCastling(const Position& position, MoveList& moves) {
+        const Side us = position.sideToMove();
+        for (int wing = 0; wing < 2; wing++) {
+            const Castling& castling = CASTLINGS[us][wing];
+            if (!canCastle(position, castling)) { continue; }
+            moves.push(EngineMove(castling.king_from, castling.king_to, wing ? EngineMove::QUEEN_CASTLE : EngineMove::KING_CASTLE));
+        }
+    }
+
+    /**
+     * @return The pieces of `us` pinned to its king on `king`: the only piece between it & an enemy slider
+     */
+    Bitboard pinnedPieces(const Position& position, Side us, int king) {
+        const Side them = opponent(us);
+        const Bitboard occupied = position.occupied();
+        Bitboard snipers = (rookAttacks(king, EMPTY) & (position.pieces(them, ROOK) | position.pieces(them, QUEEN)))
+                         | (bishopAttacks(king, EMPTY) & (position.pieces(them, BISHOP) | position.pieces(them, QUEEN)));
+        Bitboard pinned = EMPTY;
+        while (snipers) {
+            const Bitboard between = BETWEEN[king][popLsb(snipers)] & occupied;
+            if (popCount(between) == 1) { pinned |= between & position.pieces(us); }
+        }
+        return pinned;
+    }
+
+    /**
+     * Appends the moves of every non-pawn piece of the side to move whose destination is in `targets`
+     */
+    void generatePieceMoves(const Position& position, Bitboard targets, int flags, MoveList& moves) {
+        const Side us = position.sideToMove();
+        const Bitboard occupied = position.occupied();
+        for (int type = KNIGHT; type <= KING; type++) {
+            Bitboard pieces = position.pieces(us, static_cast<PieceType>(type));
+            while (pieces) {
+                int from = popLsb(pieces);
+                addMoves(moves, from, attacks(static_cast<PieceType>(type), from, occupied) & targets, flags);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Appends every capture, en passant capture & promotion-capture of the side to move,
+ *        plus non-capturing promotions to a queen.
+ */
+void MoveGen::generateCaptures(const Position& position, MoveList& moves) {
+    const int start = moves.size();
+    const Side us = position.sideToMove();
+    const Bitboard enemies = position.pieces(opponent(us));
+    const Bitboard empty = ~position.occupied();
+    const Bitboard promotion_row = promotionRow(us);
+
+    Bitboard pawns = position.pieces(us, PAWN);
+    while (pawns) {
+        int from = popLsb(pawns);
+        Bitboard targets = pawnAttacks(us, from) & enemies;
+        while (targets) {
+            int to = popLsb(targets);
+            if (bit(to) & promotion_row) {
+                addPromotions(moves, from, to, true, true, true);
+            } else {
+                moves.push(EngineMove(from, to, EngineMove::CAPTURE));
+            }
+        }
+
+        int ep = position.enPassantSquare();
+        if (ep != NO_SQUARE && (pawnAttacks(us, from) & bit(ep))) {
+            moves.push(EngineMove(from, ep, EngineMove::EN_PASSANT));
+        }
+    }
+
+    // Quiet promotions to a queen change the material balance as much as a capture
+    Bitboard promotions = shiftForward(position.pieces(us, PAWN), us) & empty & promotion_row;
+    while (promotions) {
+        int to = popLsb(promotions);
+        addPromotions(moves, to - pawnPush(us), to, false, true, false);
+    }
+
+    generatePieceMoves(position, enemies, EngineMove::CAPTURE, moves);
+    Stats::increment(Stats::MOVES_GENERATED, moves.size() - start);
+}
+
+/**
+ * @brief Appends every non-capturing move that generateCaptures() does not produce
+ *        (including non-capturing under-promotions & castling).
+ */
+void MoveGen::generateQuiets(const Position& position, MoveList& moves) {
+    const int start = moves.size();
+    const Side us = position.sideToMove();
+    const Bitboard empty = ~position.occupied();
+    const Bitboard promotion_row = promotionRow(us);
+    const int push = pawnPush(us);
+
+    Bitboard single = shiftForward(position.pieces(us, PAWN), us) & empty;
+    Bitboard doubles = shiftForward(single, us) & empty & doublePushRow(us);
+
+    Bitboard promotions = single & promotion_row;
+    while (promotions) {
+        int to = popLsb(promotions);
+        addPromotions(moves, to - push, to, false, false, true);
+    }
+
+    single &= ~promotion_row;
+    while (single) {
+        int to = popLsb(single);
+        moves.push(EngineMove(to - push, to));
+    }
+    while (doubles) {
+        int to = popLsb(doubles);
+        moves.push(EngineMove(to - 2 * push, to, EngineMove::DOUBLE_PUSH));
+    }
+
+    generatePieceMoves(position, empty, EngineMove::QUIET, moves);
+    generateCastling(position, moves);
+    Stats::increment(Stats::MOVES_GENERATED, moves.size() - start);
+}
+
+/**
+ * @brief Appends the non-capturing, non-promoting moves that give direct check
+ *        (discovered checks are not detected).
+ */
+void MoveGen::generateQuietChecks(const Position& position, MoveList& moves) {
+    const int start = moves.size();
+    const Side us = position.sideToMove();
+    const int enemy_king = position.kingSquare(opponent(us));
+    if (enemy_king == NO_SQUARE) { return; }
+
+    const Bitboard occupied = position.occupied();
+    const Bitboard empty = ~occupied;
+    const int push = pawnPush(us);
+
+    // A pawn checks from the squares an enemy pawn on the king square would attack
+    Bitboard pawn_checks = shiftForward(position.pieces(us, PAWN), us) & empty
+                         & pawnAttacks(opponent(us), enemy_king) & ~promotionRow(us);
+    while (pawn_checks) {
+        int to = popLsb(pawn_checks);
+        moves.push(EngineMove(to - push, to));
+    }
+
+    // Any other piece checks from the squares it would attack if it stood on the king square
+    for (int type = KNIGHT; type <= QUEEN; type++) {
+        Bitboard check_squares = attacks(static_cast<PieceType>(type), enemy_king, occupied) & empty;
+        Bitboard pieces = position.pieces(us, static_cast<PieceType>(type));
+        while (pieces) {
+            int from = popLsb(pieces);
+            addMoves(moves, from, attacks(static_cast<PieceType>(type), from, occupied) & check_squares, EngineMove::QUIET);
+        }
+    }
+    Stats::increment(Stats::MOVES_GENERATED, moves.size() - start);
+}
+
+/**
+ * @brief Appends every pseudo-legal move (captures first, then quiet moves)
+ */
+void MoveGen::generatePseudoLegal(const Position& position, MoveList& moves) {
+    generateCaptures(position, moves);
+    generateQuiets(position, moves);
+}
+
+/**
+ * @return True if generatePseudoLegal() would produce `move` in `position`, checked
+ *         without generating anything (eg. to try a hash move before any generation)
+ */
+bool MoveGen::isPseudoLegal(const Position& position, EngineMove move) {
+    if (move.isNull()) { return false; }
+    const Side us = position.sideToMove();
+    const int from = move.from();
+    const int to = move.to();
+    const int flags = move.flags();
+    const Piece piece = position.pieceAt(from);
+    if (piece == NO_PIECE || sideOf(piece) != us) { return false; }
+
+    // The flags must match what stands on the destination
+    const Piece target = position.pieceAt(to);
+    if (move.isEnPassant()) {
+        if (typeOf(piece) != PAWN || to != position.enPassantSquare()) { return false; }
+    } else if (move.isCapture()) {
+        if (target == NO_PIECE || sideOf(target) == us) { return false; }
+    } else if (target != NO_PIECE) {
+        return false;
+    }
+
+    if (move.isCastle()) {
+        const Castling& castling = castlingOf(us, move);
+        return from == castling.king_from && to == castling.king_to && canCastle(position, castling);
+    }
+    if (typeOf(piece) != PAWN) {
+        if (flags != EngineMove::QUIET && flags != EngineMove::CAPTURE) { return false; }
+        return attacks(typeOf(piece), from, position.occupied()) & bit(to);
+    }
+
+    // Pawns promote exactly when they reach the last row
+    if (move.isPromotion() != static_cast<bool>(bit(to) & promotionRow(us))) { return false; }
+    const int push = pawnPush(us);
+    switch (flags & ~3) {
+        case EngineMove::QUIET:
+            if (flags == EngineMove::DOUBLE_PUSH) {
+                return to == from + 2 * push && (bit(to) & doublePushRow(us)) && position.pieceAt(from + push) == NO_PIECE;
+            }
+            return flags == EngineMove::QUIET && to == from + push;
+        case EngineMove::CAPTURE:
+            return (flags == EngineMove::CAPTURE || flags == EngineMove::EN_PASSANT) && (pawnAttacks(us, from) & bit(to));
+        case EngineMove::PROMOTION:
+            return to == from + push;
+        default: // EngineMove::PROMOTION_CAPTURE
+            return pawnAttacks(us, from) & bit(to);
+    }
+}
+
+/**
+ * @brief Appends every legal move, ie. pseudo-legal moves that do not leave the mover's king attacked.
+ *
+ * Legality is settled while generating, without making any move: the king only steps to
+ * squares the enemy does not attack, pinned pieces only move along their pin ray, and when
+ * in check the other pieces only capture the checker or block its ray (in double check, only
+ * the king moves). En passant, which removes two pieces from a row, has its own test.
+ */
+void MoveGen::generateLegal(const Position& position, MoveList& moves) {
+    const Side us = position.sideToMove();
+    const int king = position.kingSquare(us);
+    if (king == NO_SQUARE) { // No king to leave attacked
+        generatePseudoLegal(position, moves);
+        return;
+    }
+
+    const Bitboard occupied = position.occupied();
+    const Bitboard own = position.pieces(us);
+    const Bitboard enemies = position.pieces(opponent(us));
+    const Bitboard checkers = position.attackersTo(king, occupied) & enemies;
+    const int start = moves.size();
+
+    // The king's own square is left empty, so that it cannot retreat along a checking ray
+    const Bitboard without_king = occupied ^ bit(king);
+    Bitboard king_targets = kingAttacks(king) & ~own;
+    while (king_targets) {
+        const int to = popLsb(king_targets);
+        if (position.attackersTo(to, without_king) & enemies) { continue; }
+        moves.push(EngineMove(king, to, (bit(to) & enemies) ? EngineMove::CAPTURE : EngineMove::QUIET));
+    }
+    if (popCount(checkers) > 1) {
+        Stats::increment(Stats::MOVES_GENERATED, moves.size() - start);
+        return;
+    }
+    if (!checkers) { generateCastling(position, moves); }
+
+    // Squares the other pieces may move to: anywhere, or onto the checker & its ray when in check
+    const Bitboard evasions = checkers ? (BETWEEN[king][lsb(checkers)] | checkers) : ~EMPTY;
+    const Bitboard pinned = pinnedPieces(position, us, king);
+
+    for (int type = KNIGHT; type <= QUEEN; type++) {
+        Bitboard pieces = position.pieces(us, static_cast<PieceType>(type));
+        while (pieces) {
+            const int from = popLsb(pieces);
+            Bitboard targets = attacks(static_cast<PieceType>(type), from, occupied) & ~own & evasions;
+            if (bit(from) & pinned) { targets &= LINE[king][from]; }
+            addMoves(moves, from, targets & enemies, EngineMove::CAPTURE);
+            addMoves(moves, from, targets & ~enemies, EngineMove::QUIET);
+        }
+    }
+
+    const Bitboard promotion_row = promotionRow(us);
+    const int ep = position.enPassantSquare();
+    Bitboard pawns = position.pieces(us, PAWN);
+    while (pawns) {
+        const int from = popLsb(pawns);
+        const Bitboard allowed = (bit(from) & pinned) ? (evasions & LINE[king][from]) : evasions;
+
+        Bitboard captures = pawnAttacks(us, from) & enemies & allowed;
+        while (captures) {
+            const int to = popLsb(captures);
+            if (bit(to) & promotion_row) {
+                addPromotions(moves, from, to, true, true, true);
+            } else {
+                moves.push(EngineMove(from, to, EngineMove::CAPTURE));
+            }
+        }
+
+        const Bitboard single = shiftForward(bit(from), us) & ~occupied;
+        if (single & allowed) {
+            const int to = lsb(single);
+            if (single & promotion_row) {
+                addPromotions(moves, from, to, false, true, true);
+            } else {
+                moves.push(EngineMove(from, to));
+            }
+        }
+        const Bitboard double_push = shiftForward(single, us) & ~occupied & doublePushRow(us) & allowed;
+        if (double_push) { moves.push(EngineMove(from, lsb(double_push), EngineMove::DOUBLE_PUSH)); }
+
+        // The capturing & captured pawns both leave the row, which may expose the king sideways
+        if (ep != NO_SQUARE && (pawnAttacks(us, from) & bit(ep))) {
+            const Bitboard after = (occupied ^ bit(from) ^ bit(ep - pawnPush(us))) | bit(ep);
+            if (!(position.attackersTo(king, after) & after & enemies)) {
+                moves.push(EngineMove(from, ep, EngineMove::EN_PASSANT));
+            }
+        }
+    }
+    Stats::increment(Stats::MOVES_GENERATED, moves.size() - start);
+}
+
+/**
+ * @return The number of leaf positions `depth` legal plies below `position`
+ * @post `position` is left unchanged
+ */
+uint64_t MoveGen::perft(Position& position, int depth) {
+    if (depth == 0) { return 1; }
+    MoveList moves;
+    generateLegal(position, moves);
+    if (depth == 1) { return moves.size(); }
+
+    uint64_t leaves = 0;
+    UndoInfo undo;
+    for (EngineMove move : moves) {
+        position.makeMove(move, undo);
+        leaves += perft(position, depth - 1);
+        position.unmakeMove(move, undo);
+    }
+    return leaves;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file MoveGen.hpp
+ * @brief Pseudo-legal & legal move generation over a Position, straight from attack masks.
+ *
+ * Generation is split into captures (including every promotion that captures,
+ * en passant and quiet queen promotions) and quiet moves (everything else), so that
+ * callers like the quiescence search can ask for only the moves they need.
+ * The union of the two lists is the full pseudo-legal move list.
+ *
+ * Legal generation instead works out which enemy pieces give check and which of the
+ * mover's pieces are pinned first, and only emits moves that respect them.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "Types.hpp"
+#include "Position.hpp"
+
+/**
+ * @brief A fixed-capacity list of moves that lives on the stack (no heap allocation)
+ */
+class MoveList {
+    public:
+        static const int MAX_MOVES = 256; // More than the maximum number of moves in any legal position
+
+    private:
+        EngineMove moves_[MAX_MOVES];
+        int size_;
+
+    public:
+        MoveList() : size_{0} {}
+
+        void push(EngineMove move) { moves_[size_++] = move; }
+        void clear() { size_ = 0; }
+        int size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        EngineMove& operator[](int i) { return moves_[i]; }
+        EngineMove operator[](int i) const { return moves_[i]; }
+
+        const EngineMove* begin() const { return moves_; }
+        const EngineMove* end() const { return moves_ + size_; }
+
+        /**
+         * @return True if `move` is in the list
+         */
+        bool contains(EngineMove move) const;
+};
+
+namespace MoveGen {
+    /**
+     * @brief Appends every capture, en passant capture & promotion-capture of the side to move,
+     *        plus non-capturing promotions to a queen.
+     */
+    void generateCaptures(const Position& position, MoveList& moves);
+
+    /**
+     * @brief Appends every non-capturing move that generateCaptures() does not produce
+     *        (including non-capturing under-promotions & castling).
+     */
+    void generateQuiets(const Position& position, MoveList& moves);
+
+    /**
+     * @brief Appends the non-capturing, non-promoting moves that give direct check
+     *        (discovered checks are not detected).
+     */
+    void generateQuietChecks(const Position& position, MoveList& moves);
+
+    /**
+     * @brief Appends every pseudo-legal move (captures first, then quiet moves)
+     */
+    void generatePseudoLegal(const Position& position, MoveList& moves);
+
+    /**
+     * @return True if generatePseudoLegal() would produce `move` in `position`, checked
+     *         without generating anything (eg. to try a hash move before any generation)
+     */
+    bool isPseudoLegal(const Position& position, EngineMove move);
+
+    /**
+     * @brief Appends every legal move, ie. pseudo-legal moves that do not leave the mover's king attacked.
+     *        Legality is settled from check & pin masks while generating: no move is made.
+     */
+    void generateLegal(const Position& position, MoveList& moves);
+
+    /**
+     * @return The number of leaf positions `depth` legal plies below `position`
+     * @post `position` is left unchanged
+     */
+    uint64_t perft(Position& position, int depth);
+};
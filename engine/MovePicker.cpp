@@ -0,0 +1,206 @@
+#include "MovePicker.hpp"
+#include "Evaluation.hpp"
+
+#include <algorithm>
+
+using namespace Bitboards;
+
+namespace {
+    // The king cannot be exchanged: it only ever captures last
+    const int SEE_KING_VALUE = 20000;
+
+    int exchangeValue(PieceType type) {
+        return type == KING ? SEE_KING_VALUE : Evaluation::pieceValue(type);
+    }
+}
+
+/**
+ * @brief Picker for the main search
+ * @param hash_move The transposition table's move (null if none); validated before use
+ * @param killers Two quiet moves to try right after the good captures (either may be null)
+ */
+MovePicker::MovePicker(const Position& position, EngineMove hash_move, const EngineMove killers[2])
+    : position_{position}, stage_{HASH_MOVE}, hash_move_{hash_move}, killers_{killers[0], killers[1]},
+      quiet_checks_{false}, index_{0}, bad_index_{0} {
+    // Captures & promotions are handed out with the captures: they cannot be killers
+    for (EngineMove& killer : killers_) {
+        if (killer.isCapture() || killer.isPromotion()) { killer = EngineMove(); }
+    }
+    if (!MoveGen::isPseudoLegal(position_, hash_move_)) {
+        hash_move_ = EngineMove();
+        stage_ = GENERATE_CAPTURES;
+    }
+}
+
+/**
+ * @brief Picker for quiescence: captures, then quiet checks if `quiet_checks`
+ */
+MovePicker::MovePicker(const Position& position, bool quiet_checks)
+    : position_{position}, stage_{QUIESCENCE_GENERATE_CAPTURES}, killers_{},
+      quiet_checks_{quiet_checks}, index_{0}, bad_index_{0} {}
+
+/**
+ * @return The next move, or the null move once every stage is exhausted
+ */
+EngineMove MovePicker::next() {
+    while (true) {
+        switch (stage_) {
+            case HASH_MOVE:
+                stage_ = GENERATE_CAPTURES;
+                return hash_move_;
+
+            case GENERATE_CAPTURES:
+            case QUIESCENCE_GENERATE_CAPTURES:
+                MoveGen::generateCaptures(position_, moves_);
+                scoreCaptures();
+                stage_ = (stage_ == GENERATE_CAPTURES) ? GOOD_CAPTURES : QUIESCENCE_CAPTURES;
+                break;
+
+            case GOOD_CAPTURES:
+                while (index_ < moves_.size()) {
+                    const EngineMove move = pickBest();
+                    if (move == hash_move_) { continue; }
+                    // Winning a piece at least as valuable as the capturer never loses material
+                    const bool good = move.isPromotion() || move.isEnPassant()
+                        || Evaluation::pieceValue(typeOf(position_.pieceAt(move.to())))
+                               >= Evaluation::pieceValue(typeOf(position_.pieceAt(move.from())))
+                        || see(position_, move) >= 0;
+                    if (good) { return move; }
+                    bad_captures_.push(move);
+                }
+                stage_ = KILLERS;
+                index_ = 0;
+                break;
+
+            case KILLERS:
+                while (index_ < 2) {
+                    const EngineMove killer = killers_[index_++];
+                    if (killer != hash_move_ && MoveGen::isPseudoLegal(position_, killer)) { return killer; }
+                }
+                stage_ = GENERATE_QUIETS;
+                break;
+
+            case GENERATE_QUIETS:
+                moves_.clear();
+                MoveGen::generateQuiets(position_, moves_);
+                index_ = 0;
+                stage_ = QUIETS;
+                break;
+
+            case QUIETS:
+                while (index_ < moves_.size()) {
+                    const EngineMove move = moves_[index_++];
+                    if (move != hash_move_ && move != killers_[0] && move != killers_[1]) { return move; }
+                }
+                stage_ = BAD_CAPTURES;
+                break;
+
+            case BAD_CAPTURES:
+                if (bad_index_ < bad_captures_.size()) { return bad_captures_[bad_index_++]; }
+                stage_ = DONE;
+                break;
+
+            case QUIESCENCE_CAPTURES:
+                if (index_ < moves_.size()) { return pickBest(); }
+                stage_ = quiet_checks_ ? QUIESCENCE_GENERATE_CHECKS : DONE;
+                break;
+
+            case QUIESCENCE_GENERATE_CHECKS:
+                moves_.clear();
+                MoveGen::generateQuietChecks(position_, moves_);
+                index_ = 0;
+                stage_ = QUIESCENCE_CHECKS;
+                break;
+
+            case QUIESCENCE_CHECKS:
+                if (index_ < moves_.size()) { return moves_[index_++]; }
+                stage_ = DONE;
+                break;
+
+            case DONE:
+                return EngineMove();
+        }
+    }
+}
+
+/**
+ * @brief Scores captures by MVV-LVA, promotions by the value they add
+ */
+void MovePicker::scoreCaptures() {
+    for (int i = 0; i < moves_.size(); i++) {
+        const EngineMove move = moves_[i];
+        int score = 0;
+        if (move.isCapture()) {
+            const PieceType victim = move.isEnPassant() ? PAWN : typeOf(position_.pieceAt(move.to()));
+            const PieceType attacker = typeOf(position_.pieceAt(move.from()));
+            score += 10 * Evaluation::pieceValue(victim) - attacker + 1;
+        }
+        if (move.isPromotion()) { score += Evaluation::pieceValue(move.promotion()); }
+        scores_[i] = score;
+    }
+}
+
+/**
+ * @return The highest scoring move of moves_ not handed out yet (moved into `index_`)
+ */
+EngineMove MovePicker::pickBest() {
+    int best = index_;
+    for (int i = index_ + 1; i < moves_.size(); i++) {
+        if (scores_[i] > scores_[best]) { best = i; }
+    }
+    std::swap(moves_[index_], moves_[best]);
+    std::swap(scores_[index_], scores_[best]);
+    return moves_[index_++];
+}
+
+/**
+ * @brief Static exchange evaluation: plays out every capture on the destination of
+ *        `move`, least valuable attacker first, letting each side stop when it pleases
+ * @return The material `move` wins (negative if it loses material), in centipawns
+ */
+int MovePicker::see(const Position& position, EngineMove move) {
+    const int from = move.from();
+    const int to = move.to();
+    Side side = position.sideToMove();
+    Bitboard occupied = position.occupied() ^ bit(from);
+
+    // gain[d]: what the side making capture d has won so far, if the exchange stopped there
+    int gain[32];
+    int depth = 0;
+    if (move.isEnPassant()) {
+        occupied ^= bit(side == PLAYER_ONE ? to - BOARD_LENGTH : to + BOARD_LENGTH);
+        gain[0] = Evaluation::pieceValue(PAWN);
+    } else {
+        gain[0] = Evaluation::pieceValue(typeOf(position.pieceAt(to)));
+    }
+    PieceType on_square = typeOf(position.pieceAt(from));
+    if (move.isPromotion()) {
+        on_square = move.promotion();
+        gain[0] += Evaluation::pieceValue(on_square) - Evaluation::pieceValue(PAWN);
+    }
+
+    while (depth < 31) {
+        side = opponent(side);
+        const Bitboard attackers = position.attackersTo(to, occupied) & occupied & position.pieces(side);
+        if (!attackers) { break; }
+
+        int type = PAWN;
+        while (!(attackers & position.pieces(static_cast<PieceType>(type)))) { type++; }
+        const int sq = lsb(attackers & position.pieces(static_cast<PieceType>(type)));
+
+        // A king may not capture onto a defended square
+        if (type == KING && (position.attackersTo(to, occupied ^ bit(sq)) & (occupied ^ bit(sq)) & position.pieces(opponent(side)))) { break; }
+
+        depth++;
+        gain[depth] = exchangeValue(on_square) - gain[depth - 1];
+        occupied ^= bit(sq);
+        on_square = static_cast<PieceType>(type);
+    }
+
+    // Each side only carries on with the exchange if it does not lose by doing so
+    while (depth > 0) {
+        gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+        depth--;
+    }
+    return gain[0];
+}
@@ -0,0 +1,83 @@
+/**
+ * @class MovePicker
+ * @brief Hands out the moves of a position one at a time, best first, generating them in stages.
+ *
+ * Most alpha-beta nodes are cut off by their first or second move, so generating and
+ * scoring every move up front is mostly wasted. Instead, the picker goes through stages,
+ * and only generates a stage's moves when the earlier stages are exhausted:
+ *  1. the hash move, checked for pseudo-legality without generating anything;
+ *  2. winning & equal captures (and queen promotions), by most valuable victim / least
+ *     valuable attacker (MVV-LVA). Captures losing material by static exchange are set aside;
+ *  3. the killer moves: quiet moves that caused a cutoff at the same ply elsewhere;
+ *  4. the remaining quiet moves;
+ *  5. the losing captures set aside in stage 2.
+ *
+ * In quiescence, it hands out every capture by MVV-LVA, then optionally quiet checks.
+ *
+ * Moves are pseudo-legal: the caller still has to reject those leaving its king in check.
+ */
+
+#pragma once
+
+#include "Types.hpp"
+#include "Position.hpp"
+#include "MoveGen.hpp"
+
+class MovePicker {
+    public:
+        enum Stage {
+            HASH_MOVE, GENERATE_CAPTURES, GOOD_CAPTURES, KILLERS, GENERATE_QUIETS, QUIETS, BAD_CAPTURES,
+            QUIESCENCE_GENERATE_CAPTURES, QUIESCENCE_CAPTURES, QUIESCENCE_GENERATE_CHECKS, QUIESCENCE_CHECKS,
+            DONE
+        };
+
+    private:
+        const Position& position_;
+        Stage stage_;
+        EngineMove hash_move_;
+        EngineMove killers_[2];
+        bool quiet_checks_;       // Whether quiescence also hands out quiet checks
+
+        MoveList moves_;          // Moves of the current stage
+        int scores_[MoveList::MAX_MOVES];
+        int index_;               // Next move of moves_ to consider
+        MoveList bad_captures_;
+        int bad_index_;
+
+        /**
+         * @brief Scores captures by MVV-LVA, promotions by the value they add
+         */
+        void scoreCaptures();
+
+        /**
+         * @return The highest scoring move of moves_ not handed out yet (moved into `index_`)
+         */
+        EngineMove pickBest();
+
+    public:
+        /**
+         * @brief Picker for the main search
+         * @param hash_move The transposition table's move (null if none); validated before use
+         * @param killers Two quiet moves to try right after the good captures (either may be null)
+         */
+        MovePicker(const Position& position, EngineMove hash_move, const EngineMove killers[2]);
+
+        /**
+         * @brief Picker for quiescence: captures, then quiet checks if `quiet_checks`
+         */
+        MovePicker(const Position& position, bool quiet_checks);
+
+        /**
+         * @return The next move, or the null move once every stage is exhausted
+         */
+        EngineMove next();
+
+        Stage stage() const { return stage_; }
+
+        /**
+         * @brief Static exchange evaluation: plays out every capture on the destination of
+         *        `move`, least valuable attacker first, letting each side stop when it pleases
+         * @return The material `move` wins (negative if it loses material), in centipawns
+         */
+        static int see(const Position& position, EngineMove move);
+};
@@ -0,0 +1,279 @@
+#include "Nnue.hpp"
+#include "MappedFile.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define NNUE_AVX2_PATH 1
+#include <immintrin.h>
+#endif
+
+namespace Nnue {
+    namespace {
+        /**
+         * @brief Reads little-endian integers from a buffer, failing once it runs out
+         */
+        class Reader {
+            private:
+                const uint8_t* data_;
+                const uint8_t* end_;
+
+            public:
+                Reader(const uint8_t* data, size_t size) : data_{data}, end_{data + size} {}
+
+                bool atEnd() const { return data_ == end_; }
+
+                template <typename T>
+                bool read(std::vector<T>& values, size_t count) {
+                    if (static_cast<size_t>(end_ - data_) < count * sizeof(T)) { return false; }
+                    values.resize(count);
+                    for (size_t i = 0; i < count; i++) {
+                        uint64_t value = 0;
+                        for (int byte = sizeof(T) - 1; byte >= 0; byte--) { value = (value << 8) | data_[byte]; }
+                        values[i] = static_cast<T>(value);
+                        data_ += sizeof(T);
+                    }
+                    return true;
+                }
+        };
+
+        // =============== Scalar kernels ===============
+
+        void addColumnScalar(int16_t* values, const int16_t* column) {
+            for (int i = 0; i < L1; i++) { values[i] += column[i]; }
+        }
+
+        void subtractColumnScalar(int16_t* values, const int16_t* column) {
+            for (int i = 0; i < L1; i++) { values[i] -= column[i]; }
+        }
+
+        /**
+         * @brief outputs[o] = biases[o] + sum(weights[o][i] * input[i]), for a `size`-wide input
+         */
+        void denseScalar(const uint8_t* input, int size, const int8_t* weights, const int32_t* biases,
+                         int outputs, int32_t* result) {
+            for (int o = 0; o < outputs; o++) {
+                int32_t sum = biases[o];
+                const int8_t* row = weights + o * size;
+                for (int i = 0; i < size; i++) { sum += row[i] * input[i]; }
+                result[o] = sum;
+            }
+        }
+
+        // =============== AVX2 kernels ===============
+
+#ifdef NNUE_AVX2_PATH
+        __attribute__((target("avx2"))) void addColumnAvx2(int16_t* values, const int16_t* column) {
+            for (int i = 0; i < L1; i += 16) {
+                __m256i* target = reinterpret_cast<__m256i*>(values + i);
+                const __m256i add = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column + i));
+                _mm256_store_si256(target, _mm256_add_epi16(_mm256_load_si256(target), add));
+            }
+        }
+
+        __attribute__((target("avx2"))) void subtractColumnAvx2(int16_t* values, const int16_t* column) {
+            for (int i = 0; i < L1; i += 16) {
+                __m256i* target = reinterpret_cast<__m256i*>(values + i);
+                const __m256i subtract = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column + i));
+                _mm256_store_si256(target, _mm256_sub_epi16(_mm256_load_si256(target), subtract));
+            }
+        }
+
+        /**
+         * @brief denseScalar() 32 inputs at a time. Products of a uint8 input ([0, 127]) & an int8
+         *        weight are summed pairwise into int16 (which cannot saturate: 2 * 127 * 128 < 32768),
+         *        then into int32.
+         */
+        __attribute__((target("avx2"))) void denseAvx2(const uint8_t* input, int size, const int8_t* weights,
+                                                      const int32_t* biases, int outputs, int32_t* result) {
+            const __m256i ones = _mm256_set1_epi16(1);
+            for (int o = 0; o < outputs; o++) {
+                const int8_t* row = weights + o * size;
+                __m256i sum = _mm256_setzero_si256();
+                for (int i = 0; i < size; i += 32) {
+                    const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+                    const __m256i weight = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+                    sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(in, weight), ones));
+                }
+                const __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+                const __m128i quarter = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+                const __m128i total = _mm_add_epi32(quarter, _mm_shuffle_epi32(quarter, 0xB1));
+                result[o] = biases[o] + _mm_cvtsi128_si32(total);
+            }
+        }
+#endif
+
+        /**
+         * @brief The kernels in use, picked once for the CPU running the engine
+         */
+        struct Kernels {
+            bool avx2;
+            void (*add_column)(int16_t*, const int16_t*);
+            void (*subtract_column)(int16_t*, const int16_t*);
+            void (*dense)(const uint8_t*, int, const int8_t*, const int32_t*, int, int32_t*);
+
+            Kernels() : avx2{false}, add_column{addColumnScalar}, subtract_column{subtractColumnScalar}, dense{denseScalar} {
+#ifdef NNUE_AVX2_PATH
+                if (__builtin_cpu_supports("avx2")) {
+                    avx2 = true;
+                    add_column = addColumnAvx2;
+                    subtract_column = subtractColumnAvx2;
+                    dense = denseAvx2;
+                }
+#endif
+            }
+        };
+
+        const Kernels KERNELS;
+
+        /**
+         * @brief Clips each of `size` values to [0, 127] after shifting them right by `shift`
+         */
+        template <typename T>
+        void clip(const T* values, int size, int shift, uint8_t* output) {
+            for (int i = 0; i < size; i++) { output[i] = static_cast<uint8_t>(std::min(std::max(values[i] >> shift, 0), 127)); }
+        }
+    }
+
+    /**
+     * @return The pieces `move` changes, read from `position` before the move is made
+     */
+    DirtyPieces dirtyPieces(const Position& position, EngineMove move) {
+        DirtyPieces dirty;
+        const int from = move.from();
+        const int to = move.to();
+        const Piece moving = position.pieceAt(from);
+        const Side us = sideOf(moving);
+
+        dirty.king_moved[us] = typeOf(moving) == KING;
+        if (move.isEnPassant()) {
+            const int victim = (us == PLAYER_ONE) ? to - Bitboards::BOARD_LENGTH : to + Bitboards::BOARD_LENGTH;
+            dirty.push(position.pieceAt(victim), victim, false);
+        } else if (move.isCapture()) {
+            dirty.push(position.pieceAt(to), to, false);
+        }
+        dirty.push(moving, from, false);
+        dirty.push(move.isPromotion() ? makePiece(us, move.promotion()) : moving, to, true);
+        if (move.isCastle()) {
+            const Castling& castling = castlingOf(us, move);
+            dirty.push(makePiece(us, ROOK), castling.rook_from, false);
+            dirty.push(makePiece(us, ROOK), castling.rook_to, true);
+        }
+        return dirty;
+    }
+
+    /**
+     * @return The input feature of `piece` on `square` seen by `perspective`, whose king is on `king_square`
+     */
+    int featureIndex(Side perspective, int king_square, Piece piece, int square) {
+        // Player Two sees the board upside down, so both sides' features mean the same thing
+        const int flip = (perspective == PLAYER_ONE) ? 0 : 56;
+        const int piece_index = typeOf(piece) * 2 + (sideOf(piece) != perspective);
+        return (king_square ^ flip) * PIECE_FEATURES + piece_index * 64 + (square ^ flip);
+    }
+
+    // =============== Network ===============
+
+    Network::Network() : out_bias_{0} {}
+
+    /**
+     * @brief Loads weights from `path`
+     * @return False if the file cannot be read or does not hold a network of this shape
+     */
+    bool Network::load(const std::string& path) {
+        MappedFile file;
+        if (!file.open(path) || file.size() < 8 || std::memcmp(file.data(), MAGIC, sizeof(MAGIC)) != 0) { return false; }
+        Reader reader(file.data() + 4, file.size() - 4);
+        std::vector<uint32_t> version;
+        std::vector<int32_t> out_bias;
+        const bool read = reader.read(version, 1) && version[0] == VERSION
+            && reader.read(ft_biases_, L1) && reader.read(ft_weights_, static_cast<size_t>(FEATURES) * L1)
+            && reader.read(l1_biases_, L2) && reader.read(l1_weights_, L2 * 2 * L1)
+            && reader.read(l2_biases_, L3) && reader.read(l2_weights_, L3 * L2)
+            && reader.read(out_bias, 1) && reader.read(out_weights_, L3);
+        if (!read || !reader.atEnd()) { return false; }
+        out_bias_ = out_bias[0];
+        return true;
+    }
+
+    /**
+     * @brief Computes `perspective`'s side of the accumulator of `position` from scratch
+     */
+    void Network::refresh(const Position& position, Accumulator& accumulator, Side perspective) const {
+        const int king_square = position.kingSquare(perspective);
+        int16_t* values = accumulator.values[perspective];
+        std::copy(ft_biases_.begin(), ft_biases_.end(), values);
+
+        Bitboard pieces = position.occupied() & ~position.pieces(KING);
+        while (pieces) {
+            const int square = Bitboards::popLsb(pieces);
+            const int feature = featureIndex(perspective, king_square, position.pieceAt(square), square);
+            KERNELS.add_column(values, &ft_weights_[static_cast<size_t>(feature) * L1]);
+        }
+        accumulator.computed[perspective] = true;
+    }
+
+    /**
+     * @brief Computes both sides of the accumulator of `position` from scratch
+     */
+    void Network::refresh(const Position& position, Accumulator& accumulator) const {
+        refresh(position, accumulator, PLAYER_ONE);
+        refresh(position, accumulator, PLAYER_TWO);
+    }
+
+    /**
+     * @brief Computes `perspective`'s side of `child`, the accumulator after a move, from `parent`, the one before it
+     * @param dirty The pieces the move changed. It must not move `perspective`'s king.
+     * @param king_square The king square of `perspective` (the same before & after the move)
+     */
+    void Network::update(const Accumulator& parent, Accumulator& child, const DirtyPieces& dirty,
+                         Side perspective, int king_square) const {
+        int16_t* values = child.values[perspective];
+        std::copy(parent.values[perspective], parent.values[perspective] + L1, values);
+        for (int i = 0; i < dirty.count; i++) {
+            // The other side's king may have moved, but kings are not features
+            if (typeOf(dirty.pieces[i]) == KING) { continue; }
+            const int feature = featureIndex(perspective, king_square, dirty.pieces[i], dirty.squares[i]);
+            const int16_t* column = &ft_weights_[static_cast<size_t>(feature) * L1];
+            if (dirty.added[i]) {
+                KERNELS.add_column(values, column);
+            } else {
+                KERNELS.subtract_column(values, column);
+            }
+        }
+        child.computed[perspective] = true;
+    }
+
+    /**
+     * @brief Runs the dense layers on an up to date accumulator of `position`
+     * @return A score in centipawns from the point of view of the side to move
+     */
+    int Network::evaluate(const Position& position, const Accumulator& accumulator) const {
+        alignas(32) uint8_t input[2 * L1];
+        alignas(32) int32_t hidden1[L2];
+        alignas(32) uint8_t hidden1_output[L2];
+        alignas(32) int32_t hidden2[L3];
+        alignas(32) uint8_t hidden2_output[L3];
+
+        const Side us = position.sideToMove();
+        clip(accumulator.values[us], L1, 0, input);
+        clip(accumulator.values[opponent(us)], L1, 0, input + L1);
+
+        KERNELS.dense(input, 2 * L1, l1_weights_.data(), l1_biases_.data(), L2, hidden1);
+        clip(hidden1, L2, WEIGHT_SHIFT, hidden1_output);
+        KERNELS.dense(hidden1_output, L2, l2_weights_.data(), l2_biases_.data(), L3, hidden2);
+        clip(hidden2, L3, WEIGHT_SHIFT, hidden2_output);
+
+        int32_t output = out_bias_;
+        for (int i = 0; i < L3; i++) { output += out_weights_[i] * hidden2_output[i]; }
+        return output / OUTPUT_SCALE;
+    }
+
+    /**
+     * @return True if the AVX2 code path is in use
+     */
+    bool usesAvx2() {
+        return KERNELS.avx2;
+    }
+}
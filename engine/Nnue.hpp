@@ -0,0 +1,131 @@
+/**
+ * @file Nnue.hpp
+ * @brief An efficiently updatable neural network (NNUE) evaluation, HalfKP-style.
+ *
+ * The network is 2 x (40960 -> 256) -> 32 -> 32 -> 1:
+ *  - Input features are (own king square, piece, square) triples, seen from each side in turn
+ *    (Player Two's view is mirrored vertically). Kings are not features themselves.
+ *  - The first layer's outputs, the accumulators, are int16 sums of the weight columns of the
+ *    active features. A move only turns a few features on or off, so instead of being computed
+ *    from scratch each accumulator is updated from its parent's by adding / subtracting a few
+ *    columns. Only a king move forces that side's accumulator to be rebuilt.
+ *  - Both accumulators (side to move first) are clipped to [0, 127] and fed through two small
+ *    dense int8 layers, each clipped to [0, 127] again, then a linear output layer.
+ *
+ * The arithmetic uses AVX2 when the CPU supports it (checked at run time), and plain
+ * scalar code otherwise. Both paths produce the same results.
+ *
+ * Weights file: magic, version, then each layer's biases & weights, all little-endian:
+ *   int16 ft_biases[256], int16 ft_weights[40960][256],
+ *   int32 l1_biases[32], int8 l1_weights[32][512],
+ *   int32 l2_biases[32], int8 l2_weights[32][32],
+ *   int32 out_bias, int8 out_weights[32]
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Types.hpp"
+#include "Position.hpp"
+
+namespace Nnue {
+    static const int PIECE_FEATURES = 10 * 64;                 // (piece type but king, side, square)
+    static const int FEATURES = 64 * PIECE_FEATURES;           // ... for each own king square
+    static const int L1 = 256;
+    static const int L2 = 32;
+    static const int L3 = 32;
+    static const int WEIGHT_SHIFT = 6;    // Dense layer outputs are scaled by 2^6
+    static const int OUTPUT_SCALE = 16;   // Network output units per centipawn
+    static const uint32_t VERSION = 1;
+    static const char MAGIC[4] = {'P', '6', 'N', 'N'};
+
+    /**
+     * @brief The first layer's output, from each side's point of view
+     */
+    struct alignas(32) Accumulator {
+        int16_t values[2][L1];
+        bool computed[2] = {false, false}; // Whether each side's values are up to date
+    };
+
+    /**
+     * @brief The pieces a move removes from & puts on the board, enough to update an accumulator
+     */
+    struct DirtyPieces {
+        static const int MAX = 4;  // Castling: king & rook off, king & rook on
+
+        int count = 0;
+        Piece pieces[MAX];
+        int squares[MAX];
+        bool added[MAX];
+        bool king_moved[2] = {false, false}; // Whether the move moved that side's king
+
+        void push(Piece piece, int square, bool is_added) {
+            pieces[count] = piece;
+            squares[count] = square;
+            added[count++] = is_added;
+        }
+    };
+
+    /**
+     * @return The pieces `move` changes, read from `position` before the move is made
+     */
+    DirtyPieces dirtyPieces(const Position& position, EngineMove move);
+
+    /**
+     * @return The input feature of `piece` on `square` seen by `perspective`, whose king is on `king_square`
+     */
+    int featureIndex(Side perspective, int king_square, Piece piece, int square);
+
+    class Network {
+        private:
+            std::vector<int16_t> ft_biases_;
+            std::vector<int16_t> ft_weights_;
+            std::vector<int32_t> l1_biases_;
+            std::vector<int8_t> l1_weights_;
+            std::vector<int32_t> l2_biases_;
+            std::vector<int8_t> l2_weights_;
+            int32_t out_bias_;
+            std::vector<int8_t> out_weights_;
+
+        public:
+            Network();
+
+            /**
+             * @brief Loads weights from `path`
+             * @return False if the file cannot be read or does not hold a network of this shape
+             */
+            bool load(const std::string& path);
+
+            /**
+             * @brief Computes `perspective`'s side of the accumulator of `position` from scratch
+             */
+            void refresh(const Position& position, Accumulator& accumulator, Side perspective) const;
+
+            /**
+             * @brief Computes both sides of the accumulator of `position` from scratch
+             */
+            void refresh(const Position& position, Accumulator& accumulator) const;
+
+            /**
+             * @brief Computes `perspective`'s side of `child`, the accumulator after a move, from `parent`, the one before it
+             * @param dirty The pieces the move changed. It must not move `perspective`'s king.
+             * @param king_square The king square of `perspective` (the same before & after the move)
+             */
+            void update(const Accumulator& parent, Accumulator& child, const DirtyPieces& dirty,
+                        Side perspective, int king_square) const;
+
+            /**
+             * @brief Runs the dense layers on an up to date accumulator of `position`
+             * @return A score in centipawns from the point of view of the side to move
+             */
+            int evaluate(const Position& position, const Accumulator& accumulator) const;
+    };
+
+    /**
+     * @return True if the AVX2 code path is in use
+     */
+    bool usesAvx2();
+}
@@ -0,0 +1,153 @@
+#include "Notation.hpp"
+#include "MoveGen.hpp"
+
+using namespace Bitboards;
+
+/**
+ * @return The algebraic name of `sq`, eg. "e4"
+ */
+std::string Notation::squareName(int sq) {
+    std::string name;
+    name += static_cast<char>('a' + BOARD_LENGTH - 1 - colOf(sq));
+    name += static_cast<char>('1' + rowOf(sq));
+    return name;
+}
+
+/**
+ * @return The square named by `name` (eg. "e4"), or NO_SQUARE if it is not a valid square name
+ */
+int Notation::parseSquare(const std::string& name) {
+    if (name.size() != 2 || name[0] < 'a' || name[0] > 'h' || name[1] < '1' || name[1] > '8') { return NO_SQUARE; }
+    return square(name[1] - '1', BOARD_LENGTH - 1 - (name[0] - 'a'));
+}
+
+/**
+ * @return `move` in UCI long algebraic notation, eg. "e2e4" or "e7e8q". The null move is "0000".
+ */
+std::string Notation::toUci(EngineMove move) {
+    if (move.isNull()) { return "0000"; }
+    std::string text = squareName(move.from()) + squareName(move.to());
+    if (move.isPromotion()) { text += "nbrq"[move.promotion() - KNIGHT]; }
+    return text;
+}
+
+/**
+ * @brief Finds the legal move of `position` written as `text` in UCI notation
+ * @return The move, or the null move if `text` does not describe a legal move
+ */
+EngineMove Notation::parseUci(Position& position, const std::string& text) {
+    MoveList moves;
+    MoveGen::generateLegal(position, moves);
+    for (EngineMove move : moves) {
+        if (toUci(move) == text) { return move; }
+    }
+    return EngineMove();
+}
+
+/**
+ * @return Legal move `move` of `position` in Standard Algebraic Notation, eg. "Nbd7", "e8=Q+" or "O-O"
+ * @post `position` is left unchanged
+ */
+std::string Notation::toSan(Position& position, EngineMove move) {
+    if (move.isNull()) { return "--"; }
+    const PieceType type = typeOf(position.pieceAt(move.from()));
+    const std::string from = squareName(move.from());
+
+    std::string text;
+    if (move.isCastle()) {
+        text = (move.flags() == EngineMove::KING_CASTLE) ? "O-O" : "O-O-O";
+    } else if (type == PAWN) {
+        if (move.isCapture()) { text += from[0]; }
+    } else {
+        text += "PNBRQK"[type];
+
+        // Name the origin file, else rank, else both, if another piece of the kind can go there too
+        MoveList moves;
+        MoveGen::generateLegal(position, moves);
+        bool shared = false, same_col = false, same_row = false;
+        for (EngineMove other : moves) {
+            if (other == move || other.to() != move.to() || position.pieceAt(other.from()) != position.pieceAt(move.from())) { continue; }
+            shared = true;
+            same_col |= colOf(other.from()) == colOf(move.from());
+            same_row |= rowOf(other.from()) == rowOf(move.from());
+        }
+        if (shared && !same_col) { text += from[0]; }
+        else if (shared && !same_row) { text += from[1]; }
+        else if (shared) { text += from; }
+    }
+    if (!move.isCastle()) {
+        if (move.isCapture()) { text += 'x'; }
+        text += squareName(move.to());
+        if (move.isPromotion()) { text += std::string("=") + "NBRQ"[move.promotion() - KNIGHT]; }
+    }
+
+    UndoInfo undo;
+    position.makeMove(move, undo);
+    if (position.inCheck()) {
+        MoveList replies;
+        MoveGen::generateLegal(position, replies);
+        text += replies.empty() ? '#' : '+';
+    }
+    position.unmakeMove(move, undo);
+    return text;
+}
+
+/**
+ * @brief Finds the legal move of `position` written as `text` in Standard Algebraic Notation,
+ *        eg. "Nbd7", "exd6", "e8=Q+", "O-O-O" or "Qh4xe1#". Check & annotation suffixes are ignored.
+ * @return The move, or the null move if `text` does not describe exactly one legal move
+ */
+EngineMove Notation::parseSan(Position& position, std::string_view text) {
+    while (!text.empty() && (text.back() == '+' || text.back() == '#' || text.back() == '!' || text.back() == '?')) {
+        text.remove_suffix(1);
+    }
+
+    MoveList moves;
+    MoveGen::generateLegal(position, moves);
+
+    // Castling names no square, only the wing ("0-0" is a common variant)
+    if (text == "O-O" || text == "0-0" || text == "O-O-O" || text == "0-0-0") {
+        const int flags = (text.size() == 3) ? EngineMove::KING_CASTLE : EngineMove::QUEEN_CASTLE;
+        for (EngineMove move : moves) {
+            if (move.flags() == flags) { return move; }
+        }
+        return EngineMove();
+    }
+
+    // Optional promotion suffix: "=Q", or just "Q" after the destination
+    int promotion = NO_PIECE_TYPE;
+    if (text.size() >= 3 && std::string_view("NBRQ").find(text.back()) != std::string_view::npos
+        && (text[text.size() - 2] == '=' || (text[text.size() - 2] >= '1' && text[text.size() - 2] <= '8'))) {
+        promotion = KNIGHT + static_cast<int>(std::string_view("NBRQ").find(text.back()));
+        text.remove_suffix(text[text.size() - 2] == '=' ? 2 : 1);
+    }
+
+    // Moving piece, then destination square; whatever remains in between disambiguates
+    PieceType type = PAWN;
+    const size_t piece_letter = text.empty() ? std::string_view::npos : std::string_view("NBRQK").find(text.front());
+    if (piece_letter != std::string_view::npos) {
+        type = static_cast<PieceType>(KNIGHT + piece_letter);
+        text.remove_prefix(1);
+    }
+    if (text.size() < 2) { return EngineMove(); }
+    const int to = parseSquare(std::string(text.substr(text.size() - 2)));
+    if (to == NO_SQUARE) { return EngineMove(); }
+    text.remove_suffix(2);
+
+    int from_col = -1, from_row = -1;
+    for (char c : text) {
+        if (c >= 'a' && c <= 'h') { from_col = BOARD_LENGTH - 1 - (c - 'a'); }
+        else if (c >= '1' && c <= '8') { from_row = c - '1'; }
+        else if (c != 'x' && c != ':' && c != '-') { return EngineMove(); }
+    }
+
+    EngineMove found;
+    for (EngineMove move : moves) {
+        if (move.to() != to || typeOf(position.pieceAt(move.from())) != type) { continue; }
+        if ((move.isPromotion() ? move.promotion() : NO_PIECE_TYPE) != promotion) { continue; }
+        if ((from_col >= 0 && colOf(move.from()) != from_col) || (from_row >= 0 && rowOf(move.from()) != from_row)) { continue; }
+        if (!found.isNull()) { return EngineMove(); } // Ambiguous
+        found = move;
+    }
+    return found;
+}
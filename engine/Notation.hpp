@@ -0,0 +1,52 @@
+/**
+ * @file Notation.hpp
+ * @brief Conversions between engine squares / moves and standard chess notation.
+ *
+ * Square (row, col) is written as file ('h' - col) followed by rank (row + 1),
+ * so a freshly set up ChessBoard reads as the standard starting position with
+ * Player One as White.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "Types.hpp"
+#include "Position.hpp"
+
+namespace Notation {
+    /**
+     * @return The algebraic name of `sq`, eg. "e4"
+     */
+    std::string squareName(int sq);
+
+    /**
+     * @return The square named by `name` (eg. "e4"), or NO_SQUARE if it is not a valid square name
+     */
+    int parseSquare(const std::string& name);
+
+    /**
+     * @return `move` in UCI long algebraic notation, eg. "e2e4" or "e7e8q". The null move is "0000".
+     */
+    std::string toUci(EngineMove move);
+
+    /**
+     * @brief Finds the legal move of `position` written as `text` in UCI notation
+     * @return The move, or the null move if `text` does not describe a legal move
+     */
+    EngineMove parseUci(Position& position, const std::string& text);
+
+    /**
+     * @return Legal move `move` of `position` in Standard Algebraic Notation, eg. "Nbd7", "e8=Q+" or "O-O"
+     * @post `position` is left unchanged
+     */
+    std::string toSan(Position& position, EngineMove move);
+
+    /**
+     * @brief Finds the legal move of `position` written as `text` in Standard Algebraic Notation,
+     *        eg. "Nbd7", "exd6", "e8=Q+", "O-O-O" or "Qh4xe1#". Check & annotation suffixes are ignored.
+     * @return The move, or the null move if `text` does not describe exactly one legal move
+     */
+    EngineMove parseSan(Position& position, std::string_view text);
+};
@@ -0,0 +1,237 @@
+#include "Pgn.hpp"
+#include "Notation.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace {
+    bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    /**
+     * @return True if `c` ends a movetext token
+     */
+    bool isDelimiter(char c) {
+        return isSpace(c) || c == '{' || c == '}' || c == '(' || c == ')' || c == '[' || c == ']' || c == ';';
+    }
+
+    bool isResult(std::string_view token) {
+        return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+    }
+}
+
+/**
+ * @return The value of tag `name`, or an empty view if the game has no such tag
+ */
+std::string_view PgnGame::tag(std::string_view name) const {
+    for (const auto& tag : tags) {
+        if (tag.first == name) { return tag.second; }
+    }
+    return std::string_view();
+}
+
+void PgnGame::clear() {
+    tags.clear();
+    start_fen = std::string_view();
+    moves.clear();
+    result = std::string_view();
+    offset = 0;
+}
+
+PgnStats& PgnStats::operator+=(const PgnStats& other) {
+    games += other.games;
+    moves += other.moves;
+    errors += other.errors;
+    return *this;
+}
+
+/**
+ * @brief Maps the PGN file at `path`
+ * @return True if the file could be mapped
+ */
+bool PgnReader::open(const std::string& path) {
+    return file_.open(path);
+}
+
+/**
+ * @return The mapped text of the file
+ */
+std::string_view PgnReader::text() const {
+    return std::string_view(reinterpret_cast<const char*>(file_.data()), file_.size());
+}
+
+/**
+ * @brief Parses the whole file on the calling thread
+ */
+PgnStats PgnReader::parse(const Visitor& visitor) const {
+    return parseRange(0, file_.size(), 0, visitor);
+}
+
+/**
+ * @brief Parses the file on `threads` threads (0: one per hardware thread).
+ *        `visitor` is called concurrently from every thread: it must be thread-safe.
+ *        Games are handed out in file order within each thread's chunk only.
+ *        Thread `t` parses the t-th chunk of the file, so chunks follow each other in thread order.
+ */
+PgnStats PgnReader::parseParallel(const Visitor& visitor, unsigned threads) const {
+    if (threads == 0) { threads = std::max(1u, std::thread::hardware_concurrency()); }
+
+    // Chunk boundaries, moved forward to the next game so that no game is split
+    std::vector<size_t> bounds{0};
+    for (unsigned thread = 1; thread < threads; thread++) {
+        bounds.push_back(std::max(bounds.back(), nextGameStart(file_.size() / threads * thread)));
+    }
+    bounds.push_back(file_.size());
+
+    std::vector<PgnStats> stats(threads);
+    std::vector<std::thread> workers;
+    for (unsigned thread = 0; thread < threads; thread++) {
+        workers.emplace_back([&, thread]() { stats[thread] = parseRange(bounds[thread], bounds[thread + 1], thread, visitor); });
+    }
+    PgnStats total;
+    for (unsigned thread = 0; thread < threads; thread++) {
+        workers[thread].join();
+        total += stats[thread];
+    }
+    return total;
+}
+
+/**
+ * @return The offset of the first game starting at or after `offset`, or the file size
+ */
+size_t PgnReader::nextGameStart(size_t offset) const {
+    if (offset == 0) { return 0; }
+    const size_t found = text().find("\n[Event ", offset - 1);
+    return found == std::string_view::npos ? file_.size() : found + 1;
+}
+
+/**
+ * @brief Parses the games starting within [begin, end) of the file
+ */
+PgnStats PgnReader::parseRange(size_t begin, size_t end, unsigned thread, const Visitor& visitor) const {
+    const std::string_view text = this->text();
+    PgnStats stats;
+    PgnGame game;
+    Position position;
+    UndoInfo undo;
+    bool in_game = false;   // Between a game's first tag / move and its result
+    bool in_moves = false;  // Past the tag section of the current game
+    bool failed = false;    // The current game had an unreadable move: skip to its end
+
+    // Hands the current game out, or counts it as an error
+    auto finishGame = [&]() {
+        in_game = in_moves = false;
+        if (failed) {
+            stats.errors++;
+            return true;
+        }
+        stats.games++;
+        stats.moves += game.moves.size();
+        return visitor(game, thread);
+    };
+    auto startGame = [&](size_t offset) {
+        game.clear();
+        game.offset = offset;
+        position = Position();
+        in_game = true;
+        in_moves = failed = false;
+    };
+
+    size_t pos = begin;
+    while (pos < text.size()) {
+        const char c = text[pos];
+        if (isSpace(c)) { pos++; continue; }
+
+        if (c == '[') {
+            // A tag after movetext starts the next game, even if the last one had no result
+            if (in_moves && !finishGame()) { return stats; }
+            if (!in_game) {
+                if (pos >= end) { break; } // The next chunk's game
+                startGame(pos);
+            }
+
+            const size_t close = text.find(']', pos);
+            if (close == std::string_view::npos) { failed = true; break; }
+            std::string_view tag = text.substr(pos + 1, close - pos - 1);
+            pos = close + 1;
+
+            const size_t name_end = tag.find(' ');
+            const size_t quote = tag.find('"');
+            const size_t last_quote = tag.rfind('"');
+            if (name_end == std::string_view::npos || quote == std::string_view::npos || last_quote <= quote) { continue; }
+            const std::string_view name = tag.substr(0, name_end);
+            const std::string_view value = tag.substr(quote + 1, last_quote - quote - 1);
+            game.tags.emplace_back(name, value);
+            if (name == "FEN") {
+                game.start_fen = value;
+                if (!position.setFromFen(std::string(value))) { failed = true; }
+            }
+            continue;
+        }
+
+        if (c == '{') {
+            const size_t close = text.find('}', pos);
+            pos = (close == std::string_view::npos) ? text.size() : close + 1;
+            continue;
+        }
+        if (c == ';' || (c == '%' && (pos == 0 || text[pos - 1] == '\n'))) {
+            const size_t newline = text.find('\n', pos);
+            pos = (newline == std::string_view::npos) ? text.size() : newline + 1;
+            continue;
+        }
+        if (c == '(') {
+            // Variations nest, and may hold comments with parentheses in them
+            int depth = 0;
+            for (; pos < text.size(); pos++) {
+                if (text[pos] == '{') {
+                    const size_t close = text.find('}', pos);
+                    pos = (close == std::string_view::npos) ? text.size() - 1 : close;
+                } else if (text[pos] == '(') {
+                    depth++;
+                } else if (text[pos] == ')' && --depth == 0) {
+                    pos++;
+                    break;
+                }
+            }
+            continue;
+        }
+        if (c == ')' || c == '}' || c == ']') { pos++; continue; }
+
+        size_t token_end = pos;
+        while (token_end < text.size() && !isDelimiter(text[token_end])) { token_end++; }
+        std::string_view token = text.substr(pos, token_end - pos);
+        pos = token_end;
+
+        if (!in_game) {
+            if (pos - token.size() >= end) { break; }
+            startGame(pos - token.size());
+        }
+        in_moves = true;
+
+        if (isResult(token)) {
+            game.result = token;
+            if (!finishGame()) { return stats; }
+            continue;
+        }
+        if (token[0] == '$') { continue; } // NAG
+
+        // Move numbers ("12." or "12...") may be glued to the move that follows. Only digits followed
+        // by a dot are one, so that castling written with zeros ("0-0", "0-0-0") is left whole.
+        size_t digits = 0;
+        while (digits < token.size() && token[digits] >= '0' && token[digits] <= '9') { digits++; }
+        if (digits < token.size() && token[digits] == '.') {
+            token.remove_prefix(digits);
+            while (!token.empty() && token[0] == '.') { token.remove_prefix(1); }
+        }
+        if (token.empty() || failed) { continue; }
+
+        EngineMove move = Notation::parseSan(position, token);
+        if (move.isNull()) { failed = true; continue; }
+        game.moves.push_back(move);
+        position.makeMove(move, undo);
+    }
+
+    if (in_game && (in_moves || !game.tags.empty())) { finishGame(); }
+    return stats;
+}
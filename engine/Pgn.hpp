@@ -0,0 +1,105 @@
+/**
+ * @class PgnReader
+ * @brief Reads game collections in Portable Game Notation, straight from a memory-mapped file.
+ *
+ * The file is never copied: tokens, tag names & tag values are std::string_views into the
+ * mapping, and the operating system pages the file in as the reader advances, so a file of
+ * any size is processed in a single streaming pass with constant memory.
+ *
+ * Moves are resolved against the engine's move generator as they are read, so every game
+ * handed out has been replayed and checked. Games with an unknown or illegal move are counted
+ * as errors and skipped. Comments, variations, NAGs & move numbers are skipped as well.
+ *
+ * For parallel parsing, the file is cut into one chunk per thread at game boundaries (lines
+ * starting with "[Event "), and each thread parses its chunk independently.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Types.hpp"
+#include "Position.hpp"
+#include "MappedFile.hpp"
+
+/**
+ * @brief One game of a PGN file. Views point into the reader's mapped file.
+ */
+struct PgnGame {
+    std::vector<std::pair<std::string_view, std::string_view>> tags; // Name & value, in file order
+    std::string_view start_fen;  // The FEN tag, or empty for the standard starting position
+    std::vector<EngineMove> moves;
+    std::string_view result;     // "1-0", "0-1", "1/2-1/2" or "*"
+    uint64_t offset;             // Where the game starts in the file
+
+    /**
+     * @return The value of tag `name`, or an empty view if the game has no such tag
+     */
+    std::string_view tag(std::string_view name) const;
+
+    void clear();
+};
+
+/**
+ * @brief What a parse went through
+ */
+struct PgnStats {
+    uint64_t games = 0;   // Games handed out
+    uint64_t moves = 0;   // Moves of those games
+    uint64_t errors = 0;  // Games skipped over an unreadable or illegal move / FEN
+
+    PgnStats& operator+=(const PgnStats& other);
+};
+
+class PgnReader {
+    public:
+        /**
+         * @brief Called for every valid game, with the index of the thread parsing it.
+         *        Returning false stops that thread's parse.
+         *        The game, and the views it holds, are only valid during the call.
+         */
+        typedef std::function<bool(const PgnGame&, unsigned)> Visitor;
+
+    private:
+        MappedFile file_;
+
+        /**
+         * @brief Parses the games starting within [begin, end) of the file
+         */
+        PgnStats parseRange(size_t begin, size_t end, unsigned thread, const Visitor& visitor) const;
+
+        /**
+         * @return The offset of the first game starting at or after `offset`, or the file size
+         */
+        size_t nextGameStart(size_t offset) const;
+
+    public:
+        /**
+         * @brief Maps the PGN file at `path`
+         * @return True if the file could be mapped
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @return The mapped text of the file
+         */
+        std::string_view text() const;
+
+        /**
+         * @brief Parses the whole file on the calling thread
+         */
+        PgnStats parse(const Visitor& visitor) const;
+
+        /**
+         * @brief Parses the file on `threads` threads (0: one per hardware thread).
+         *        `visitor` is called concurrently from every thread: it must be thread-safe.
+         *        Games are handed out in file order within each thread's chunk only.
+         *        Thread `t` parses the t-th chunk of the file, so chunks follow each other in thread order.
+         */
+        PgnStats parseParallel(const Visitor& visitor, unsigned threads = 0) const;
+};
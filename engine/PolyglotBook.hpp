@@ -0,0 +1,120 @@
+/**
+ * @class PolyglotBook
+ * @brief Reads opening books in the Polyglot .bin format, in place.
+ *
+ * A Polyglot book is an array of 16-byte big-endian entries (key, move, weight, learn)
+ * sorted by key, where the key is the Polyglot hash of a position. The book file is
+ * memory-mapped and searched with a binary search, so opening a book costs nothing
+ * whatever its size, and a lookup touches only the ~log2(n) pages it reads.
+ *
+ * Polyglot keys are built from a published table of 781 random 64-bit numbers
+ * ("Random64"), not from the engine's own Zobrist keys. The table is built in, in the
+ * order of the reference implementation:
+ *  - [0, 768)   piece on square: 64 * kind + 8 * rank + file, where kind is
+ *               2 * (pawn 0 .. king 5) + (1 if White)
+ *  - [768, 772) castling rights: White short, White long, Black short, Black long
+ *  - [772, 780) en passant file, only when a pawn of the side to move can capture there
+ *  - 780        White to move
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Types.hpp"
+#include "Position.hpp"
+#include "MappedFile.hpp"
+
+/**
+ * @brief One book entry, decoded from its on-disk big-endian form
+ */
+struct BookEntry {
+    uint64_t key;
+    uint16_t move;   // Polyglot move encoding: to file/rank, from file/rank, promotion
+    uint16_t weight; // Relative frequency of the move among the position's entries
+    uint32_t learn;
+};
+
+class PolyglotBook {
+    public:
+        static const size_t ENTRY_SIZE = 16;
+        static const size_t RANDOM_COUNT = 781;
+        static const size_t RANDOM_CASTLE = 768;
+        static const size_t RANDOM_EN_PASSANT = 772;
+        static const size_t RANDOM_TURN = 780;
+
+    private:
+        MappedFile file_;
+        std::mt19937_64 rng_;
+
+        /**
+         * @return The entry at `index` of the mapped file
+         */
+        BookEntry entryAt(size_t index) const;
+
+        /**
+         * @return The index of the first entry whose key is not less than `key`
+         */
+        size_t lowerBound(uint64_t key) const;
+
+        /**
+         * @brief Converts a Polyglot move to the matching legal move of `position`
+         * @return The move, or the null move if no legal move matches
+         */
+        static EngineMove toEngineMove(Position& position, uint16_t book_move);
+
+    public:
+        /**
+         * @brief Parameterized constructor.
+         * @param seed The seed of the generator used by probe() to pick among weighted moves
+         */
+        explicit PolyglotBook(uint64_t seed = std::random_device{}());
+
+        /**
+         * @brief Maps the book file at `path`, replacing any previous book
+         * @return True if the book was opened. False if it could not be mapped, or is not a whole number of entries.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Closes the book
+         */
+        void close();
+
+        /**
+         * @return True if a book is open, ie. lookups may succeed
+         */
+        bool isReady() const;
+
+        /**
+         * @return The number of entries in the book
+         */
+        size_t size() const;
+
+        /**
+         * @return The Polyglot hash of `position`
+         */
+        uint64_t key(const Position& position) const;
+
+        /**
+         * @brief Collects every book entry of `position`, in book order (usually best first)
+         * @return The number of entries found
+         */
+        size_t entries(const Position& position, std::vector<BookEntry>& found) const;
+
+        /**
+         * @brief Picks a book move for `position`, each with a probability proportional to its weight
+         * @return The chosen move, or the null move if the position is not in the book
+         */
+        EngineMove probe(Position& position);
+
+        /**
+         * @brief Picks the book move of `position` with the highest weight
+         * @return The move, or the null move if the position is not in the book
+         */
+        EngineMove bestMove(Position& position) const;
+};
@@ -0,0 +1,415 @@
+#include "Position.hpp"
+#include "Stats.hpp"
+#include "../ChessBoard.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+using namespace Bitboards;
+
+/**
+ * @brief Default constructor.
+ * @post The position matches the setup of a freshly constructed ChessBoard:
+ *       Player One's pieces on rows 0-1, Player Two's on rows 6-7, Player One to move,
+ *       and both sides may castle either way.
+ */
+Position::Position() {
+    clear();
+    const PieceType inner_pieces[BOARD_LENGTH] = { ROOK, KNIGHT, BISHOP, KING, QUEEN, BISHOP, KNIGHT, ROOK };
+    for (int col = 0; col < BOARD_LENGTH; col++) {
+        setPiece(square(0, col), makePiece(PLAYER_ONE, inner_pieces[col]));
+        setPiece(square(1, col), makePiece(PLAYER_ONE, PAWN));
+        setPiece(square(6, col), makePiece(PLAYER_TWO, PAWN));
+        setPiece(square(7, col), makePiece(PLAYER_TWO, inner_pieces[col]));
+    }
+    setCastlingRights(ALL_CASTLING);
+}
+
+/**
+ * @brief Builds a Position from the current state of a ChessBoard
+ * @param board The board to mirror, read from its piece lists. Pieces whose color matches
+ *        Player One's color belong to PLAYER_ONE, every other piece to PLAYER_TWO.
+ * @return A position with the same pieces on the same squares and the same side to move.
+ *         ChessBoard does not play castling, so neither side may castle.
+ */
+Position Position::fromBoard(const ChessBoard& board) {
+    Position position;
+    position.clear();
+
+    // PieceKind::PAWN ... PieceKind::KING, in PieceType order
+    const PieceKind kinds[] = {PieceKind::PAWN, PieceKind::KNIGHT, PieceKind::BISHOP, PieceKind::ROOK, PieceKind::QUEEN, PieceKind::KING};
+    for (Side side : {PLAYER_ONE, PLAYER_TWO}) {
+        for (int type = PAWN; type <= KING; type++) {
+            for (int cell : board.pieceList(side == PLAYER_ONE, kinds[type])) {
+                position.setPiece(cell, makePiece(side, static_cast<PieceType>(type)));
+            }
+        }
+    }
+
+    position.setSideToMove(board.isPlayerOneTurn() ? PLAYER_ONE : PLAYER_TWO);
+    return position;
+}
+
+/**
+ * @brief Replaces this position with the one described by a FEN string
+ *
+ * Uppercase pieces & "w" denote Player One (White). Files run from 'a' at col 7
+ * to 'h' at col 0, ranks from '1' at row 0 to '8' at row 7.
+ *
+ * @return True if the FEN was valid. Otherwise false, and the position is left unchanged.
+ */
+bool Position::setFromFen(const std::string& fen) {
+    std::istringstream fields(fen);
+    std::string placement, side, castling, ep;
+    int halfmove_clock = 0, fullmove_number = 1;
+    if (!(fields >> placement >> side)) { return false; }
+    fields >> castling >> ep >> halfmove_clock >> fullmove_number;
+
+    Position result;
+    result.clear();
+
+    // Ranks are listed from 8 down to 1, files from a to h
+    int row = BOARD_LENGTH - 1, col = BOARD_LENGTH - 1;
+    for (char c : placement) {
+        if (c == '/') {
+            if (col != -1 || row == 0) { return false; }
+            row--;
+            col = BOARD_LENGTH - 1;
+        } else if (std::isdigit(static_cast<unsigned char>(c))) {
+            col -= c - '0';
+            if (col < -1) { return false; }
+        } else {
+            const std::string symbols = "pnbrqk";
+            size_t type = symbols.find(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+            if (type == std::string::npos || col < 0) { return false; }
+            Side piece_side = std::isupper(static_cast<unsigned char>(c)) ? PLAYER_ONE : PLAYER_TWO;
+            result.setPiece(square(row, col--), makePiece(piece_side, static_cast<PieceType>(type)));
+        }
+    }
+    if (row != 0 || col != -1) { return false; }
+
+    if (side != "w" && side != "b") { return false; }
+    result.setSideToMove(side == "w" ? PLAYER_ONE : PLAYER_TWO);
+
+    int rights = NO_CASTLING;
+    if (castling != "-") {
+        for (char c : castling) {
+            const size_t right = std::string("KQkq").find(c);
+            if (right == std::string::npos) { return false; }
+            rights |= 1 << right;
+        }
+    }
+    result.setCastlingRights(rights);
+
+    if (ep.size() == 2 && ep[0] >= 'a' && ep[0] <= 'h' && ep[1] >= '1' && ep[1] <= '8') {
+        result.setEnPassantSquare(square(ep[1] - '1', BOARD_LENGTH - 1 - (ep[0] - 'a')));
+    }
+    result.halfmove_clock_ = std::max(0, halfmove_clock);
+    result.fullmove_number_ = std::max(1, fullmove_number);
+
+    *this = result;
+    return true;
+}
+
+/**
+ * @return The FEN string describing this position
+ */
+std::string Position::toFen() const {
+    std::ostringstream fen;
+    const std::string symbols = "PNBRQKpnbrqk";
+    for (int row = BOARD_LENGTH - 1; row >= 0; row--) {
+        int empty = 0;
+        for (int col = BOARD_LENGTH - 1; col >= 0; col--) {
+            Piece piece = board_[square(row, col)];
+            if (piece == NO_PIECE) { empty++; continue; }
+            if (empty) { fen << empty; empty = 0; }
+            fen << symbols[piece];
+        }
+        if (empty) { fen << empty; }
+        if (row > 0) { fen << '/'; }
+    }
+
+    fen << (side_to_move_ == PLAYER_ONE ? " w " : " b ");
+    if (castling_rights_ == NO_CASTLING) { fen << '-'; }
+    for (int right = 0; right < 4; right++) {
+        if (castling_rights_ & (1 << right)) { fen << "KQkq"[right]; }
+    }
+    if (ep_square_ == NO_SQUARE) {
+        fen << " -";
+    } else {
+        fen << ' ' << static_cast<char>('a' + BOARD_LENGTH - 1 - colOf(ep_square_)) << static_cast<char>('1' + rowOf(ep_square_));
+    }
+    fen << ' ' << halfmove_clock_ << ' ' << fullmove_number_;
+    return fen.str();
+}
+
+// =============== Setup ===============
+
+/**
+ * @brief Removes every piece and resets the side to move, clocks & key
+ */
+void Position::clear() {
+    for (Bitboard& b : by_type_) { b = EMPTY; }
+    for (Bitboard& b : by_side_) { b = EMPTY; }
+    for (Piece& p : board_) { p = NO_PIECE; }
+    side_to_move_ = PLAYER_ONE;
+    castling_rights_ = NO_CASTLING;
+    ep_square_ = NO_SQUARE;
+    halfmove_clock_ = 0;
+    fullmove_number_ = 1;
+    key_ = 0;
+    pawn_key_ = 0;
+}
+
+/**
+ * @brief Places `piece` on `sq`, replacing whatever was there (NO_PIECE empties the square)
+ */
+void Position::setPiece(int sq, Piece piece) {
+    if (board_[sq] != NO_PIECE) { removePiece(sq); }
+    if (piece != NO_PIECE) { putPiece(sq, piece); }
+}
+
+void Position::setSideToMove(Side side) {
+    if (side != side_to_move_) { key_ ^= Zobrist::KEYS.side; }
+    side_to_move_ = side;
+}
+
+void Position::setEnPassantSquare(int sq) {
+    if (ep_square_ != NO_SQUARE) { key_ ^= Zobrist::KEYS.en_passant_col[colOf(ep_square_)]; }
+    ep_square_ = sq;
+    if (ep_square_ != NO_SQUARE) { key_ ^= Zobrist::KEYS.en_passant_col[colOf(ep_square_)]; }
+}
+
+/**
+ * @brief Sets the CastlingRight bits held. A right is only kept if its king & rook
+ *        stand on their starting squares.
+ */
+void Position::setCastlingRights(int rights) {
+    for (int side = 0; side < 2; side++) {
+        for (const Castling& castling : CASTLINGS[side]) {
+            const Piece king = makePiece(static_cast<Side>(side), KING);
+            const Piece rook = makePiece(static_cast<Side>(side), ROOK);
+            if (board_[castling.king_from] != king || board_[castling.rook_from] != rook) { rights &= ~castling.right; }
+        }
+    }
+    key_ ^= Zobrist::KEYS.castling[castling_rights_] ^ Zobrist::KEYS.castling[rights];
+    castling_rights_ = rights;
+}
+
+void Position::putPiece(int sq, Piece piece) {
+    board_[sq] = piece;
+    by_type_[typeOf(piece)] |= bit(sq);
+    by_side_[sideOf(piece)] |= bit(sq);
+    key_ ^= Zobrist::KEYS.piece_square[piece][sq];
+    if (typeOf(piece) == PAWN) { pawn_key_ ^= Zobrist::KEYS.piece_square[piece][sq]; }
+}
+
+void Position::removePiece(int sq) {
+    Piece piece = board_[sq];
+    board_[sq] = NO_PIECE;
+    by_type_[typeOf(piece)] &= ~bit(sq);
+    by_side_[sideOf(piece)] &= ~bit(sq);
+    key_ ^= Zobrist::KEYS.piece_square[piece][sq];
+    if (typeOf(piece) == PAWN) { pawn_key_ ^= Zobrist::KEYS.piece_square[piece][sq]; }
+}
+
+void Position::movePiece(int from, int to) {
+    Piece piece = board_[from];
+    Bitboard from_to = bit(from) | bit(to);
+    board_[from] = NO_PIECE;
+    board_[to] = piece;
+    by_type_[typeOf(piece)] ^= from_to;
+    by_side_[sideOf(piece)] ^= from_to;
+    key_ ^= Zobrist::KEYS.piece_square[piece][from] ^ Zobrist::KEYS.piece_square[piece][to];
+    if (typeOf(piece) == PAWN) { pawn_key_ ^= Zobrist::KEYS.piece_square[piece][from] ^ Zobrist::KEYS.piece_square[piece][to]; }
+}
+
+// =============== Queries ===============
+
+/**
+ * @return The square of `side`'s king, or NO_SQUARE if it has none
+ */
+int Position::kingSquare(Side side) const {
+    Bitboard king = pieces(side, KING);
+    return king ? lsb(king) : NO_SQUARE;
+}
+
+/**
+ * @brief Finds every piece (of either side) attacking `sq`, given the occupancy `occupied`
+ */
+Bitboard Position::attackersTo(int sq, Bitboard occupied) const {
+    Bitboard rook_like = by_type_[ROOK] | by_type_[QUEEN];
+    Bitboard bishop_like = by_type_[BISHOP] | by_type_[QUEEN];
+
+    // A pawn of side S on X attacks sq exactly when a pawn of the other side on sq would attack X.
+    return (pawnAttacks(PLAYER_TWO, sq) & pieces(PLAYER_ONE, PAWN))
+         | (pawnAttacks(PLAYER_ONE, sq) & pieces(PLAYER_TWO, PAWN))
+         | (knightAttacks(sq) & by_type_[KNIGHT])
+         | (kingAttacks(sq) & by_type_[KING])
+         | (rookAttacks(sq, occupied) & rook_like)
+         | (bishopAttacks(sq, occupied) & bishop_like);
+}
+
+/**
+ * @return True if any piece of side `by` attacks `sq`
+ */
+bool Position::isSquareAttacked(int sq, Side by) const {
+    Bitboard them = by_side_[by];
+    if (pawnAttacks(opponent(by), sq) & by_type_[PAWN] & them) { return true; }
+    if (knightAttacks(sq) & by_type_[KNIGHT] & them) { return true; }
+    if (kingAttacks(sq) & by_type_[KING] & them) { return true; }
+
+    Bitboard occ = occupied();
+    if (rookAttacks(sq, occ) & (by_type_[ROOK] | by_type_[QUEEN]) & them) { return true; }
+    return bishopAttacks(sq, occ) & (by_type_[BISHOP] | by_type_[QUEEN]) & them;
+}
+
+/**
+ * @return True if the side to move is in check
+ */
+bool Position::inCheck() const {
+    int king = kingSquare(side_to_move_);
+    return king != NO_SQUARE && isSquareAttacked(king, opponent(side_to_move_));
+}
+
+/**
+ * @return True if the side that just moved left its own king attacked,
+ *         ie. the last pseudo-legal move made was illegal.
+ */
+bool Position::leftKingInCheck() const {
+    int king = kingSquare(opponent(side_to_move_));
+    return king != NO_SQUARE && isSquareAttacked(king, side_to_move_);
+}
+
+/**
+ * @return True if either side still has enough material to deliver mate
+ */
+bool Position::hasMatingMaterial() const {
+    if (by_type_[PAWN] | by_type_[ROOK] | by_type_[QUEEN]) { return true; }
+    // A lone minor piece (per side) cannot force mate
+    for (int side = 0; side < 2; side++) {
+        if (popCount(by_side_[side] & (by_type_[KNIGHT] | by_type_[BISHOP])) > 1) { return true; }
+    }
+    return false;
+}
+
+// =============== Make / Unmake ===============
+
+/**
+ * @brief Plays a pseudo-legal move
+ * @param move A move generated for this position
+ * @param undo Receives the information needed to take the move back
+ * @post The move is executed, the side to move flips and the key is updated incrementally
+ */
+void Position::makeMove(EngineMove move, UndoInfo& undo) {
+    const int from = move.from();
+    const int to = move.to();
+    const Side us = side_to_move_;
+    const int forward = (us == PLAYER_ONE) ? BOARD_LENGTH : -BOARD_LENGTH;
+    Stats::increment(Stats::POSITION_MAKES);
+
+    undo.captured = NO_PIECE;
+    undo.castling_rights = castling_rights_;
+    undo.ep_square = ep_square_;
+    undo.halfmove_clock = halfmove_clock_;
+    undo.key = key_;
+    undo.pawn_key = pawn_key_;
+
+    setEnPassantSquare(NO_SQUARE);
+    halfmove_clock_++;
+
+    if (move.isEnPassant()) {
+        undo.captured = board_[to - forward];
+        removePiece(to - forward);
+    } else if (move.isCapture()) {
+        undo.captured = board_[to];
+        removePiece(to);
+    }
+
+    if (undo.captured != NO_PIECE || typeOf(board_[from]) == PAWN) { halfmove_clock_ = 0; }
+
+    movePiece(from, to);
+
+    if (move.isPromotion()) {
+        removePiece(to);
+        putPiece(to, makePiece(us, move.promotion()));
+    } else if (move.flags() == EngineMove::DOUBLE_PUSH) {
+        setEnPassantSquare(from + forward);
+    } else if (move.isCastle()) {
+        const Castling& castling = castlingOf(us, move);
+        movePiece(castling.rook_from, castling.rook_to);
+    }
+
+    const int rights = castling_rights_ & CASTLING_MASK[from] & CASTLING_MASK[to];
+    if (rights != castling_rights_) {
+        key_ ^= Zobrist::KEYS.castling[castling_rights_] ^ Zobrist::KEYS.castling[rights];
+        castling_rights_ = rights;
+    }
+
+    if (us == PLAYER_TWO) { fullmove_number_++; }
+    side_to_move_ = opponent(us);
+    key_ ^= Zobrist::KEYS.side;
+}
+
+/**
+ * @brief Takes back `move`, which must be the most recent move made on this position
+ */
+void Position::unmakeMove(EngineMove move, const UndoInfo& undo) {
+    const int from = move.from();
+    const int to = move.to();
+    const Side us = opponent(side_to_move_);
+    const int forward = (us == PLAYER_ONE) ? BOARD_LENGTH : -BOARD_LENGTH;
+    Stats::increment(Stats::POSITION_UNMAKES);
+
+    side_to_move_ = us;
+    if (us == PLAYER_TWO) { fullmove_number_--; }
+
+    if (move.isPromotion()) {
+        removePiece(to);
+        putPiece(to, makePiece(us, PAWN));
+    } else if (move.isCastle()) {
+        const Castling& castling = castlingOf(us, move);
+        movePiece(castling.rook_to, castling.rook_from);
+    }
+    movePiece(to, from);
+
+    if (move.isEnPassant()) {
+        putPiece(to - forward, undo.captured);
+    } else if (undo.captured != NO_PIECE) {
+        putPiece(to, undo.captured);
+    }
+
+    castling_rights_ = undo.castling_rights;
+    ep_square_ = undo.ep_square;
+    halfmove_clock_ = undo.halfmove_clock;
+    key_ = undo.key;
+    pawn_key_ = undo.pawn_key;
+}
+
+/**
+ * @brief Recomputes the key from scratch (used when building positions & to verify incremental updates)
+ */
+uint64_t Position::computeKey() const {
+    uint64_t key = 0;
+    for (int sq = 0; sq < SQUARE_COUNT; sq++) {
+        if (board_[sq] != NO_PIECE) { key ^= Zobrist::KEYS.piece_square[board_[sq]][sq]; }
+    }
+    if (ep_square_ != NO_SQUARE) { key ^= Zobrist::KEYS.en_passant_col[colOf(ep_square_)]; }
+    if (side_to_move_ == PLAYER_TWO) { key ^= Zobrist::KEYS.side; }
+    key ^= Zobrist::KEYS.castling[castling_rights_];
+    return key;
+}
+
+/**
+ * @brief Recomputes the pawn key from scratch (to verify incremental updates)
+ */
+uint64_t Position::computePawnKey() const {
+    uint64_t key = 0;
+    Bitboard pawns = by_type_[PAWN];
+    while (pawns) {
+        const int sq = popLsb(pawns);
+        key ^= Zobrist::KEYS.piece_square[board_[sq]][sq];
+    }
+    return key;
+}
@@ -0,0 +1,243 @@
+/**
+ * @class Position
+ * @brief A compact, copyable snapshot of a chess position used by the search engine.
+ *
+ * ChessBoard stores heap-allocated ChessPiece objects and string colors, which is
+ * convenient for interactive play but far too slow to search. A Position mirrors
+ * the same squares (square = row * 8 + col) with one Bitboard per piece type & side,
+ * plus a mailbox for O(1) "what is on this square" queries, and supports
+ * make / unmake of EngineMoves with an incrementally updated hash key.
+ *
+ * Castling rights are a 4-bit field of the position rather than "has moved" flags on
+ * pieces: every move masks them with CASTLING_MASK of its two squares, so they are
+ * hashed, restored by unmakeMove() & copied along with the rest of the position.
+ */
+
+#pragma once
+
+#include <array>
+#include <string>
+
+#include "Types.hpp"
+#include "Bitboard.hpp"
+#include "Zobrist.hpp"
+
+struct StandardGeometry;
+template <class Geometry> class BasicChessBoard;
+using ChessBoard = BasicChessBoard<StandardGeometry>;
+
+const int NO_SQUARE = -1;
+
+// Forsyth-Edwards Notation of the standard starting position (identical to a new ChessBoard)
+const std::string START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+/**
+ * @brief The squares of one castling move. Cols run from the h-file (col 0) to the a-file (col 7),
+ *        so kings start on col 3, king-side rooks on col 0 & queen-side rooks on col 7.
+ */
+struct Castling {
+    CastlingRight right;
+    int king_from, king_to;
+    int rook_from, rook_to;
+    Bitboard empty;     // Squares between the king & the rook, which must be empty
+    Bitboard safe;      // Squares the king starts on, crosses & lands on, which must not be attacked
+};
+
+constexpr Castling makeCastling(Side side, bool queen_side) {
+    const int row = (side == PLAYER_ONE) ? 0 : Bitboards::BOARD_LENGTH - 1;
+    const int king_from = Bitboards::square(row, 3);
+    const int king_to = Bitboards::square(row, queen_side ? 5 : 1);
+    const int rook_from = Bitboards::square(row, queen_side ? 7 : 0);
+    const int shift = 2 * side + queen_side;
+    return Castling{static_cast<CastlingRight>(PLAYER_ONE_KING_SIDE << shift),
+                    king_from, king_to, rook_from, Bitboards::square(row, queen_side ? 4 : 2),
+                    Bitboards::BETWEEN[king_from][rook_from],
+                    Bitboards::BETWEEN[king_from][king_to] | Bitboards::bit(king_from) | Bitboards::bit(king_to)};
+}
+
+// Indexed by side, then 0 for king side & 1 for queen side
+inline constexpr Castling CASTLINGS[2][2] = {
+    { makeCastling(PLAYER_ONE, false), makeCastling(PLAYER_ONE, true) },
+    { makeCastling(PLAYER_TWO, false), makeCastling(PLAYER_TWO, true) }
+};
+
+/**
+ * @return The castling of `side` that `move` (flagged KING_CASTLE or QUEEN_CASTLE) plays
+ */
+inline const Castling& castlingOf(Side side, EngineMove move) {
+    return CASTLINGS[side][move.flags() == EngineMove::QUEEN_CASTLE];
+}
+
+/**
+ * The castling rights kept when a piece moves from or to each square: a king or rook
+ * leaving its starting square, or a rook captured on it, loses the matching rights.
+ */
+constexpr std::array<int, Bitboards::SQUARE_COUNT> makeCastlingMask() {
+    std::array<int, Bitboards::SQUARE_COUNT> mask{};
+    for (int& rights : mask) { rights = ALL_CASTLING; }
+    for (const auto& side : CASTLINGS) {
+        for (const Castling& castling : side) {
+            mask[castling.king_from] &= ~(side[0].right | side[1].right);
+            mask[castling.rook_from] &= ~castling.right;
+        }
+    }
+    return mask;
+}
+
+inline constexpr std::array<int, Bitboards::SQUARE_COUNT> CASTLING_MASK = makeCastlingMask();
+
+/**
+ * @brief Everything makeMove() destroys that unmakeMove() needs to restore.
+ */
+struct UndoInfo {
+    Piece captured;
+    int castling_rights;
+    int ep_square;
+    int halfmove_clock;
+    uint64_t key;
+    uint64_t pawn_key;
+};
+
+class Position {
+    private:
+        Bitboard by_type_[6];   // Squares occupied by each piece type (both sides)
+        Bitboard by_side_[2];   // Squares occupied by each side
+        Piece board_[Bitboards::SQUARE_COUNT]; // Piece on each square, or NO_PIECE
+
+        Side side_to_move_;
+        int castling_rights_;   // CastlingRight bits still held by either side
+        int ep_square_;         // Square a pawn may capture onto en passant, or NO_SQUARE
+        int halfmove_clock_;    // Plies since the last capture or pawn move
+        int fullmove_number_;
+        uint64_t key_;          // Zobrist hash of the position
+        uint64_t pawn_key_;     // Zobrist hash of the pawns alone, keying pawn structure evaluations
+
+        void putPiece(int sq, Piece piece);
+        void removePiece(int sq);
+        void movePiece(int from, int to);
+
+    public:
+        /**
+         * @brief Default constructor.
+         * @post The position matches the setup of a freshly constructed ChessBoard:
+         *       Player One's pieces on rows 0-1, Player Two's on rows 6-7, Player One to move,
+         *       and both sides may castle either way.
+         */
+        Position();
+
+        /**
+         * @brief Builds a Position from the current state of a ChessBoard
+         * @param board The board to mirror, read from its piece lists. Pieces whose color matches
+         *        Player One's color belong to PLAYER_ONE, every other piece to PLAYER_TWO.
+         * @return A position with the same pieces on the same squares and the same side to move.
+         *         ChessBoard does not play castling, so neither side may castle.
+         */
+        static Position fromBoard(const ChessBoard& board);
+
+        /**
+         * @brief Replaces this position with the one described by a FEN string
+         *
+         * Uppercase pieces & "w" denote Player One (White). Files run from 'a' at col 7
+         * to 'h' at col 0, ranks from '1' at row 0 to '8' at row 7.
+         *
+         * @return True if the FEN was valid. Otherwise false, and the position is left unchanged.
+         */
+        bool setFromFen(const std::string& fen);
+
+        /**
+         * @return The FEN string describing this position
+         */
+        std::string toFen() const;
+
+        // =============== Setup ===============
+
+        /**
+         * @brief Removes every piece and resets the side to move, clocks & key
+         */
+        void clear();
+
+        /**
+         * @brief Places `piece` on `sq`, replacing whatever was there (NO_PIECE empties the square)
+         */
+        void setPiece(int sq, Piece piece);
+
+        void setSideToMove(Side side);
+        void setEnPassantSquare(int sq);
+
+        /**
+         * @brief Sets the CastlingRight bits held. A right is only kept if its king & rook
+         *        stand on their starting squares.
+         */
+        void setCastlingRights(int rights);
+
+        // =============== Queries ===============
+
+        Piece pieceAt(int sq) const { return board_[sq]; }
+        Side sideToMove() const { return side_to_move_; }
+        int castlingRights() const { return castling_rights_; }
+        int enPassantSquare() const { return ep_square_; }
+        int halfmoveClock() const { return halfmove_clock_; }
+        uint64_t key() const { return key_; }
+        uint64_t pawnKey() const { return pawn_key_; }
+
+        Bitboard occupied() const { return by_side_[PLAYER_ONE] | by_side_[PLAYER_TWO]; }
+        Bitboard pieces(Side side) const { return by_side_[side]; }
+        Bitboard pieces(PieceType type) const { return by_type_[type]; }
+        Bitboard pieces(Side side, PieceType type) const { return by_side_[side] & by_type_[type]; }
+
+        /**
+         * @return The square of `side`'s king, or NO_SQUARE if it has none
+         */
+        int kingSquare(Side side) const;
+
+        /**
+         * @brief Finds every piece (of either side) attacking `sq`, given the occupancy `occupied`
+         */
+        Bitboard attackersTo(int sq, Bitboard occupied) const;
+
+        /**
+         * @return True if any piece of side `by` attacks `sq`
+         */
+        bool isSquareAttacked(int sq, Side by) const;
+
+        /**
+         * @return True if the side to move is in check
+         */
+        bool inCheck() const;
+
+        /**
+         * @return True if the side that just moved left its own king attacked,
+         *         ie. the last pseudo-legal move made was illegal.
+         */
+        bool leftKingInCheck() const;
+
+        /**
+         * @return True if either side still has enough material to deliver mate
+         */
+        bool hasMatingMaterial() const;
+
+        // =============== Make / Unmake ===============
+
+        /**
+         * @brief Plays a pseudo-legal move
+         * @param move A move generated for this position
+         * @param undo Receives the information needed to take the move back
+         * @post The move is executed, the side to move flips and the key is updated incrementally
+         */
+        void makeMove(EngineMove move, UndoInfo& undo);
+
+        /**
+         * @brief Takes back `move`, which must be the most recent move made on this position
+         */
+        void unmakeMove(EngineMove move, const UndoInfo& undo);
+
+        /**
+         * @brief Recomputes the key from scratch (used when building positions & to verify incremental updates)
+         */
+        uint64_t computeKey() const;
+
+        /**
+         * @brief Recomputes the pawn key from scratch (to verify incremental updates)
+         */
+        uint64_t computePawnKey() const;
+};
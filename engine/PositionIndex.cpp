@@ -0,0 +1,316 @@
+#include "PositionIndex.hpp"
+#include "Zobrist.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <queue>
+
+using namespace Bitboards;
+
+namespace PositionIndex {
+    namespace {
+        /**
+         * @brief A run file of the index directory
+         */
+        struct RunFile {
+            int level;
+            uint64_t sequence;
+            std::string path;
+        };
+
+        uint64_t readLittleEndian(const uint8_t* data, int bytes) {
+            uint64_t value = 0;
+            for (int i = bytes - 1; i >= 0; i--) { value = (value << 8) | data[i]; }
+            return value;
+        }
+
+        void writeLittleEndian(std::ofstream& out, uint64_t value, int bytes) {
+            for (int i = 0; i < bytes; i++) { out.put(static_cast<char>((value >> (8 * i)) & 0xFF)); }
+        }
+
+        /**
+         * @return Entry `index` of the mapped run `run`
+         */
+        Entry entryAt(const MappedFile& run, uint64_t index) {
+            const uint8_t* data = run.data() + FILE_HEADER_SIZE + index * ENTRY_SIZE;
+            return Entry{readLittleEndian(data, 8), static_cast<uint32_t>(readLittleEndian(data + 8, 4)),
+                         static_cast<uint16_t>(readLittleEndian(data + 12, 2))};
+        }
+
+        uint64_t entryCount(const MappedFile& run) {
+            return (run.size() - FILE_HEADER_SIZE) / ENTRY_SIZE;
+        }
+
+        /**
+         * @return True if `run` is a complete run file
+         */
+        bool isValidRun(const MappedFile& run) {
+            if (run.size() < FILE_HEADER_SIZE || std::memcmp(run.data(), MAGIC, sizeof(MAGIC)) != 0) { return false; }
+            if (readLittleEndian(run.data() + 4, 4) != VERSION) { return false; }
+            return run.size() == FILE_HEADER_SIZE + readLittleEndian(run.data() + 8, 8) * ENTRY_SIZE;
+        }
+
+        /**
+         * @return Every run file of `directory`, oldest first
+         */
+        std::vector<RunFile> listRuns(const std::string& directory) {
+            std::vector<RunFile> runs;
+            DIR* dir = opendir(directory.c_str());
+            if (!dir) { return runs; }
+            while (dirent* entry = readdir(dir)) {
+                int level = 0;
+                unsigned long long sequence = 0;
+                char extension[8] = {};
+                if (std::sscanf(entry->d_name, "L%d-%llu%7s", &level, &sequence, extension) == 3
+                    && std::strcmp(extension, RUN_EXTENSION) == 0) {
+                    runs.push_back(RunFile{level, sequence, directory + "/" + entry->d_name});
+                }
+            }
+            closedir(dir);
+            std::sort(runs.begin(), runs.end(), [](const RunFile& a, const RunFile& b) { return a.sequence < b.sequence; });
+            return runs;
+        }
+
+        std::string runPath(const std::string& directory, int level, uint64_t sequence) {
+            return directory + "/L" + std::to_string(level) + "-" + std::to_string(sequence) + RUN_EXTENSION;
+        }
+
+        /**
+         * @brief Writes a run through a temporary file, so that a run file is always complete
+         * @param next Called until it returns false, to get the entries in sorted order
+         */
+        template <typename Next>
+        bool writeRun(const std::string& path, uint64_t count, Next next) {
+            const std::string temporary = path + ".tmp";
+            {
+                std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+                out.write(MAGIC, sizeof(MAGIC));
+                writeLittleEndian(out, VERSION, 4);
+                writeLittleEndian(out, count, 8);
+                Entry entry;
+                while (next(entry)) {
+                    writeLittleEndian(out, entry.key, 8);
+                    writeLittleEndian(out, entry.game, 4);
+                    writeLittleEndian(out, entry.ply, 2);
+                    writeLittleEndian(out, 0, 2);
+                }
+                if (!out) { return false; }
+            }
+            return std::rename(temporary.c_str(), path.c_str()) == 0;
+        }
+    }
+
+    /**
+     * @return The key a position is indexed by: its Zobrist key, ignoring en passant rights
+     *         so that transpositions through a double pawn push are found as well
+     */
+    uint64_t keyOf(const Position& position) {
+        const int ep_square = position.enPassantSquare();
+        if (ep_square == NO_SQUARE) { return position.key(); }
+        return position.key() ^ Zobrist::KEYS.en_passant_col[colOf(ep_square)];
+    }
+
+    // =============== Writer ===============
+
+    Writer::Writer(size_t buffer_entries) : buffer_limit_{std::max<size_t>(1, buffer_entries)}, games_{0}, database_{nullptr} {}
+
+    /**
+     * @brief Destructor. Flushes buffered entries.
+     */
+    Writer::~Writer() {
+        if (!directory_.empty()) { close(); }
+    }
+
+    /**
+     * @brief Opens the index of `database` in `directory` (which must exist), resuming after the games
+     *        already indexed. `database` must outlive the writer.
+     * @return True if the manifest, if any, could be read and its games are the first games of `database`
+     */
+    bool Writer::open(const std::string& directory, const GameDb::Database& database) {
+        directory_.clear();
+        buffer_.clear();
+        games_ = 0;
+
+        std::ifstream manifest(directory + "/" + MANIFEST_NAME);
+        uint64_t fingerprint = 0;
+        if (manifest && !(manifest >> games_ >> fingerprint)) { return false; }
+        if (games_ > database.size() || fingerprint != database.fingerprint(games_)) { return false; }
+        directory_ = directory;
+        database_ = &database;
+        return true;
+    }
+
+    /**
+     * @brief Indexes every position of `game`, the game of the database with id games()
+     * @return False if a run could not be written
+     */
+    bool Writer::add(const GameDb::Game& game) {
+        if (directory_.empty()) { return false; }
+        const uint32_t id = static_cast<uint32_t>(games_++);
+        Position position = game.startPosition();
+        UndoInfo undo;
+        buffer_.push_back(Entry{keyOf(position), id, 0});
+        for (size_t ply = 0; ply < game.moves.size(); ply++) {
+            position.makeMove(game.moves[ply], undo);
+            buffer_.push_back(Entry{keyOf(position), id, static_cast<uint16_t>(ply + 1)});
+        }
+        return buffer_.size() < buffer_limit_ || flush();
+    }
+
+    /**
+     * @brief Writes buffered entries & the manifest
+     * @return True if everything was written
+     */
+    bool Writer::close() {
+        if (directory_.empty()) { return false; }
+        const bool flushed = flush();
+        directory_.clear();
+        return flushed;
+    }
+
+    /**
+     * @brief Sorts & writes the buffer as a new level 0 run, then merges runs as needed
+     */
+    bool Writer::flush() {
+        if (!buffer_.empty()) {
+            std::sort(buffer_.begin(), buffer_.end());
+            std::vector<RunFile> runs = listRuns(directory_);
+            const uint64_t sequence = runs.empty() ? 0 : runs.back().sequence + 1;
+
+            size_t next = 0;
+            if (!writeRun(runPath(directory_, 0, sequence), buffer_.size(), [&](Entry& entry) {
+                    if (next == buffer_.size()) { return false; }
+                    entry = buffer_[next++];
+                    return true;
+                })) {
+                return false;
+            }
+            buffer_.clear();
+            if (!compact()) { return false; }
+        }
+
+        // Only now are all the games counted by the manifest on disk
+        const std::string manifest = directory_ + "/" + MANIFEST_NAME;
+        {
+            std::ofstream out(manifest + ".tmp", std::ios::trunc);
+            out << games_ << ' ' << database_->fingerprint(games_) << std::endl;
+            if (!out) { return false; }
+        }
+        return std::rename((manifest + ".tmp").c_str(), manifest.c_str()) == 0;
+    }
+
+    /**
+     * @brief Merges runs while any level holds FANOUT of them
+     */
+    bool Writer::compact() {
+        while (true) {
+            std::vector<RunFile> runs = listRuns(directory_);
+            std::vector<RunFile> inputs;
+            for (int level = 0; inputs.empty() && level < 64; level++) {
+                for (const RunFile& run : runs) {
+                    if (run.level == level) { inputs.push_back(run); }
+                }
+                if (inputs.size() < static_cast<size_t>(FANOUT)) { inputs.clear(); }
+            }
+            if (inputs.empty()) { return true; }
+
+            // K-way merge of the sorted inputs
+            std::vector<MappedFile> files(inputs.size());
+            uint64_t total = 0;
+            for (size_t i = 0; i < inputs.size(); i++) {
+                if (!files[i].open(inputs[i].path) || !isValidRun(files[i])) { return false; }
+                total += entryCount(files[i]);
+            }
+            typedef std::pair<Entry, size_t> Head; // Smallest unmerged entry of a run, and the run
+            auto later = [](const Head& a, const Head& b) { return b.first < a.first; };
+            std::priority_queue<Head, std::vector<Head>, decltype(later)> heads(later);
+            std::vector<uint64_t> positions(files.size(), 0);
+            for (size_t i = 0; i < files.size(); i++) {
+                if (entryCount(files[i])) { heads.push(Head{entryAt(files[i], 0), i}); }
+            }
+
+            const std::string output = runPath(directory_, inputs[0].level + 1, runs.back().sequence + 1);
+            const bool merged = writeRun(output, total, [&](Entry& entry) {
+                if (heads.empty()) { return false; }
+                const Head head = heads.top();
+                heads.pop();
+                entry = head.first;
+                const size_t run = head.second;
+                if (++positions[run] < entryCount(files[run])) { heads.push(Head{entryAt(files[run], positions[run]), run}); }
+                return true;
+            });
+            if (!merged) { return false; }
+
+            // A crash before every input is removed only leaves duplicates, which queries ignore
+            files.clear();
+            for (const RunFile& input : inputs) { std::remove(input.path.c_str()); }
+        }
+    }
+
+    // =============== Reader ===============
+
+    /**
+     * @brief Maps every run of `directory`
+     * @return True if every run file is valid
+     */
+    bool Reader::open(const std::string& directory) {
+        runs_.clear();
+        entries_ = 0;
+        for (const RunFile& run : listRuns(directory)) {
+            MappedFile file;
+            if (!file.open(run.path) || !isValidRun(file)) { return false; }
+            entries_ += entryCount(file);
+            runs_.push_back(std::move(file));
+        }
+        return true;
+    }
+
+    /**
+     * @brief Finds where `position` occurs, at most `limit` times
+     * @return The number of occurrences found, sorted by game & ply
+     */
+    size_t Reader::find(const Position& position, std::vector<Occurrence>& found, size_t limit) const {
+        found.clear();
+        if (limit == 0) { return 0; }
+        const uint64_t key = keyOf(position);
+
+        // Each run's entries for `key` are sorted by (game, ply): k-way merge them, so that only the
+        // first `limit` occurrences are ever read, however common the position is
+        typedef std::pair<Entry, size_t> Head; // Next unread entry of a run, and the run
+        auto later = [](const Head& a, const Head& b) { return b.first < a.first; };
+        std::priority_queue<Head, std::vector<Head>, decltype(later)> heads(later);
+        std::vector<uint64_t> positions(runs_.size(), 0);
+        for (size_t i = 0; i < runs_.size(); i++) {
+            uint64_t low = 0, high = entryCount(runs_[i]);
+            while (low < high) {
+                const uint64_t middle = low + (high - low) / 2;
+                if (readLittleEndian(runs_[i].data() + FILE_HEADER_SIZE + middle * ENTRY_SIZE, 8) < key) {
+                    low = middle + 1;
+                } else {
+                    high = middle;
+                }
+            }
+            positions[i] = low;
+            if (low < entryCount(runs_[i]) && entryAt(runs_[i], low).key == key) { heads.push(Head{entryAt(runs_[i], low), i}); }
+        }
+
+        while (!heads.empty() && found.size() < limit) {
+            const Head head = heads.top();
+            heads.pop();
+            const size_t run = head.second;
+            if (++positions[run] < entryCount(runs_[run])) {
+                const Entry next = entryAt(runs_[run], positions[run]);
+                if (next.key == key) { heads.push(Head{next, run}); }
+            }
+
+            // An interrupted merge leaves the same entry in two runs
+            const Occurrence occurrence{head.first.game, head.first.ply};
+            if (!found.empty() && found.back().game == occurrence.game && found.back().ply == occurrence.ply) { continue; }
+            found.push_back(occurrence);
+        }
+        return found.size();
+    }
+}
@@ -0,0 +1,157 @@
+/**
+ * @file PositionIndex.hpp
+ * @brief An on-disk index from positions to the games (and plies) where they occur.
+ *
+ * The index is a directory of sorted runs, organised like a log-structured merge tree:
+ *  - Games are replayed as they are added, and one (key, game, ply) entry is buffered per position.
+ *  - A full buffer is sorted and written out as a new run: a file of fixed-size entries
+ *    sorted by key, memory-mapped for searching.
+ *  - Whenever FANOUT runs of the same level exist, they are merged into one run of the next
+ *    level, so a directory of N entries holds O(FANOUT * log(N)) runs at most.
+ *
+ * A query binary-searches every run, so it touches a handful of pages per run whatever the
+ * size of the collection. A MANIFEST file records how many games are indexed so that an
+ * import can be resumed, and is only updated once the runs holding those games are complete.
+ * It also records the database's fingerprint of those games, so that an index is never resumed
+ * over a database that was recreated since: its game ids would point at other games.
+ *
+ * Run files: a 16-byte header (magic, version, number of entries), then 16 bytes per entry:
+ * key (8), game id (4), ply (2) & 2 bytes of padding, all little-endian.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Types.hpp"
+#include "Position.hpp"
+#include "MappedFile.hpp"
+#include "GameDatabase.hpp"
+
+namespace PositionIndex {
+    static const size_t FILE_HEADER_SIZE = 16;
+    static const size_t ENTRY_SIZE = 16;
+    static const uint32_t VERSION = 2;     // 2: position keys hash castling rights
+    static const char MAGIC[4] = {'P', '6', 'P', 'X'};
+    static const char* const RUN_EXTENSION = ".p6x";
+    static const char* const MANIFEST_NAME = "MANIFEST";
+    static const size_t DEFAULT_BUFFER_ENTRIES = 1 << 22; // 64 MB of entries
+    static const int FANOUT = 4;
+
+    /**
+     * @brief Where a position occurs
+     */
+    struct Occurrence {
+        uint32_t game;  // Game id in the game database
+        uint16_t ply;   // Number of moves played before reaching the position
+    };
+
+    struct Entry {
+        uint64_t key;
+        uint32_t game;
+        uint16_t ply;
+
+        bool operator<(const Entry& other) const {
+            if (key != other.key) { return key < other.key; }
+            if (game != other.game) { return game < other.game; }
+            return ply < other.ply;
+        }
+    };
+
+    /**
+     * @return The key a position is indexed by: its Zobrist key, ignoring en passant rights
+     *         so that transpositions through a double pawn push are found as well
+     */
+    uint64_t keyOf(const Position& position);
+
+    /**
+     * @class Writer
+     * @brief Adds games to an index directory, flushing & merging runs as it goes
+     */
+    class Writer {
+        private:
+            std::string directory_;
+            std::vector<Entry> buffer_;
+            size_t buffer_limit_;
+            uint64_t games_;    // Games indexed, including those still buffered
+            const GameDb::Database* database_;
+
+            /**
+             * @brief Sorts & writes the buffer as a new level 0 run, then merges runs as needed
+             */
+            bool flush();
+
+            /**
+             * @brief Merges runs while any level holds FANOUT of them
+             */
+            bool compact();
+
+        public:
+            explicit Writer(size_t buffer_entries = DEFAULT_BUFFER_ENTRIES);
+
+            /**
+             * @brief Destructor. Flushes buffered entries.
+             */
+            ~Writer();
+
+            /**
+             * @brief Opens the index of `database` in `directory` (which must exist), resuming after the games
+             *        already indexed. `database` must outlive the writer.
+             * @return True if the manifest, if any, could be read and its games are the first games of `database`
+             */
+            bool open(const std::string& directory, const GameDb::Database& database);
+
+            /**
+             * @return The number of games indexed, ie. the id the next game added must have
+             */
+            uint64_t games() const { return games_; }
+
+            /**
+             * @brief Indexes every position of `game`, the game of the database with id games()
+             * @return False if a run could not be written
+             */
+            bool add(const GameDb::Game& game);
+
+            /**
+             * @brief Writes buffered entries & the manifest
+             * @return True if everything was written
+             */
+            bool close();
+    };
+
+    /**
+     * @class Reader
+     * @brief Searches the runs of an index directory
+     */
+    class Reader {
+        private:
+            std::vector<MappedFile> runs_;
+            uint64_t entries_ = 0;
+
+        public:
+            /**
+             * @brief Maps every run of `directory`
+             * @return True if every run file is valid
+             */
+            bool open(const std::string& directory);
+
+            /**
+             * @return The number of runs
+             */
+            size_t runs() const { return runs_.size(); }
+
+            /**
+             * @return The number of entries over all runs
+             */
+            uint64_t entries() const { return entries_; }
+
+            /**
+             * @brief Finds where `position` occurs, at most `limit` times
+             * @return The number of occurrences found, sorted by game & ply
+             */
+            size_t find(const Position& position, std::vector<Occurrence>& found, size_t limit = SIZE_MAX) const;
+    };
+}
@@ -0,0 +1,271 @@
+#include "ReferenceCheck.hpp"
+#include "MovePicker.hpp"
+#include "Notation.hpp"
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+
+using namespace Bitboards;
+
+namespace ReferenceCheck {
+    namespace {
+        /**
+         * @return The moves of `moves` the reference can be asked about, as from * 64 + to in
+         *         increasing order (promotions to different pieces count once)
+         */
+        std::vector<int> comparable(const MoveList& moves) {
+            std::vector<int> pairs;
+            for (EngineMove move : moves) {
+                if (move.isCastle() || move.isEnPassant()) { continue; }
+                pairs.push_back(move.from() * SQUARE_COUNT + move.to());
+            }
+            std::sort(pairs.begin(), pairs.end());
+            pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+            return pairs;
+        }
+
+        /**
+         * @return The moves of `from` missing from `other`, in UCI notation
+         */
+        std::vector<std::string> difference(const std::vector<int>& from, const std::vector<int>& other) {
+            std::vector<int> missing;
+            std::set_difference(from.begin(), from.end(), other.begin(), other.end(), std::back_inserter(missing));
+            std::vector<std::string> text;
+            for (int pair : missing) { text.push_back(Notation::toUci(EngineMove(pair / SQUARE_COUNT, pair % SQUARE_COUNT))); }
+            return text;
+        }
+
+        /**
+         * @return True (and fills `report`) if a generator disagrees with the reference in `position`
+         */
+        bool findMismatch(const Position& position, const std::vector<Generator>& generators,
+                          const std::vector<EngineMove>& path, Report& report) {
+            report.positions++;
+            for (const Generator& generator : generators) {
+                if (comparePosition(position, generator, report.mismatch)) { continue; }
+                report.mismatch.path = path;
+                report.failed = true;
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * @return True if a disagreement was found in the tree `depth` plies deep below `position`
+         */
+        bool searchTree(Position& position, const std::vector<Generator>& generators, int depth,
+                        std::vector<EngineMove>& path, Report& report) {
+            if (findMismatch(position, generators, path, report)) { return true; }
+            if (depth == 0) { return false; }
+
+            MoveList moves;
+            MoveGen::generateLegal(position, moves);
+            UndoInfo undo;
+            for (EngineMove move : moves) {
+                position.makeMove(move, undo);
+                path.push_back(move);
+                const bool found = searchTree(position, generators, depth - 1, path, report);
+                path.pop_back();
+                position.unmakeMove(move, undo);
+                if (found) { return true; }
+            }
+            return false;
+        }
+    }
+
+    /**
+     * @return The engine's generators: "pseudo-legal" (MoveGen::generatePseudoLegal),
+     *         "staged" (every move a MovePicker hands out), "legal" (MoveGen::generateLegal)
+     *         & "move-rules" (the grid of the reference, asked MoveRules::canMove() instead)
+     */
+    std::vector<Generator> builtInGenerators() {
+        return {
+            {"pseudo-legal", false, MoveGen::generatePseudoLegal},
+            {"staged", false, [](const Position& position, MoveList& moves) {
+                const EngineMove no_killers[2] = {EngineMove(), EngineMove()};
+                MovePicker picker(position, EngineMove(), no_killers);
+                for (EngineMove move = picker.next(); !move.isNull(); move = picker.next()) { moves.push(move); }
+            }},
+            {"legal", true, MoveGen::generateLegal},
+            {"move-rules", false, [](const Position& position, MoveList& moves) {
+                Oracle rules(position, true);
+                for (int pair : rules.moves(false)) { moves.push(EngineMove(pair / SQUARE_COUNT, pair % SQUARE_COUNT)); }
+            }}
+        };
+    }
+
+    // =============== Oracle ===============
+
+    /**
+     * @brief Stands a ChessPiece on the grid for every piece of `position`. Pawns off their
+     *        starting row are flagged as moved, so that they may not double jump.
+     * @param use_move_rules Whether to ask MoveRules::canMove() rather than the pieces' own canMove()
+     */
+    Oracle::Oracle(const Position& position, bool use_move_rules)
+        : board_(BOARD_LENGTH, std::vector<ChessPiece*>(BOARD_LENGTH, nullptr)),
+          colors_{"BLACK", "WHITE"}, side_to_move_{position.sideToMove()}, use_move_rules_{use_move_rules} {
+        Bitboard occupied = position.occupied();
+        while (occupied) {
+            const int sq = popLsb(occupied);
+            const Piece piece = position.pieceAt(sq);
+            const Side side = sideOf(piece);
+            const std::string& color = colors_[side];
+            const int row = rowOf(sq);
+            const int col = colOf(sq);
+            const bool moving_up = side == PLAYER_ONE;
+
+            ChessPiece* placed = nullptr;
+            switch (typeOf(piece)) {
+                case PAWN:
+                    placed = &pawns_.emplace_back(color, row, col, moving_up);
+                    if (row != (moving_up ? 1 : BOARD_LENGTH - 2)) { placed->flagMoved(); }
+                    break;
+                case KNIGHT: placed = &knights_.emplace_back(color, row, col, moving_up); break;
+                case BISHOP: placed = &bishops_.emplace_back(color, row, col, moving_up); break;
+                case ROOK: placed = &rooks_.emplace_back(color, row, col, moving_up); break;
+                case QUEEN: placed = &queens_.emplace_back(color, row, col, moving_up); break;
+                default: placed = &kings_.emplace_back(color, row, col, moving_up); break;
+            }
+            board_[row][col] = placed;
+        }
+    }
+
+    /**
+     * @return True if `piece` can move to (`row`, `col`) of the grid
+     */
+    bool Oracle::canMove(const ChessPiece& piece, int row, int col) const {
+        return use_move_rules_ ? MoveRules::canMove(piece, row, col, board_) : piece.canMove(row, col, board_);
+    }
+
+    /**
+     * @return True if no piece of the side not to move can reach the king of the side to move
+     */
+    bool Oracle::kingSafe() const {
+        int king_row = -1, king_col = -1;
+        for (const King& king : kings_) {
+            if (king.getColor() == colors_[side_to_move_] && board_[king.getRow()][king.getColumn()] == &king) {
+                king_row = king.getRow();
+                king_col = king.getColumn();
+            }
+        }
+        if (king_row < 0) { return true; }
+
+        for (int row = 0; row < BOARD_LENGTH; row++) {
+            for (int col = 0; col < BOARD_LENGTH; col++) {
+                const ChessPiece* piece = board_[row][col];
+                if (piece && piece->getColor() != colors_[side_to_move_] && canMove(*piece, king_row, king_col)) { return false; }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Lists the moves of the side to move as from * 64 + to, in increasing order
+     * @param legal Whether to drop the moves after which the mover's king could be captured
+     */
+    std::vector<int> Oracle::moves(bool legal) {
+        std::vector<int> pairs;
+        for (int from = 0; from < SQUARE_COUNT; from++) {
+            ChessPiece* piece = board_[rowOf(from)][colOf(from)];
+            if (!piece || piece->getColor() != colors_[side_to_move_]) { continue; }
+
+            for (int to = 0; to < SQUARE_COUNT; to++) {
+                if (!canMove(*piece, rowOf(to), colOf(to))) { continue; }
+                if (legal) {
+                    // Play the move on the grid the way ChessBoard::move() does, test, then take it back
+                    ChessPiece* captured = board_[rowOf(to)][colOf(to)];
+                    board_[rowOf(to)][colOf(to)] = piece;
+                    board_[rowOf(from)][colOf(from)] = nullptr;
+                    piece->setRow(rowOf(to));
+                    piece->setColumn(colOf(to));
+                    const bool safe = kingSafe();
+                    piece->setRow(rowOf(from));
+                    piece->setColumn(colOf(from));
+                    board_[rowOf(from)][colOf(from)] = piece;
+                    board_[rowOf(to)][colOf(to)] = captured;
+                    if (!safe) { continue; }
+                }
+                pairs.push_back(from * SQUARE_COUNT + to);
+            }
+        }
+        return pairs;
+    }
+
+    // =============== Checks ===============
+
+    /**
+     * @return A human-readable description, with the moves in UCI notation
+     */
+    std::string Mismatch::toText() const {
+        std::ostringstream text;
+        text << "generator \"" << generator << "\" disagrees with the reference in " << fen << "\n";
+        text << "  reached by:";
+        if (path.empty()) { text << " (root)"; }
+        for (EngineMove move : path) { text << ' ' << Notation::toUci(move); }
+        text << "\n  missing (reference only):";
+        for (const std::string& move : missing) { text << ' ' << move; }
+        text << "\n  extra (generator only):";
+        for (const std::string& move : extra) { text << ' ' << move; }
+        text << "\n";
+        return text.str();
+    }
+
+    /**
+     * @return True if `generator` produces exactly the moves the reference allows in `position`.
+     *         Otherwise false, and `mismatch` holds the generator, FEN & differing moves.
+     */
+    bool comparePosition(const Position& position, const Generator& generator, Mismatch& mismatch) {
+        MoveList moves;
+        generator.generate(position, moves);
+        const std::vector<int> generated = comparable(moves);
+        const std::vector<int> expected = Oracle(position).moves(generator.legal);
+        if (generated == expected) { return true; }
+
+        mismatch.generator = generator.name;
+        mismatch.fen = position.toFen();
+        mismatch.missing = difference(expected, generated);
+        mismatch.extra = difference(generated, expected);
+        return false;
+    }
+
+    /**
+     * @brief Compares every generator at every position of `games` random games from `root`,
+     *        of up to `max_plies` plies each, until the first disagreement
+     * @param seed Seeds the choice of moves, so that a failing run can be replayed
+     */
+    Report checkPlayouts(const Position& root, const std::vector<Generator>& generators, uint64_t games,
+                         int max_plies, uint64_t seed) {
+        Report report;
+        std::mt19937_64 rng(seed);
+        std::vector<EngineMove> path;
+        for (uint64_t game = 0; game < games; game++) {
+            Position position = root;
+            path.clear();
+            UndoInfo undo;
+            for (int ply = 0; ply <= max_plies; ply++) {
+                if (findMismatch(position, generators, path, report)) { return report; }
+
+                MoveList moves;
+                MoveGen::generateLegal(position, moves);
+                if (moves.empty() || ply == max_plies) { break; }
+                const EngineMove move = moves[static_cast<int>(rng() % static_cast<uint64_t>(moves.size()))];
+                position.makeMove(move, undo);
+                path.push_back(move);
+            }
+        }
+        return report;
+    }
+
+    /**
+     * @brief Compares every generator at every node of the legal move tree `depth` plies
+     *        deep below `root`, until the first disagreement
+     */
+    Report checkPerft(const Position& root, const std::vector<Generator>& generators, int depth) {
+        Report report;
+        Position position = root;
+        std::vector<EngineMove> path;
+        searchTree(position, generators, depth, path, report);
+        return report;
+    }
+}
@@ -0,0 +1,138 @@
+/**
+ * @file ReferenceCheck.hpp
+ * @brief Differential testing of the engine's move generators against ChessPiece::canMove().
+ *
+ * The virtual canMove() of each ChessPiece is slow but simple, which makes it a good
+ * reference. It is written independently of MoveRules::canMove(), the fast path ChessBoard
+ * takes, which is checked against it like any other generator ("move-rules"): an Oracle stands real ChessPiece objects on a ChessBoard-style grid and asks
+ * each of them where it can go. Any fast generator (bitboards, staged generation, legal
+ * generation from check & pin masks, ...) is then run side by side with it, over random
+ * playouts or every node of a perft tree, until the first position where they disagree.
+ *
+ * The reference only knows the moves ChessBoard plays: it has no castling or en passant,
+ * so those moves are left out of the comparison, and promotions are compared by their
+ * origin & destination only.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Types.hpp"
+#include "Position.hpp"
+#include "MoveGen.hpp"
+#include "../pieces_module.hpp"
+
+namespace ReferenceCheck {
+    /**
+     * @brief A move generator under test
+     */
+    struct Generator {
+        std::string name;
+        bool legal;  // Whether it only emits legal moves. Otherwise its moves may leave the king attacked.
+        std::function<void(const Position&, MoveList&)> generate;
+    };
+
+    /**
+     * @return The engine's generators: "pseudo-legal" (MoveGen::generatePseudoLegal),
+     *         "staged" (every move a MovePicker hands out), "legal" (MoveGen::generateLegal)
+     *         & "move-rules" (the grid of the reference, asked MoveRules::canMove() instead)
+     */
+    std::vector<Generator> builtInGenerators();
+
+    /**
+     * @class Oracle
+     * @brief The reference move generator: one ChessPiece per piece of a Position, asked its own canMove()
+     */
+    class Oracle {
+        private:
+            static const int BOARD_LENGTH = Bitboards::BOARD_LENGTH;
+
+            std::deque<Pawn> pawns_;
+            std::deque<Knight> knights_;
+            std::deque<Bishop> bishops_;
+            std::deque<Rook> rooks_;
+            std::deque<Queen> queens_;
+            std::deque<King> kings_;
+            std::vector<std::vector<ChessPiece*>> board_;
+            std::string colors_[2];
+            Side side_to_move_;
+            bool use_move_rules_; // Ask MoveRules::canMove() instead of the pieces' canMove()
+
+            /**
+             * @return True if `piece` can move to (`row`, `col`) of the grid
+             */
+            bool canMove(const ChessPiece& piece, int row, int col) const;
+
+            /**
+             * @return True if no piece of the side not to move can reach the king of the side to move
+             */
+            bool kingSafe() const;
+
+        public:
+            /**
+             * @brief Stands a ChessPiece on the grid for every piece of `position`. Pawns off their
+             *        starting row are flagged as moved, so that they may not double jump.
+             * @param use_move_rules Whether to ask MoveRules::canMove() rather than the pieces' own canMove()
+             */
+            explicit Oracle(const Position& position, bool use_move_rules = false);
+
+            Oracle(const Oracle&) = delete;
+            Oracle& operator=(const Oracle&) = delete;
+
+            /**
+             * @brief Lists the moves of the side to move as from * 64 + to, in increasing order
+             * @param legal Whether to drop the moves after which the mover's king could be captured
+             */
+            std::vector<int> moves(bool legal);
+    };
+
+    /**
+     * @brief The first position where a generator & the reference disagree
+     */
+    struct Mismatch {
+        std::string generator;
+        std::string fen;
+        std::vector<EngineMove> path;      // The moves from the checked root leading to the position
+        std::vector<std::string> missing;  // Moves of the reference the generator did not produce
+        std::vector<std::string> extra;    // Moves of the generator the reference does not allow
+
+        /**
+         * @return A human-readable description, with the moves in UCI notation
+         */
+        std::string toText() const;
+    };
+
+    /**
+     * @brief The outcome of a check
+     */
+    struct Report {
+        uint64_t positions = 0;  // Positions compared, up to & including the mismatch if any
+        bool failed = false;
+        Mismatch mismatch;       // Set if failed
+    };
+
+    /**
+     * @return True if `generator` produces exactly the moves the reference allows in `position`.
+     *         Otherwise false, and `mismatch` holds the generator, FEN & differing moves.
+     */
+    bool comparePosition(const Position& position, const Generator& generator, Mismatch& mismatch);
+
+    /**
+     * @brief Compares every generator at every position of `games` random games from `root`,
+     *        of up to `max_plies` plies each, until the first disagreement
+     * @param seed Seeds the choice of moves, so that a failing run can be replayed
+     */
+    Report checkPlayouts(const Position& root, const std::vector<Generator>& generators, uint64_t games,
+                         int max_plies, uint64_t seed);
+
+    /**
+     * @brief Compares every generator at every node of the legal move tree `depth` plies
+     *        deep below `root`, until the first disagreement
+     */
+    Report checkPerft(const Position& root, const std::vector<Generator>& generators, int depth);
+};
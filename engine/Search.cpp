@@ -0,0 +1,438 @@
+#include "Search.hpp"
+#include "Evaluation.hpp"
+#include "MovePicker.hpp"
+#include "Stats.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+/**
+ * @brief Parameterized constructor.
+ * @param table The transposition table to use. Several searchers may share one.
+ *        A table of TranspositionTable::DEFAULT_SIZE_MB is allocated if none is given.
+ */
+Searcher::Searcher(std::shared_ptr<TranspositionTable> table)
+    : table_{table ? table : std::make_shared<TranspositionTable>()}, nodes_{0}, stopped_{false},
+      stop_requested_{false}, ponder_hit_{false}, pondering_{false}, quiescence_checks_{true}, pv_length_{} {}
+
+std::shared_ptr<TranspositionTable> Searcher::table() const {
+    return table_;
+}
+
+TimeManager& Searcher::timeManager() {
+    return time_;
+}
+
+/**
+ * @brief Enables / disables quiet checking moves at the first ply of quiescence
+ */
+void Searcher::setQuiescenceChecks(bool enabled) {
+    quiescence_checks_ = enabled;
+}
+
+/**
+ * @brief Sets the keys of the positions the game went through before the position
+ *        searched next, oldest first. A position repeated from them scores as a draw.
+ */
+void Searcher::setHistory(std::vector<uint64_t> keys) {
+    history_ = std::move(keys);
+}
+
+/**
+ * @brief Sets the network evaluating positions (nullptr: the hand-crafted evaluation)
+ */
+void Searcher::setNetwork(std::shared_ptr<const Nnue::Network> network) {
+    network_ = network;
+    accumulators_.resize(network_ ? MAX_PLY : 0);
+}
+
+/**
+ * @brief Sets the endgame tables probed below the root (nullptr: none).
+ *        Positions they cover are scored exactly instead of being searched.
+ */
+void Searcher::setTablebases(std::shared_ptr<const Tablebase::Tablebases> tablebases) {
+    tablebases_ = tablebases;
+}
+
+/**
+ * @brief Asks the running search to return as soon as possible (callable from any thread).
+ *        If no search is running, the request applies to the next one.
+ */
+void Searcher::stop() {
+    stop_requested_.store(true, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Tells a pondering search that the opponent played the expected move (callable from any thread).
+ *        The search carries on as a normal search, with its limits counted from now.
+ *        If no search is running, the request applies to the next one.
+ */
+void Searcher::ponderhit() {
+    ponder_hit_.store(true, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Drops pending stop() / ponderhit() requests. Only call while no search is running.
+ */
+void Searcher::resetRequests() {
+    stop_requested_.store(false, std::memory_order_relaxed);
+    ponder_hit_.store(false, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Registers a function called with the result of every completed iteration
+ */
+void Searcher::setIterationCallback(std::function<void(const SearchResult&)> callback) {
+    on_iteration_ = std::move(callback);
+}
+
+/**
+ * @brief Registers a function called on the search thread whenever the search polls
+ *        its limits (every TimeManager::NODES_PER_POLL nodes), eg. to check for input
+ */
+void Searcher::setPollCallback(std::function<void()> callback) {
+    on_poll_ = std::move(callback);
+}
+
+/**
+ * @return The number of nodes visited by the last search
+ */
+uint64_t Searcher::nodes() const {
+    return nodes_;
+}
+
+/**
+ * @brief Searches `position` to a fixed depth, without any time limit
+ */
+SearchResult Searcher::search(Position& position, int depth) {
+    SearchLimits limits;
+    limits.depth = depth;
+    return search(position, limits);
+}
+
+/**
+ * @brief Searches `position` by iterative deepening until one of `limits` is reached
+ * @param position The position to search. It is restored before returning.
+ * @return The result of the last completed iteration: the best move (null if there are
+ *         no legal moves), its score & principal variation
+ */
+SearchResult Searcher::search(Position& position, const SearchLimits& limits) {
+    limits_ = limits;
+    pondering_ = limits.ponder;
+
+    // While pondering no limit applies: the clock only starts on ponderhit()
+    SearchLimits clock_limits = limits;
+    clock_limits.infinite |= pondering_;
+    time_.start(clock_limits);
+
+    table_->newSearch();
+    nodes_ = 0;
+    stopped_ = false;
+    for (auto& killers : killers_) { killers[0] = killers[1] = EngineMove(); }
+    if (network_) { network_->refresh(position, accumulators_[0]); }
+
+    SearchResult result{EngineMove(), 0, 0, 0, 0, {}, {}};
+    const int max_depth = std::max(1, std::min(limits.depth, MAX_PLY - 1));
+    const int line_count = std::max(1, limits.multi_pv);
+    int stable_iterations = 0;
+    std::vector<PvLine> lines;
+
+    for (int depth = 1; depth <= max_depth; depth++) {
+        searchLines(position, depth, line_count, lines);
+
+        // An interrupted iteration is unreliable, except that the first one must produce a move
+        if (stopped_ && depth > 1) { break; }
+
+        const int score = lines[0].score;
+        EngineMove best_move = lines[0].pv.empty() ? EngineMove() : lines[0].pv[0];
+        stable_iterations = (best_move == result.best_move) ? stable_iterations + 1 : 0;
+
+        result.best_move = best_move;
+        result.score = score;
+        result.depth = depth;
+        result.pv = lines[0].pv;
+        result.lines = lines;
+        result.nodes = nodes_;
+        result.time_ms = time_.elapsedMs();
+        if (on_iteration_) { on_iteration_(result); }
+
+        if (stopped_ || best_move.isNull()) { break; }
+        // Nothing more to find once a forced mate is proven, unless asked to search until stopped
+        if (!limits.infinite && !pondering_ && std::abs(score) >= MATE_BOUND) { break; }
+        if (time_.shouldStop(stable_iterations)) { break; }
+    }
+
+    // Requests made during this search are used up
+    resetRequests();
+    pondering_ = false;
+
+    result.nodes = nodes_;
+    result.time_ms = time_.elapsedMs();
+    return result;
+}
+
+/**
+ * @brief Searches the root `count` times to `depth`, each time without the root moves of the lines found before
+ * @param lines Receives the lines found, best first: fewer than `count` if there are fewer legal
+ *        moves, or if the search is stopped (then only the first line may be incomplete)
+ */
+void Searcher::searchLines(Position& position, int depth, int count, std::vector<PvLine>& lines) {
+    lines.clear();
+    root_exclusions_.clear();
+    for (int line = 0; line < count; line++) {
+        const int score = negamax(position, depth, -INFINITE_SCORE, INFINITE_SCORE, 0);
+
+        // The first line is kept even if interrupted or empty (no legal move), so that there always is a result
+        if (line > 0 && (stopped_ || pv_length_[0] == 0)) { break; }
+        lines.push_back({score, std::vector<EngineMove>(pv_[0], pv_[0] + pv_length_[0])});
+        if (stopped_ || pv_length_[0] == 0) { break; }
+        root_exclusions_.push_back(pv_[0][0]);
+    }
+    root_exclusions_.clear();
+
+    // Later lines replay the table's results, which may come out above an earlier line's score
+    std::stable_sort(lines.begin(), lines.end(), [](const PvLine& a, const PvLine& b) { return a.score > b.score; });
+}
+
+/**
+ * @brief Polls the clock (every TimeManager::NODES_PER_POLL nodes) & the node limit
+ * @post stopped_ is set if the search must end now
+ */
+void Searcher::checkLimits() {
+    if (limits_.nodes && nodes_ >= limits_.nodes && !pondering_) { stopped_ = true; }
+    if ((nodes_ & (TimeManager::NODES_PER_POLL - 1)) == 0) {
+        if (on_poll_) { on_poll_(); }
+        if (time_.hardLimitReached()) { stopped_ = true; }
+    }
+    if (stop_requested_.load(std::memory_order_relaxed)) { stopped_ = true; }
+
+    // The opponent played the expected move: from now on this is a normal search
+    if (pondering_ && ponder_hit_.load(std::memory_order_relaxed)) {
+        pondering_ = false;
+        time_.start(limits_);
+    }
+}
+
+void Searcher::updatePv(int ply, EngineMove move) {
+    pv_[ply][ply] = move;
+    for (int i = ply + 1; i < pv_length_[ply + 1]; i++) { pv_[ply][i] = pv_[ply + 1][i]; }
+    pv_length_[ply] = std::max(pv_length_[ply + 1], ply + 1);
+}
+
+/**
+ * @brief Plays `move` from the position at `ply`, noting what it changes for the network
+ */
+void Searcher::makeMove(Position& position, EngineMove move, UndoInfo& undo, int ply) {
+    if (network_) {
+        dirty_[ply + 1] = Nnue::dirtyPieces(position, move);
+        accumulators_[ply + 1].computed[PLAYER_ONE] = false;
+        accumulators_[ply + 1].computed[PLAYER_TWO] = false;
+    }
+    position.makeMove(move, undo);
+}
+
+/**
+ * @brief Evaluates the position at `ply` with the network if one is set, else statically
+ *
+ * Each side of the accumulator is brought up to date from the closest computed one on the
+ * search path, unless that side's king moved in between: then only that side is computed from scratch.
+ */
+int Searcher::evaluate(const Position& position, int ply) {
+    if (!network_) { return Evaluation::evaluate(position, &pawn_table_); }
+
+    for (Side side : {PLAYER_ONE, PLAYER_TWO}) {
+        int base = ply;
+        while (!accumulators_[base].computed[side] && base > 0 && !dirty_[base].king_moved[side]) { base--; }
+        if (!accumulators_[base].computed[side]) {
+            network_->refresh(position, accumulators_[ply], side);
+            continue;
+        }
+        const int king_square = position.kingSquare(side);
+        for (int i = base + 1; i <= ply; i++) { network_->update(accumulators_[i - 1], accumulators_[i], dirty_[i], side, king_square); }
+    }
+
+    // The network's score must not be mistaken for a mate score
+    const int score = network_->evaluate(position, accumulators_[ply]);
+    return std::min(std::max(score, -MATE_BOUND + 1), MATE_BOUND - 1);
+}
+
+/**
+ * @return True if the position at `ply` already occurred since the last irreversible
+ *         move, on the search path or in the game history
+ */
+bool Searcher::isRepetition(const Position& position, int ply) const {
+    const int64_t history_size = static_cast<int64_t>(history_.size());
+    for (int distance = 4; distance <= position.halfmoveClock(); distance += 2) {
+        const int64_t index = ply - distance;
+        if (index < -history_size) { return false; }
+        const uint64_t key = index >= 0 ? key_stack_[index] : history_[history_size + index];
+        if (key == position.key()) { return true; }
+    }
+    return false;
+}
+
+/**
+ * @brief Remembers `move`, a quiet move that caused a cutoff at `ply`, as a killer of that ply
+ */
+void Searcher::storeKiller(EngineMove move, int ply) {
+    if (killers_[ply][0] == move) { return; }
+    killers_[ply][1] = killers_[ply][0];
+    killers_[ply][0] = move;
+}
+
+/**
+ * @brief Full-width negamax alpha-beta search to `depth`, falling into quiescence at the horizon
+ * @return The score of the position for the side to move, within [alpha, beta] bounds semantics (fail-soft)
+ */
+int Searcher::negamax(Position& position, int depth, int alpha, int beta, int ply) {
+    pv_length_[ply] = ply;
+    if (depth <= 0 || ply >= MAX_PLY - 1) { return quiescence(position, alpha, beta, ply, 0); }
+
+    nodes_++;
+    Stats::increment(Stats::NODES);
+    checkLimits();
+    if (stopped_) { return 0; }
+    key_stack_[ply] = position.key();
+    if (ply > 0 && (position.halfmoveClock() >= 100 || !position.hasMatingMaterial() || isRepetition(position, ply))) { return 0; }
+
+    // A tablebase knows the exact distance to mate: no need to search further
+    Tablebase::ProbeResult tb_result;
+    if (ply > 0 && tablebases_ && Bitboards::popCount(position.occupied()) <= tablebases_->maxPieces()
+        && tablebases_->probe(position, tb_result)) {
+        if (tb_result.wdl == 0) { return 0; }
+        const int mate_score = MATE_SCORE - ply - tb_result.plies;
+        return tb_result.wdl > 0 ? mate_score : -mate_score;
+    }
+
+    // A deep enough stored result for this position may settle it without searching
+    const int original_alpha = alpha;
+    EngineMove hash_move;
+    TTEntry entry;
+    if (table_->probe(position.key(), entry)) {
+        hash_move = EngineMove::fromBits(entry.move);
+        int tt_score = TranspositionTable::scoreFromTable(entry.score, ply);
+        if (ply > 0 && entry.depth >= depth) {
+            if (entry.bound == BOUND_EXACT) { return tt_score; }
+            if (entry.bound == BOUND_LOWER && tt_score >= beta) { return tt_score; }
+            if (entry.bound == BOUND_UPPER && tt_score <= alpha) { return tt_score; }
+        }
+    }
+
+    MovePicker picker(position, hash_move, killers_[ply]);
+    EngineMove best_move;
+    int best_score = -INFINITE_SCORE;
+    int legal_moves = 0;
+    UndoInfo undo;
+    for (EngineMove move = picker.next(); !move.isNull(); move = picker.next()) {
+        if (ply == 0 && std::find(root_exclusions_.begin(), root_exclusions_.end(), move) != root_exclusions_.end()) { continue; }
+        makeMove(position, move, undo, ply);
+        if (position.leftKingInCheck()) {
+            position.unmakeMove(move, undo);
+            continue;
+        }
+        legal_moves++;
+        int score = -negamax(position, depth - 1, -beta, -alpha, ply + 1);
+        position.unmakeMove(move, undo);
+        if (stopped_) { return 0; }
+
+        if (score > best_score) {
+            best_score = score;
+            best_move = move;
+            if (score > alpha) {
+                alpha = score;
+                updatePv(ply, move);
+                if (alpha >= beta) {
+                    Stats::increment(Stats::CUTOFFS);
+                    if (legal_moves == 1) { Stats::increment(Stats::FIRST_MOVE_CUTOFFS); }
+                    if (!move.isCapture() && !move.isPromotion()) { storeKiller(move, ply); }
+                    break;
+                }
+            }
+        }
+    }
+
+    // Checkmate or stalemate
+    if (legal_moves == 0) { return position.inCheck() ? -MATE_SCORE + ply : 0; }
+
+    // A root searched without some of its moves has no score of its own to store
+    if (ply > 0 || root_exclusions_.empty()) {
+        Bound bound = (best_score >= beta) ? BOUND_LOWER : (best_score > original_alpha) ? BOUND_EXACT : BOUND_UPPER;
+        table_->store(position.key(), best_move, best_score, depth, bound, ply);
+    }
+    return best_score;
+}
+
+/**
+ * @brief Searches captures only until the position is quiet
+ *
+ * Unless in check, the side to move may "stand pat" on the static evaluation,
+ * since it is never forced to capture. Captures whose victim cannot lift the
+ * stand-pat score to within DELTA_MARGIN of alpha are pruned (delta pruning).
+ * When in check, every evasion is searched instead.
+ *
+ * @param q_ply How many plies deep into quiescence this node is
+ */
+int Searcher::quiescence(Position& position, int alpha, int beta, int ply, int q_ply) {
+    nodes_++;
+    Stats::increment(Stats::NODES);
+    checkLimits();
+    if (stopped_) { return 0; }
+    pv_length_[ply] = ply;
+    if (ply >= MAX_PLY - 1) { return evaluate(position, ply); }
+
+    const bool in_check = position.inCheck();
+    int best_score = -INFINITE_SCORE;
+    int stand_pat = 0;
+
+    if (!in_check) {
+        stand_pat = evaluate(position, ply);
+        if (stand_pat >= beta) { return stand_pat; }
+
+        // Even winning a queen for free would not reach alpha: nothing here can help,
+        // unless a pawn is about to promote
+        const Side us = position.sideToMove();
+        const Bitboard about_to_promote = (us == PLAYER_ONE) ? (Bitboards::ROW_0 << 48) : (Bitboards::ROW_0 << 8);
+        if (stand_pat + Evaluation::pieceValue(QUEEN) + DELTA_MARGIN < alpha && !(position.pieces(us, PAWN) & about_to_promote)) {
+            return stand_pat;
+        }
+
+        best_score = stand_pat;
+        alpha = std::max(alpha, stand_pat);
+    }
+
+    // When in check every evasion is searched: the main search's picker, without hash move or killers
+    const EngineMove no_killers[2] = {EngineMove(), EngineMove()};
+    MovePicker picker = in_check ? MovePicker(position, EngineMove(), no_killers)
+                                 : MovePicker(position, q_ply == 0 && quiescence_checks_);
+    int legal_moves = 0;
+    UndoInfo undo;
+    for (EngineMove move = picker.next(); !move.isNull(); move = picker.next()) {
+        // Delta pruning: skip captures that cannot raise the score near alpha
+        if (!in_check && move.isCapture() && !move.isPromotion()) {
+            PieceType victim = move.isEnPassant() ? PAWN : typeOf(position.pieceAt(move.to()));
+            if (stand_pat + Evaluation::pieceValue(victim) + DELTA_MARGIN <= alpha) { continue; }
+        }
+
+        makeMove(position, move, undo, ply);
+        if (position.leftKingInCheck()) {
+            position.unmakeMove(move, undo);
+            continue;
+        }
+        legal_moves++;
+        int score = -quiescence(position, -beta, -alpha, ply + 1, q_ply + 1);
+        position.unmakeMove(move, undo);
+        if (stopped_) { return 0; }
+
+        if (score > best_score) {
+            best_score = score;
+            if (score > alpha) {
+                alpha = score;
+                updatePv(ply, move);
+                if (alpha >= beta) { break; }
+            }
+        }
+    }
+
+    if (in_check && legal_moves == 0) { return -MATE_SCORE + ply; }
+    return best_score;
+}
@@ -0,0 +1,237 @@
+/**
+ * @class Searcher
+ * @brief Iterative deepening alpha-beta (negamax) search over a Position, with a
+ *        capture-only quiescence search at the leaves.
+ *
+ * The search deepens one ply at a time until the TimeManager says the budget is spent.
+ * Each iteration stores its results in the transposition table, so the next iteration
+ * searches the previous best moves first and loses little to the repeated work.
+ *
+ * A fixed-depth search that stops dead at its horizon misjudges any position in the
+ * middle of an exchange. Instead of evaluating such leaves, the quiescence search keeps
+ * resolving captures (and, optionally, quiet checks on its first ply) until the position
+ * is quiet. It only ever generates captures straight from the attack masks, since most
+ * quiescence nodes never need a quiet move.
+ *
+ * With SearchLimits::multi_pv > 1, each iteration searches the root once per line: every
+ * search after the first excludes the root moves of the lines already found, so the N
+ * searches find the N best moves in turn. They share the transposition table, so all but
+ * the first line mostly replay stored results & cost a fraction of a full search.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Types.hpp"
+#include "Position.hpp"
+#include "MoveGen.hpp"
+#include "TimeManager.hpp"
+#include "TranspositionTable.hpp"
+#include "Tablebase.hpp"
+#include "Nnue.hpp"
+#include "Evaluation.hpp"
+
+/**
+ * @brief One line of a MultiPV search: a root move's score & principal variation
+ */
+struct PvLine {
+    int score;
+    std::vector<EngineMove> pv;
+};
+
+/**
+ * @brief The outcome of a search: the best move found, its score & principal variation
+ */
+struct SearchResult {
+    EngineMove best_move;
+    int score;
+    int depth;
+    uint64_t nodes;
+    int64_t time_ms;
+    std::vector<EngineMove> pv;
+    std::vector<PvLine> lines; // The best SearchLimits::multi_pv lines, best first: lines[0] is score & pv
+};
+
+class Searcher {
+    public:
+        // Captures that cannot bring the score within this margin of alpha are skipped
+        static const int DELTA_MARGIN = 200;
+
+    private:
+        std::shared_ptr<TranspositionTable> table_;
+        std::shared_ptr<const Tablebase::Tablebases> tablebases_; // Endgame tables, if any
+        std::shared_ptr<const Nnue::Network> network_;            // Evaluates positions, if set
+        Evaluation::PawnTable pawn_table_;                        // This searcher's pawn structure cache
+        TimeManager time_;
+        SearchLimits limits_;
+
+        uint64_t nodes_;
+        bool stopped_;           // Set once a limit is hit: the current iteration is abandoned
+        std::atomic<bool> stop_requested_; // Set by stop(), possibly from another thread
+        std::atomic<bool> ponder_hit_;     // Set by ponderhit(), possibly from another thread
+        bool pondering_;                   // Searching on the opponent's time: no limit applies yet
+
+        std::function<void(const SearchResult&)> on_iteration_;
+        std::function<void()> on_poll_;
+        bool quiescence_checks_; // Whether the first quiescence ply also tries quiet checking moves
+
+        std::vector<uint64_t> history_;  // Keys of the game's positions before the root, oldest first
+        uint64_t key_stack_[MAX_PLY];    // Keys of the positions on the current search path
+        EngineMove killers_[MAX_PLY][2]; // Quiet moves that last caused cutoffs at each ply
+
+        // NNUE accumulators of the positions on the search path, computed lazily, & the
+        // pieces the move into each of them changed
+        std::vector<Nnue::Accumulator> accumulators_;
+        Nnue::DirtyPieces dirty_[MAX_PLY];
+
+        std::vector<EngineMove> root_exclusions_; // Root moves of the MultiPV lines already found this iteration
+
+        // Triangular principal variation table
+        EngineMove pv_[MAX_PLY][MAX_PLY];
+        int pv_length_[MAX_PLY];
+
+        /**
+         * @brief Full-width negamax alpha-beta search to `depth`, falling into quiescence at the horizon
+         * @return The score of the position for the side to move, within [alpha, beta] bounds semantics (fail-soft)
+         */
+        int negamax(Position& position, int depth, int alpha, int beta, int ply);
+
+        /**
+         * @brief Searches captures only until the position is quiet
+         *
+         * Unless in check, the side to move may "stand pat" on the static evaluation,
+         * since it is never forced to capture. Captures whose victim cannot lift the
+         * stand-pat score to within DELTA_MARGIN of alpha are pruned (delta pruning).
+         * When in check, every evasion is searched instead.
+         *
+         * @param q_ply How many plies deep into quiescence this node is
+         */
+        int quiescence(Position& position, int alpha, int beta, int ply, int q_ply);
+
+        /**
+         * @brief Remembers `move`, a quiet move that caused a cutoff at `ply`, as a killer of that ply
+         */
+        void storeKiller(EngineMove move, int ply);
+
+        void updatePv(int ply, EngineMove move);
+
+        /**
+         * @brief Plays `move` from the position at `ply`, noting what it changes for the network
+         */
+        void makeMove(Position& position, EngineMove move, UndoInfo& undo, int ply);
+
+        /**
+         * @brief Evaluates the position at `ply` with the network if one is set, else statically
+         */
+        int evaluate(const Position& position, int ply);
+
+        /**
+         * @return True if the position at `ply` already occurred since the last irreversible
+         *         move, on the search path or in the game history
+         */
+        bool isRepetition(const Position& position, int ply) const;
+
+        /**
+         * @brief Searches the root `count` times to `depth`, each time without the root moves of the lines found before
+         * @param lines Receives the lines found, best first: fewer than `count` if there are fewer legal
+         *        moves, or if the search is stopped (then only the first line may be incomplete)
+         */
+        void searchLines(Position& position, int depth, int count, std::vector<PvLine>& lines);
+
+        /**
+         * @brief Polls the clock (every TimeManager::NODES_PER_POLL nodes) & the node limit
+         * @post stopped_ is set if the search must end now
+         */
+        void checkLimits();
+
+    public:
+        /**
+         * @brief Parameterized constructor.
+         * @param table The transposition table to use. Several searchers may share one.
+         *        A table of TranspositionTable::DEFAULT_SIZE_MB is allocated if none is given.
+         */
+        explicit Searcher(std::shared_ptr<TranspositionTable> table = nullptr);
+
+        /**
+         * @brief Searches `position` by iterative deepening until one of `limits` is reached
+         * @param position The position to search. It is restored before returning.
+         * @return The result of the last completed iteration: the best move (null if there are
+         *         no legal moves), its score & principal variation
+         */
+        SearchResult search(Position& position, const SearchLimits& limits);
+
+        /**
+         * @brief Searches `position` to a fixed depth, without any time limit
+         */
+        SearchResult search(Position& position, int depth);
+
+        std::shared_ptr<TranspositionTable> table() const;
+
+        TimeManager& timeManager();
+
+        /**
+         * @brief Enables / disables quiet checking moves at the first ply of quiescence
+         */
+        void setQuiescenceChecks(bool enabled);
+
+        /**
+         * @brief Sets the keys of the positions the game went through before the position
+         *        searched next, oldest first. A position repeated from them scores as a draw.
+         */
+        void setHistory(std::vector<uint64_t> keys);
+
+        /**
+         * @brief Sets the network evaluating positions (nullptr: the hand-crafted evaluation)
+         */
+        void setNetwork(std::shared_ptr<const Nnue::Network> network);
+
+        /**
+         * @brief Sets the endgame tables probed below the root (nullptr: none).
+         *        Positions they cover are scored exactly instead of being searched.
+         */
+        void setTablebases(std::shared_ptr<const Tablebase::Tablebases> tablebases);
+
+        /**
+         * @brief Asks the running search to return as soon as possible (callable from any thread).
+         *        If no search is running, the request applies to the next one.
+         */
+        void stop();
+
+        /**
+         * @brief Tells a pondering search that the opponent played the expected move (callable from any thread).
+         *        The search carries on as a normal search, with its limits counted from now.
+         *        If no search is running, the request applies to the next one.
+         */
+        void ponderhit();
+
+        /**
+         * @brief Drops pending stop() / ponderhit() requests. Only call while no search is running.
+         */
+        void resetRequests();
+
+        /**
+         * @brief Registers a function called with the result of every completed iteration
+         */
+        void setIterationCallback(std::function<void(const SearchResult&)> callback);
+
+        /**
+         * @brief Registers a function called on the search thread whenever the search polls
+         *        its limits (every TimeManager::NODES_PER_POLL nodes), eg. to check for input
+         */
+        void setPollCallback(std::function<void()> callback);
+
+        /**
+         * @return The pawn structure cache of the hand-crafted evaluation
+         */
+        const Evaluation::PawnTable& pawnTable() const { return pawn_table_; }
+
+        /**
+         * @return The number of nodes visited by the last search
+         */
+        uint64_t nodes() const;
+};
@@ -0,0 +1,71 @@
+/**
+ * @class SpscQueue
+ * @brief A bounded, lock-free, single-producer / single-consumer ring buffer.
+ *
+ * Exactly one thread may call push() and exactly one (other) thread may call pop().
+ * Neither call ever blocks or takes a lock, so the consumer can poll the queue
+ * from inside a hot loop (such as the search) at practically no cost.
+ *
+ * @tparam T The element type (moved in & out)
+ * @tparam CAPACITY The maximum number of queued elements, a power of two
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+template <typename T, size_t CAPACITY>
+class SpscQueue {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+    private:
+        static const size_t CACHE_LINE = 64;
+
+        T slots_[CAPACITY];
+
+        // The producer only writes tail_ and the consumer only writes head_.
+        // Each lives on its own cache line so the two threads don't contend on one.
+        alignas(CACHE_LINE) std::atomic<size_t> head_;
+        alignas(CACHE_LINE) std::atomic<size_t> tail_;
+
+    public:
+        SpscQueue() : head_{0}, tail_{0} {}
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        /**
+         * @brief Enqueues `value` (producer thread only)
+         * @return False, leaving the queue untouched, if it is full
+         */
+        bool push(T value) {
+            const size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - head_.load(std::memory_order_acquire) == CAPACITY) { return false; }
+
+            slots_[tail & (CAPACITY - 1)] = std::move(value);
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Dequeues the oldest element into `value` (consumer thread only)
+         * @return False, leaving `value` untouched, if the queue is empty
+         */
+        bool pop(T& value) {
+            const size_t head = head_.load(std::memory_order_relaxed);
+            if (head == tail_.load(std::memory_order_acquire)) { return false; }
+
+            value = std::move(slots_[head & (CAPACITY - 1)]);
+            head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @return True if nothing is queued (a snapshot: may change right after the call)
+         */
+        bool empty() const {
+            return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+        }
+};
@@ -0,0 +1,126 @@
+#include "Stats.hpp"
+
+#include <deque>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace Stats {
+    namespace {
+        const char* const NAMES[COUNTER_COUNT] = {
+            "can_move_calls", "board_moves", "board_undos", "position_makes", "position_unmakes",
+            "moves_generated", "nodes", "tt_probes", "tt_hits", "tt_collisions", "cutoffs", "first_move_cutoffs"
+        };
+
+#ifdef P6_STATS
+        // Blocks are never freed, only reused: a deque does not move them as it grows
+        std::mutex registry_mutex;
+        std::deque<ThreadCounters> registry;
+        std::vector<ThreadCounters*> free_blocks;   // Blocks of exited threads, zeroed
+        uint64_t retired[COUNTER_COUNT] = {};       // Counts of exited threads
+#endif
+
+        /**
+         * @return `part` as a percentage of `whole`, or 0 if `whole` is 0
+         */
+        double percent(uint64_t part, uint64_t whole) {
+            return whole ? 100.0 * static_cast<double>(part) / static_cast<double>(whole) : 0.0;
+        }
+    }
+
+    /**
+     * @return The snake_case name of `counter`, as used in exports
+     */
+    const char* name(Counter counter) {
+        return NAMES[counter];
+    }
+
+    /**
+     * @return The counters as a one-line JSON object, eg. {"nodes": 1234, ...}
+     */
+    std::string Snapshot::toJson() const {
+        std::ostringstream json;
+        json << "{\"enabled\": " << (ENABLED ? "true" : "false");
+        for (int counter = 0; counter < COUNTER_COUNT; counter++) {
+            json << ", \"" << NAMES[counter] << "\": " << values[counter];
+        }
+        json << "}";
+        return json.str();
+    }
+
+    /**
+     * @return The counters as a two-column text table, with hit & cutoff rates
+     */
+    std::string Snapshot::toTable() const {
+        std::ostringstream table;
+        if (!ENABLED) { table << "(counters compiled out: build with STATS=1)\n"; }
+        for (int counter = 0; counter < COUNTER_COUNT; counter++) {
+            table << std::left << std::setw(20) << NAMES[counter] << std::right << std::setw(16) << values[counter] << "\n";
+        }
+        table << std::fixed << std::setprecision(1)
+              << std::left << std::setw(20) << "tt_hit_rate" << std::right << std::setw(15)
+              << percent(values[TT_HITS], values[TT_PROBES]) << "%\n"
+              << std::left << std::setw(20) << "first_move_rate" << std::right << std::setw(15)
+              << percent(values[FIRST_MOVE_CUTOFFS], values[CUTOFFS]) << "%\n";
+        return table.str();
+    }
+
+#ifdef P6_STATS
+    /**
+     * @return A zeroed block of counters, summed by every collect() until it is retired
+     */
+    ThreadCounters* registerThread() {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        if (free_blocks.empty()) {
+            registry.emplace_back();
+            return &registry.back();
+        }
+        ThreadCounters* counters = free_blocks.back();
+        free_blocks.pop_back();
+        return counters;
+    }
+
+    /**
+     * @brief Adds `counters` to the total of exited threads, then frees the block for another thread
+     */
+    void retireThread(ThreadCounters* counters) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        for (int counter = 0; counter < COUNTER_COUNT; counter++) {
+            retired[counter] += counters->values[counter].exchange(0, std::memory_order_relaxed);
+        }
+        free_blocks.push_back(counters);
+    }
+#endif
+
+    /**
+     * @return The sum of every thread's counters so far (all zero if counters are compiled out)
+     */
+    Snapshot collect() {
+        Snapshot snapshot;
+#ifdef P6_STATS
+        // Free blocks are zeroed, so summing them too changes nothing
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        for (int counter = 0; counter < COUNTER_COUNT; counter++) { snapshot.values[counter] = retired[counter]; }
+        for (const ThreadCounters& counters : registry) {
+            for (int counter = 0; counter < COUNTER_COUNT; counter++) {
+                snapshot.values[counter] += counters.values[counter].load(std::memory_order_relaxed);
+            }
+        }
+#endif
+        return snapshot;
+    }
+
+    /**
+     * @brief Zeroes every thread's counters. Only call while no other thread is counting.
+     */
+    void reset() {
+#ifdef P6_STATS
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        for (uint64_t& value : retired) { value = 0; }
+        for (ThreadCounters& counters : registry) {
+            for (std::atomic<uint64_t>& value : counters.values) { value.store(0, std::memory_order_relaxed); }
+        }
+#endif
+    }
+}
@@ -0,0 +1,115 @@
+/**
+ * @file Stats.hpp
+ * @brief Hot-path counters: how often the board, move generation, search & transposition
+ *        table do their work, to tell where time goes and whether a change reduced it.
+ *
+ * Counters are only compiled in when P6_STATS is defined (`make STATS=1`). Otherwise
+ * increment() is an empty inline function and every call site compiles to nothing.
+ *
+ * Each thread counts into its own block, so counting takes no lock and shares no cache
+ * line. The blocks are only summed when a Snapshot is collected. When a thread exits, its
+ * counts are folded into a running total and its block is handed to the next new thread,
+ * so there are never more blocks than threads alive at once.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace Stats {
+    enum Counter {
+        CAN_MOVE_CALLS,      // ChessPiece::canMove() calls made by ChessBoard
+        BOARD_MOVES,         // ChessBoard::move() calls
+        BOARD_UNDOS,         // ChessBoard::undo() calls
+        POSITION_MAKES,      // Position::makeMove() calls
+        POSITION_UNMAKES,    // Position::unmakeMove() calls
+        MOVES_GENERATED,     // Moves appended by MoveGen
+        NODES,               // Search & quiescence nodes
+        TT_PROBES,
+        TT_HITS,
+        TT_COLLISIONS,       // Probes finding the slot taken by another position
+        CUTOFFS,             // Beta cutoffs in the main search
+        FIRST_MOVE_CUTOFFS,  // Beta cutoffs by the first move searched
+        COUNTER_COUNT
+    };
+
+    /**
+     * @return The snake_case name of `counter`, as used in exports
+     */
+    const char* name(Counter counter);
+
+    /**
+     * @brief The counters of every thread, summed
+     */
+    struct Snapshot {
+        uint64_t values[COUNTER_COUNT] = {};
+
+        uint64_t operator[](Counter counter) const { return values[counter]; }
+
+        /**
+         * @return The counters as a one-line JSON object, eg. {"nodes": 1234, ...}
+         */
+        std::string toJson() const;
+
+        /**
+         * @return The counters as a two-column text table, with hit & cutoff rates
+         */
+        std::string toTable() const;
+    };
+
+#ifdef P6_STATS
+    const bool ENABLED = true;
+
+    /**
+     * @brief One thread's counters. Only that thread writes them; atomics let others read them.
+     */
+    struct alignas(64) ThreadCounters {
+        std::atomic<uint64_t> values[COUNTER_COUNT] = {};
+    };
+
+    /**
+     * @return A zeroed block of counters, summed by every collect() until it is retired
+     */
+    ThreadCounters* registerThread();
+
+    /**
+     * @brief Adds `counters` to the total of exited threads, then frees the block for another thread
+     */
+    void retireThread(ThreadCounters* counters);
+
+    /**
+     * @brief The block of the current thread, retired when the thread exits
+     */
+    struct ThreadSlot {
+        ThreadCounters* counters;
+
+        ThreadSlot() : counters{registerThread()} {}
+        ~ThreadSlot() { retireThread(counters); }
+        ThreadSlot(const ThreadSlot&) = delete;
+        ThreadSlot& operator=(const ThreadSlot&) = delete;
+    };
+
+    inline void increment(Counter counter, uint64_t amount = 1) {
+        thread_local ThreadSlot slot;
+        std::atomic<uint64_t>& value = slot.counters->values[counter];
+        // Only this thread writes: a plain load & store is enough, no locked add needed
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+#else
+    const bool ENABLED = false;
+
+    inline void increment(Counter, uint64_t = 1) {}
+#endif
+
+    /**
+     * @return The sum of every thread's counters so far (all zero if counters are compiled out)
+     */
+    Snapshot collect();
+
+    /**
+     * @brief Zeroes every thread's counters. Only call while no other thread is counting.
+     */
+    void reset();
+};
@@ -0,0 +1,363 @@
+#include "Tablebase.hpp"
+#include "Evaluation.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+
+using namespace Bitboards;
+
+namespace Tablebase {
+    namespace {
+        const char PIECE_LETTERS[] = "PNBRQK";
+
+        /**
+         * @return The `bytes`-byte little-endian unsigned integer at `data`
+         */
+        uint64_t readLittleEndian(const uint8_t* data, int bytes) {
+            uint64_t value = 0;
+            for (int i = bytes - 1; i >= 0; i--) { value = (value << 8) | data[i]; }
+            return value;
+        }
+
+        void writeLittleEndian(std::ofstream& out, uint64_t value, int bytes) {
+            for (int i = 0; i < bytes; i++) { out.put(static_cast<char>((value >> (8 * i)) & 0xFF)); }
+        }
+
+        /**
+         * @return `sq` mirrored left-right
+         */
+        int mirror(int sq) {
+            return square(rowOf(sq), BOARD_LENGTH - 1 - colOf(sq));
+        }
+
+        /**
+         * @return `sq` flipped top-bottom, as seen by the other side
+         */
+        int flip(int sq) {
+            return square(BOARD_LENGTH - 1 - rowOf(sq), colOf(sq));
+        }
+
+        /**
+         * @return A key ordering the pieces of one side by strength: more pieces, then more material, then stronger pieces
+         */
+        std::vector<int> strength(const std::vector<PieceType>& pieces) {
+            std::vector<int> key{static_cast<int>(pieces.size()), 0};
+            for (PieceType type : pieces) {
+                key[1] += Evaluation::pieceValue(type);
+                key.push_back(type);
+            }
+            return key;
+        }
+    }
+
+    /**
+     * @return The result stored as table byte `value` (which must not be ILLEGAL)
+     */
+    ProbeResult decode(uint8_t value) {
+        if (value == DRAW) { return ProbeResult{0, 0}; }
+        const int plies = value - 1;
+        return ProbeResult{(plies % 2) ? 1 : -1, plies};
+    }
+
+    // =============== Material ===============
+
+    /**
+     * @return The signature, eg. "KRPKR"
+     */
+    std::string Material::signature() const {
+        std::string text;
+        for (int side = PLAYER_ONE; side <= PLAYER_TWO; side++) {
+            text += 'K';
+            for (PieceType type : pieces[side]) { text += PIECE_LETTERS[type]; }
+        }
+        return text;
+    }
+
+    /**
+     * @return The total number of pieces, kings included
+     */
+    int Material::count() const {
+        return 2 + static_cast<int>(pieces[PLAYER_ONE].size() + pieces[PLAYER_TWO].size());
+    }
+
+    /**
+     * @return True if Player Two's pieces would make the stronger side, ie. the signature
+     *         of the material is found in a table with the colors reversed
+     */
+    bool Material::isReversed() const {
+        return strength(pieces[PLAYER_ONE]) < strength(pieces[PLAYER_TWO]);
+    }
+
+    /**
+     * @return The same material with the colors reversed
+     */
+    Material Material::reversed() const {
+        Material material;
+        material.pieces[PLAYER_ONE] = pieces[PLAYER_TWO];
+        material.pieces[PLAYER_TWO] = pieces[PLAYER_ONE];
+        return material;
+    }
+
+    /**
+     * @brief Parses a signature such as "KRPKR" (both kings required, pieces in any order)
+     * @return True if `signature` is valid
+     */
+    bool Material::parse(const std::string& signature, Material& material) {
+        material = Material();
+        int side = -1;
+        for (char letter : signature) {
+            const char* found = std::strchr(PIECE_LETTERS, std::toupper(static_cast<unsigned char>(letter)));
+            if (!found) { return false; }
+            const PieceType type = static_cast<PieceType>(found - PIECE_LETTERS);
+            if (type == KING) {
+                if (++side > PLAYER_TWO) { return false; }
+            } else {
+                if (side < 0) { return false; }
+                material.pieces[side].push_back(type);
+            }
+        }
+        if (side != PLAYER_TWO) { return false; }
+
+        for (std::vector<PieceType>& pieces : material.pieces) {
+            std::sort(pieces.begin(), pieces.end(), [](PieceType a, PieceType b) { return a > b; });
+        }
+        return true;
+    }
+
+    /**
+     * @return The material of `position`
+     */
+    Material Material::of(const Position& position) {
+        Material material;
+        for (int side = PLAYER_ONE; side <= PLAYER_TWO; side++) {
+            for (int type = QUEEN; type >= PAWN; type--) {
+                const int count = popCount(position.pieces(static_cast<Side>(side), static_cast<PieceType>(type)));
+                material.pieces[side].insert(material.pieces[side].end(), count, static_cast<PieceType>(type));
+            }
+        }
+        return material;
+    }
+
+    // =============== Layout ===============
+
+    Layout::Layout(const Material& material) : material_{material}, size_{2} {
+        sides_ = {PLAYER_ONE, PLAYER_TWO};
+        types_ = {KING, KING};
+        for (int side = PLAYER_ONE; side <= PLAYER_TWO; side++) {
+            for (PieceType type : material.pieces[side]) {
+                sides_.push_back(static_cast<Side>(side));
+                types_.push_back(type);
+            }
+        }
+        for (size_t slot = 0; slot < slots(); slot++) { size_ *= range(slot); }
+    }
+
+    /**
+     * @return The number of squares slot `slot` can stand on
+     */
+    int Layout::range(size_t slot) const {
+        if (slot == 0) { return SQUARE_COUNT / 2; }
+        if (types_[slot] == PAWN) { return SQUARE_COUNT - 2 * BOARD_LENGTH; }
+        return SQUARE_COUNT;
+    }
+
+    /**
+     * @brief Computes the index of a position, mirroring & sorting the squares as needed
+     * @param squares The square of each slot. Modified to the canonical squares.
+     */
+    uint64_t Layout::encode(int* squares, Side side_to_move) const {
+        if (colOf(squares[0]) >= BOARD_LENGTH / 2) {
+            for (size_t slot = 0; slot < slots(); slot++) { squares[slot] = mirror(squares[slot]); }
+        }
+        // Slots of identical pieces are adjacent: keep each run sorted
+        for (size_t first = 2; first < slots();) {
+            size_t last = first + 1;
+            while (last < slots() && sides_[last] == sides_[first] && types_[last] == types_[first]) { last++; }
+            std::sort(squares + first, squares + last);
+            first = last;
+        }
+
+        uint64_t index = side_to_move;
+        for (size_t slot = 0; slot < slots(); slot++) {
+            int value = squares[slot];
+            if (slot == 0) { value = rowOf(value) * (BOARD_LENGTH / 2) + colOf(value); }
+            else if (types_[slot] == PAWN) { value -= BOARD_LENGTH; }
+            index = index * range(slot) + value;
+        }
+        return index;
+    }
+
+    /**
+     * @brief Computes the squares & side to move of the position at `index`
+     * @return False if the index is not used: overlapping pieces or a non-canonical order
+     */
+    bool Layout::decode(uint64_t index, int* squares, Side& side_to_move) const {
+        for (size_t slot = slots(); slot-- > 0;) {
+            const int value = static_cast<int>(index % range(slot));
+            index /= range(slot);
+            if (slot == 0) { squares[slot] = square(value / (BOARD_LENGTH / 2), value % (BOARD_LENGTH / 2)); }
+            else if (types_[slot] == PAWN) { squares[slot] = value + BOARD_LENGTH; }
+            else { squares[slot] = value; }
+        }
+        side_to_move = static_cast<Side>(index);
+
+        Bitboard occupied = 0;
+        for (size_t slot = 0; slot < slots(); slot++) {
+            if (occupied & bit(squares[slot])) { return false; }
+            occupied |= bit(squares[slot]);
+            const bool identical = slot > 2 && sides_[slot] == sides_[slot - 1] && types_[slot] == types_[slot - 1];
+            if (identical && squares[slot] < squares[slot - 1]) { return false; }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Builds the Position with pieces on `squares` (one per slot)
+     */
+    Position Layout::toPosition(const int* squares, Side side_to_move) const {
+        Position position;
+        position.clear();
+        for (size_t slot = 0; slot < slots(); slot++) {
+            position.setPiece(squares[slot], makePiece(sides_[slot], types_[slot]));
+        }
+        position.setSideToMove(side_to_move);
+        return position;
+    }
+
+    // =============== Files ===============
+
+    /**
+     * @brief Maps the table file at `path`
+     * @return True if the file is a valid table
+     */
+    bool Table::open(const std::string& path) {
+        if (!file_.open(path) || file_.size() < HEADER_SIZE) { return false; }
+
+        const uint8_t* header = file_.data();
+        std::string signature(reinterpret_cast<const char*>(header + 8), 16);
+        signature = signature.substr(0, signature.find('\0'));
+
+        Material material;
+        if (std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0 || readLittleEndian(header + 4, 4) != VERSION
+            || !Material::parse(signature, material)) {
+            file_.close();
+            return false;
+        }
+
+        layout_ = Layout(material);
+        if (readLittleEndian(header + 24, 8) != layout_.size() || file_.size() != HEADER_SIZE + layout_.size()) {
+            file_.close();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Writes a table file
+     * @param values One byte per entry of `layout`
+     * @return True if the whole file was written
+     */
+    bool write(const std::string& path, const Layout& layout, const std::vector<uint8_t>& values) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) { return false; }
+
+        // Header: magic, version, signature (NUL-padded), number of entries
+        char signature[16] = {};
+        const std::string text = layout.material().signature();
+        std::memcpy(signature, text.data(), std::min(text.size(), sizeof(signature)));
+        out.write(MAGIC, sizeof(MAGIC));
+        writeLittleEndian(out, VERSION, 4);
+        out.write(signature, sizeof(signature));
+        writeLittleEndian(out, layout.size(), 8);
+
+        out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size()));
+        return static_cast<bool>(out);
+    }
+
+    // =============== Tablebases ===============
+
+    /**
+     * @brief Loads one table file
+     * @return True if it was loaded
+     */
+    bool Tablebases::load(const std::string& path) {
+        Table table;
+        if (!table.open(path)) { return false; }
+
+        max_pieces_ = std::max(max_pieces_, table.layout().material().count());
+        const std::string signature = table.layout().material().signature();
+        tables_[signature] = std::move(table);
+        return true;
+    }
+
+    /**
+     * @brief Loads every table file (*.p6tb) of `directory`
+     * @return The number of tables loaded
+     */
+    size_t Tablebases::loadDirectory(const std::string& directory) {
+        DIR* dir = opendir(directory.c_str());
+        if (!dir) { return 0; }
+
+        size_t loaded = 0;
+        const std::string extension = FILE_EXTENSION;
+        while (dirent* entry = readdir(dir)) {
+            const std::string name = entry->d_name;
+            if (name.size() <= extension.size() || name.compare(name.size() - extension.size(), extension.size(), extension) != 0) { continue; }
+            if (load(directory + "/" + name)) { loaded++; }
+        }
+        closedir(dir);
+        return loaded;
+    }
+
+    /**
+     * @return True if the table of `signature` is loaded
+     */
+    bool Tablebases::has(const std::string& signature) const {
+        return tables_.count(signature) != 0;
+    }
+
+    /**
+     * @brief Looks up `position`. Bare kings are always a draw.
+     * @return False if no loaded table covers the position, or it has en passant or castling rights
+     */
+    bool Tablebases::probe(const Position& position, ProbeResult& result) const {
+        if (popCount(position.occupied()) > std::max(max_pieces_, 2)) { return false; }
+        if (position.enPassantSquare() != NO_SQUARE) { return false; }
+        if (position.castlingRights() != NO_CASTLING) { return false; }
+
+        Material material = Material::of(position);
+        if (material.count() == 2) {
+            result = ProbeResult{0, 0};
+            return true;
+        }
+
+        const bool reversed = material.isReversed();
+        if (reversed) { material = material.reversed(); }
+        auto found = tables_.find(material.signature());
+        if (found == tables_.end()) { return false; }
+        const Layout& layout = found->second.layout();
+
+        // Fill the slots in order: pieces of the same kind take the squares of that kind in turn
+        int squares[MAX_PIECES];
+        Bitboard remaining[2][KING + 1];
+        for (int side = PLAYER_ONE; side <= PLAYER_TWO; side++) {
+            for (int type = PAWN; type <= KING; type++) {
+                remaining[side][type] = position.pieces(static_cast<Side>(side), static_cast<PieceType>(type));
+            }
+        }
+        for (size_t slot = 0; slot < layout.slots(); slot++) {
+            const Side side = reversed ? opponent(layout.side(slot)) : layout.side(slot);
+            const int sq = popLsb(remaining[side][layout.type(slot)]);
+            squares[slot] = reversed ? flip(sq) : sq;
+        }
+        const Side side_to_move = reversed ? opponent(position.sideToMove()) : position.sideToMove();
+
+        const uint8_t value = found->second.at(layout.encode(squares, side_to_move));
+        if (value == ILLEGAL) { return false; }
+        result = decode(value);
+        return true;
+    }
+}
@@ -0,0 +1,221 @@
+/**
+ * @file Tablebase.hpp
+ * @brief Endgame tablebases: exact distance-to-mate for every position of a small material set.
+ *
+ * A table covers one material signature, eg. "KRK" or "KRPKR": the pieces of the stronger side
+ * (Player One in the table) after its king, then the pieces of the other side after its king.
+ * Positions with the colors reversed are probed by flipping the board vertically and swapping sides.
+ *
+ * Every position of a table has one byte, at an index computed from its piece squares:
+ *  - the side to move, then one square per piece slot (both kings, then the other pieces)
+ *  - Player One's king is kept on cols 0-3 by mirroring the board left-right, which halves
+ *    the table (there is no castling in a tablebase, so the mirror image is equivalent)
+ *  - pawns only range over the 48 squares of rows 1-6
+ *  - identical pieces are stored in ascending square order; other orders are never used
+ *
+ * Byte values: 0 is a draw, 1-254 is a distance to mate of (value - 1) plies, won for the side
+ * to move if odd and lost if even, and 255 marks an unused index (illegal or non-canonical).
+ *
+ * En passant rights & the fifty-move rule are ignored. Tables are memory-mapped when loaded,
+ * so probing reads only the page holding the entry.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Types.hpp"
+#include "Position.hpp"
+#include "MappedFile.hpp"
+
+namespace Tablebase {
+    static const int MAX_PIECES = 5;                // Kings included
+    static const uint8_t DRAW = 0;
+    static const uint8_t ILLEGAL = 255;
+    static const int MAX_DTM = 253;                 // In plies
+    static const size_t HEADER_SIZE = 32;
+    static const char MAGIC[4] = {'P', '6', 'T', 'B'};
+    static const uint32_t VERSION = 1;
+    static const char* const FILE_EXTENSION = ".p6tb";
+
+    /**
+     * @return The table byte of a position that mates, or gets mated, in `plies`
+     */
+    inline uint8_t encodeDtm(int plies) { return static_cast<uint8_t>(plies + 1); }
+
+    /**
+     * @brief The outcome of a tablebase probe, for the side to move
+     */
+    struct ProbeResult {
+        int wdl;    // 1: win, 0: draw, -1: loss
+        int plies;  // Distance to mate in plies (0 for draws)
+    };
+
+    /**
+     * @return The result stored as table byte `value` (which must not be ILLEGAL)
+     */
+    ProbeResult decode(uint8_t value);
+
+    /**
+     * @brief The piece types of both sides, kings excluded, strongest first
+     */
+    struct Material {
+        std::vector<PieceType> pieces[2];
+
+        /**
+         * @return The signature, eg. "KRPKR"
+         */
+        std::string signature() const;
+
+        /**
+         * @return The total number of pieces, kings included
+         */
+        int count() const;
+
+        /**
+         * @return True if Player Two's pieces would make the stronger side, ie. the signature
+         *         of the material is found in a table with the colors reversed
+         */
+        bool isReversed() const;
+
+        /**
+         * @return The same material with the colors reversed
+         */
+        Material reversed() const;
+
+        /**
+         * @brief Parses a signature such as "KRPKR" (both kings required, pieces in any order)
+         * @return True if `signature` is valid
+         */
+        static bool parse(const std::string& signature, Material& material);
+
+        /**
+         * @return The material of `position`
+         */
+        static Material of(const Position& position);
+    };
+
+    /**
+     * @class Layout
+     * @brief Maps the positions of one material signature to table indexes and back
+     */
+    class Layout {
+        private:
+            Material material_;
+            std::vector<Side> sides_;        // Side of each piece slot: both kings first
+            std::vector<PieceType> types_;   // Type of each piece slot
+            uint64_t size_;
+
+            /**
+             * @return The number of squares slot `slot` can stand on
+             */
+            int range(size_t slot) const;
+
+        public:
+            Layout() : size_{0} {}
+            explicit Layout(const Material& material);
+
+            const Material& material() const { return material_; }
+            size_t slots() const { return sides_.size(); }
+            Side side(size_t slot) const { return sides_[slot]; }
+            PieceType type(size_t slot) const { return types_[slot]; }
+
+            /**
+             * @return The number of entries of the table
+             */
+            uint64_t size() const { return size_; }
+
+            /**
+             * @brief Computes the index of a position, mirroring & sorting the squares as needed
+             * @param squares The square of each slot. Modified to the canonical squares.
+             */
+            uint64_t encode(int* squares, Side side_to_move) const;
+
+            /**
+             * @brief Computes the squares & side to move of the position at `index`
+             * @return False if the index is not used: overlapping pieces or a non-canonical order
+             */
+            bool decode(uint64_t index, int* squares, Side& side_to_move) const;
+
+            /**
+             * @brief Builds the Position with pieces on `squares` (one per slot)
+             */
+            Position toPosition(const int* squares, Side side_to_move) const;
+    };
+
+    /**
+     * @class Table
+     * @brief One table on disk, memory-mapped
+     */
+    class Table {
+        private:
+            Layout layout_;
+            MappedFile file_;
+
+        public:
+            /**
+             * @brief Maps the table file at `path`
+             * @return True if the file is a valid table
+             */
+            bool open(const std::string& path);
+
+            const Layout& layout() const { return layout_; }
+
+            /**
+             * @return The byte of the entry at `index`
+             */
+            uint8_t at(uint64_t index) const { return file_.data()[HEADER_SIZE + index]; }
+    };
+
+    /**
+     * @brief Writes a table file
+     * @param values One byte per entry of `layout`
+     * @return True if the whole file was written
+     */
+    bool write(const std::string& path, const Layout& layout, const std::vector<uint8_t>& values);
+
+    /**
+     * @class Tablebases
+     * @brief The set of tables available for probing, by signature
+     */
+    class Tablebases {
+        private:
+            std::map<std::string, Table> tables_;
+            int max_pieces_;
+
+        public:
+            Tablebases() : max_pieces_{0} {}
+
+            /**
+             * @brief Loads one table file
+             * @return True if it was loaded
+             */
+            bool load(const std::string& path);
+
+            /**
+             * @brief Loads every table file (*.p6tb) of `directory`
+             * @return The number of tables loaded
+             */
+            size_t loadDirectory(const std::string& directory);
+
+            /**
+             * @return True if the table of `signature` is loaded
+             */
+            bool has(const std::string& signature) const;
+
+            /**
+             * @return The largest number of pieces of any loaded table (0 if none)
+             */
+            int maxPieces() const { return max_pieces_; }
+
+            /**
+             * @brief Looks up `position`. Bare kings are always a draw.
+             * @return False if no loaded table covers the position, or it has en passant or castling rights
+             */
+            bool probe(const Position& position, ProbeResult& result) const;
+    };
+}
@@ -0,0 +1,272 @@
+#include "TablebaseGenerator.hpp"
+#include "MoveGen.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Bitboards;
+using namespace Tablebase;
+
+namespace {
+    // Best outcome of the moves leaving a table, for the side to move: WIN_BASE - plies when
+    // winning, -(WIN_BASE - plies) when losing, 0 for a draw. Larger is better.
+    const int16_t WIN_BASE = 1000;
+    const int16_t NO_EXIT = std::numeric_limits<int16_t>::min();
+
+    typedef std::vector<std::vector<uint64_t>> Buckets; // Candidate indexes, by distance to mate
+
+    /**
+     * @brief Runs `work(begin, end, thread)` on `threads` slices of [0, count) in parallel
+     */
+    template <typename Work>
+    void parallelFor(uint64_t count, unsigned threads, Work work) {
+        std::vector<std::thread> workers;
+        const uint64_t slice = (count + threads - 1) / threads;
+        for (unsigned thread = 0; thread < threads; thread++) {
+            const uint64_t begin = std::min(count, thread * slice);
+            const uint64_t end = std::min(count, begin + slice);
+            workers.emplace_back([=]() { work(begin, end, thread); });
+        }
+        for (std::thread& worker : workers) { worker.join(); }
+    }
+
+    /**
+     * @brief Appends every candidate of `from` to `to`
+     */
+    void merge(Buckets& to, const Buckets& from) {
+        for (size_t plies = 0; plies < to.size(); plies++) {
+            to[plies].insert(to[plies].end(), from[plies].begin(), from[plies].end());
+        }
+    }
+
+    /**
+     * @return The squares `type` of side `side` could have moved to `sq` from, without capturing
+     */
+    Bitboard unmoveOrigins(PieceType type, Side side, int sq, Bitboard occupied) {
+        if (type != PAWN) { return attacks(type, sq, occupied) & ~occupied; }
+
+        // Pawns move away from their own side's back row: walk backwards
+        const int back = (side == PLAYER_ONE) ? -BOARD_LENGTH : BOARD_LENGTH;
+        const int start_row = (side == PLAYER_ONE) ? 1 : BOARD_LENGTH - 2;
+        const int from = sq + back;
+        if (rowOf(from) == 0 || rowOf(from) == BOARD_LENGTH - 1 || (occupied & bit(from))) { return 0; }
+
+        Bitboard origins = bit(from);
+        const int double_from = from + back;
+        if (rowOf(double_from) == start_row && !(occupied & bit(double_from))) { origins |= bit(double_from); }
+        return origins;
+    }
+
+    /**
+     * @return The materials reachable from `material` by one capture and/or promotion, in canonical orientation
+     */
+    std::vector<Material> children(const Material& material) {
+        std::vector<Material> found;
+        auto add = [&found](Material child) {
+            if (child.count() == 2) { return; }
+            if (child.isReversed()) { child = child.reversed(); }
+            for (std::vector<PieceType>& pieces : child.pieces) {
+                std::sort(pieces.begin(), pieces.end(), [](PieceType a, PieceType b) { return a > b; });
+            }
+            for (const Material& other : found) {
+                if (other.signature() == child.signature()) { return; }
+            }
+            found.push_back(child);
+        };
+
+        for (int side = PLAYER_ONE; side <= PLAYER_TWO; side++) {
+            const std::vector<PieceType>& ours = material.pieces[side];
+            const std::vector<PieceType>& theirs = material.pieces[opponent(static_cast<Side>(side))];
+
+            // Captures by `side`, with or without promoting at the same time
+            for (size_t victim = 0; victim <= theirs.size(); victim++) {
+                Material captured = material;
+                if (victim < theirs.size()) {
+                    std::vector<PieceType>& pieces = captured.pieces[opponent(static_cast<Side>(side))];
+                    pieces.erase(pieces.begin() + victim);
+                    add(captured);
+                }
+                for (size_t pawn = 0; pawn < ours.size(); pawn++) {
+                    if (ours[pawn] != PAWN) { continue; }
+                    for (int promotion = KNIGHT; promotion <= QUEEN; promotion++) {
+                        Material promoted = captured;
+                        promoted.pieces[side][pawn] = static_cast<PieceType>(promotion);
+                        add(promoted);
+                    }
+                }
+            }
+        }
+        return found;
+    }
+}
+
+/**
+ * @brief Parameterized constructor.
+ * @param directory Where table files are written
+ * @param tables The tables already available. Generated tables are loaded into it.
+ * @param threads The number of worker threads (0: one per hardware thread)
+ */
+TablebaseGenerator::TablebaseGenerator(const std::string& directory, Tablebases& tables, unsigned threads)
+    : directory_{directory}, tables_{tables}, threads_{threads ? threads : std::max(1u, std::thread::hardware_concurrency())} {}
+
+/**
+ * @brief Registers a function called with a line of text at each step of the generation
+ */
+void TablebaseGenerator::setProgressCallback(std::function<void(const std::string&)> callback) {
+    on_progress_ = std::move(callback);
+}
+
+void TablebaseGenerator::report(const std::string& message) const {
+    if (on_progress_) { on_progress_(message); }
+}
+
+/**
+ * @brief Generates the table of `signature` (eg. "KRPKR") and every smaller table it
+ *        leads to through captures & promotions, skipping tables already loaded
+ * @return False if the signature is invalid, has too many pieces, or a table could not be written
+ */
+bool TablebaseGenerator::generate(const std::string& signature) {
+    Material material;
+    if (!Material::parse(signature, material) || material.count() > MAX_PIECES) { return false; }
+    if (material.isReversed()) { material = material.reversed(); }
+    return generateTable(material);
+}
+
+/**
+ * @brief Generates the table of `material`, which must be in canonical orientation,
+ *        after the tables it depends on
+ */
+bool TablebaseGenerator::generateTable(const Material& material) {
+    if (material.count() == 2 || tables_.has(material.signature())) { return true; }
+    for (const Material& child : children(material)) {
+        if (!generateTable(child)) { return false; }
+    }
+
+    const Layout layout(material);
+    const uint64_t size = layout.size();
+    report(material.signature() + ": " + std::to_string(size) + " indexes");
+
+    std::vector<uint8_t> values(size, DRAW);
+    std::vector<int16_t> exits(size, NO_EXIT);
+    std::unique_ptr<std::atomic<uint8_t>[]> counters(new std::atomic<uint8_t>[size]);
+    Buckets buckets(MAX_DTM + 1);
+    std::atomic<bool> missing_table{false};
+
+    // Step 1: set up every index, count the moves staying in the table & score those leaving it
+    std::vector<Buckets> local(threads_, Buckets(MAX_DTM + 1));
+    parallelFor(size, threads_, [&](uint64_t begin, uint64_t end, unsigned thread) {
+        int squares[MAX_PIECES];
+        Side side_to_move;
+        MoveList moves;
+        UndoInfo undo;
+        for (uint64_t index = begin; index < end; index++) {
+            counters[index].store(0, std::memory_order_relaxed);
+            if (!layout.decode(index, squares, side_to_move)) { values[index] = ILLEGAL; continue; }
+            Position position = layout.toPosition(squares, side_to_move);
+            if (position.leftKingInCheck()) { values[index] = ILLEGAL; continue; }
+
+            moves.clear();
+            MoveGen::generateLegal(position, moves);
+            if (moves.empty()) {
+                if (position.inCheck()) { local[thread][0].push_back(index); }
+                continue; // Stalemates stay drawn
+            }
+
+            int in_table = 0;
+            int16_t best_exit = NO_EXIT;
+            for (EngineMove move : moves) {
+                if (!move.isCapture() && !move.isPromotion()) { in_table++; continue; }
+
+                ProbeResult child;
+                position.makeMove(move, undo);
+                const bool found = tables_.probe(position, child);
+                position.unmakeMove(move, undo);
+                if (!found) { missing_table.store(true); continue; }
+
+                int16_t exit = 0;
+                if (child.wdl < 0) { exit = WIN_BASE - (child.plies + 1); }
+                else if (child.wdl > 0) { exit = -(WIN_BASE - (child.plies + 1)); }
+                best_exit = std::max(best_exit, exit);
+            }
+            counters[index].store(static_cast<uint8_t>(in_table), std::memory_order_relaxed);
+            exits[index] = best_exit;
+
+            // Won through an exit, unless a faster win is found in the table
+            if (best_exit > 0) { local[thread][WIN_BASE - best_exit].push_back(index); }
+            // Every move leaves the table and every exit loses
+            else if (in_table == 0 && best_exit != NO_EXIT && best_exit < 0) { local[thread][WIN_BASE + best_exit].push_back(index); }
+        }
+    });
+    if (missing_table.load()) {
+        report(material.signature() + ": a smaller table is missing");
+        return false;
+    }
+    for (const Buckets& candidates : local) { merge(buckets, candidates); }
+    local.clear();
+
+    // Step 2: resolve positions in order of distance to mate, propagating through un-moves
+    int longest = 0;
+    uint64_t resolved = 0;
+    for (int plies = 0; plies <= MAX_DTM; plies++) {
+        std::vector<uint64_t> frontier;
+        for (uint64_t index : buckets[plies]) {
+            if (values[index] != DRAW) { continue; } // Already resolved faster, or listed twice
+            values[index] = encodeDtm(plies);
+            frontier.push_back(index);
+        }
+        std::vector<uint64_t>().swap(buckets[plies]); // Release the memory of processed candidates
+        if (frontier.empty()) { continue; }
+        longest = plies;
+        resolved += frontier.size();
+
+        const bool won = (plies % 2) == 1;
+        std::vector<Buckets> found(threads_, Buckets(MAX_DTM + 1));
+        parallelFor(frontier.size(), threads_, [&](uint64_t begin, uint64_t end, unsigned thread) {
+            int squares[MAX_PIECES], origin[MAX_PIECES];
+            Side side_to_move;
+            for (uint64_t next = begin; next < end; next++) {
+                layout.decode(frontier[next], squares, side_to_move);
+                const Side mover = opponent(side_to_move);
+                Bitboard occupied = 0;
+                for (size_t slot = 0; slot < layout.slots(); slot++) { occupied |= bit(squares[slot]); }
+
+                for (size_t slot = 0; slot < layout.slots(); slot++) {
+                    if (layout.side(slot) != mover) { continue; }
+                    Bitboard origins = unmoveOrigins(layout.type(slot), mover, squares[slot], occupied);
+                    while (origins) {
+                        std::copy(squares, squares + layout.slots(), origin);
+                        origin[slot] = popLsb(origins);
+                        const uint64_t predecessor = layout.encode(origin, mover);
+                        if (values[predecessor] != DRAW) { continue; }
+
+                        if (!won) {
+                            // Moving here mates (or wins) one ply later
+                            if (plies + 1 <= MAX_DTM) { found[thread][plies + 1].push_back(predecessor); }
+                        } else if (counters[predecessor].fetch_sub(1, std::memory_order_relaxed) == 1) {
+                            // Every move stays in the table and loses, unless an exit does better
+                            const int16_t exit = exits[predecessor];
+                            if (exit != NO_EXIT && exit >= 0) { continue; }
+                            const int lost = std::max(plies + 1, exit == NO_EXIT ? 0 : WIN_BASE + exit);
+                            if (lost <= MAX_DTM) { found[thread][lost].push_back(predecessor); }
+                        }
+                    }
+                }
+            }
+        });
+        for (const Buckets& candidates : found) { merge(buckets, candidates); }
+    }
+
+    // Step 3: everything left unresolved is a draw already
+    report(material.signature() + ": " + std::to_string(resolved) + " decisive positions, longest mate " + std::to_string(longest) + " plies");
+
+    const std::string path = directory_ + "/" + material.signature() + FILE_EXTENSION;
+    if (!write(path, layout, values) || !tables_.load(path)) {
+        report(material.signature() + ": cannot write " + path);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,63 @@
+/**
+ * @class TablebaseGenerator
+ * @brief Builds endgame tables by retrograde analysis.
+ *
+ * Instead of searching forward from every position, the generator starts from the
+ * positions whose outcome is already known and works backwards through "un-moves":
+ *  1. Every index is set up once (in parallel). Checkmates are lost in 0 plies. Moves that
+ *     leave the table (captures & promotions) are looked up in the smaller tables, which are
+ *     generated first. The remaining moves of each position are counted.
+ *  2. Positions are then resolved in order of distance to mate. When a position is lost in
+ *     d plies, every position that can move into it wins in d + 1. When a position is won,
+ *     the count of every predecessor drops by one; a predecessor left with no move that avoids
+ *     defeat is lost. Each distance is processed in parallel, with atomic counters.
+ *  3. Whatever is never resolved is a draw.
+ *
+ * Resolving positions in increasing distance gives the exact distance to mate: the winner
+ * takes the fastest mate and the loser the slowest.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "Tablebase.hpp"
+
+class TablebaseGenerator {
+    private:
+        std::string directory_;
+        Tablebase::Tablebases& tables_;
+        unsigned threads_;
+        std::function<void(const std::string&)> on_progress_;
+
+        /**
+         * @brief Generates the table of `material`, which must be in canonical orientation,
+         *        after the tables it depends on
+         */
+        bool generateTable(const Tablebase::Material& material);
+
+        void report(const std::string& message) const;
+
+    public:
+        /**
+         * @brief Parameterized constructor.
+         * @param directory Where table files are written
+         * @param tables The tables already available. Generated tables are loaded into it.
+         * @param threads The number of worker threads (0: one per hardware thread)
+         */
+        TablebaseGenerator(const std::string& directory, Tablebase::Tablebases& tables, unsigned threads = 0);
+
+        /**
+         * @brief Registers a function called with a line of text at each step of the generation
+         */
+        void setProgressCallback(std::function<void(const std::string&)> callback);
+
+        /**
+         * @brief Generates the table of `signature` (eg. "KRPKR") and every smaller table it
+         *        leads to through captures & promotions, skipping tables already loaded
+         * @return False if the signature is invalid, has too many pieces, or a table could not be written
+         */
+        bool generate(const std::string& signature);
+};
@@ -0,0 +1,92 @@
+#include "TimeManager.hpp"
+
+#include <algorithm>
+
+namespace {
+    // Moves assumed to remain in the game when the clock has no time control
+    const int ESTIMATED_MOVES_TO_GO = 30;
+    const int MAX_MOVES_TO_GO = 40;
+}
+
+TimeManager::TimeManager()
+    : start_{Clock::now()}, optimum_ms_{0}, maximum_ms_{0}, move_overhead_ms_{DEFAULT_MOVE_OVERHEAD_MS},
+      use_stability_{false}, timed_{false} {}
+
+/**
+ * @brief Sets the time kept in reserve on every move for I/O & scheduling latency
+ */
+void TimeManager::setMoveOverhead(int64_t overhead_ms) {
+    move_overhead_ms_ = std::max<int64_t>(0, overhead_ms);
+}
+
+/**
+ * @brief Starts the clock and allocates time for one move
+ *
+ * With a fixed move time, the whole budget (minus overhead) is used.
+ * With a game clock, the remaining time is spread over the moves still to play
+ * (estimated when there is no time control), plus most of the increment.
+ */
+void TimeManager::start(const SearchLimits& limits) {
+    start_ = Clock::now();
+    timed_ = !limits.infinite && (limits.move_time_ms >= 0 || limits.time_left_ms >= 0);
+    use_stability_ = false;
+    if (!timed_) { return; }
+
+    if (limits.move_time_ms >= 0) {
+        optimum_ms_ = maximum_ms_ = std::max<int64_t>(1, limits.move_time_ms - move_overhead_ms_);
+        return;
+    }
+
+    const int64_t available = std::max<int64_t>(1, limits.time_left_ms - move_overhead_ms_);
+    const int moves_to_go = (limits.moves_to_go > 0) ? std::min(limits.moves_to_go, MAX_MOVES_TO_GO) : ESTIMATED_MOVES_TO_GO;
+
+    optimum_ms_ = available / moves_to_go + limits.increment_ms * 3 / 4;
+    // Never plan to spend more than 80% of what is left on one move (all of it if the control ends now)
+    maximum_ms_ = (moves_to_go == 1) ? available : std::min(available * 4 / 5, optimum_ms_ * 5);
+    optimum_ms_ = std::max<int64_t>(1, std::min(optimum_ms_, maximum_ms_));
+    maximum_ms_ = std::max<int64_t>(1, maximum_ms_);
+    use_stability_ = true;
+}
+
+/**
+ * @return Milliseconds elapsed since start()
+ */
+int64_t TimeManager::elapsedMs() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start_).count();
+}
+
+/**
+ * @return True if a time limit applies to this search
+ */
+bool TimeManager::isTimed() const {
+    return timed_;
+}
+
+/**
+ * @brief Decides, between iterations, whether to start another one
+ * @param stable_iterations How many consecutive iterations returned the same best move
+ * @return True if the search should stop now
+ */
+bool TimeManager::shouldStop(int stable_iterations) const {
+    if (!timed_) { return false; }
+    if (!use_stability_) { return hardLimitReached(); }
+
+    // A best move that keeps changing earns extra time, a settled one gives time back
+    double scale = 1.4;
+    if (stable_iterations >= 6) { scale = 0.4; }
+    else if (stable_iterations >= 3) { scale = 0.7; }
+    else if (stable_iterations >= 1) { scale = 1.0; }
+
+    int64_t budget = std::min<int64_t>(maximum_ms_, static_cast<int64_t>(optimum_ms_ * scale));
+
+    // The next iteration usually costs more than all previous ones together,
+    // so don't start one that is unlikely to finish within the budget
+    return elapsedMs() >= budget / 2;
+}
+
+/**
+ * @return True once the hard deadline has passed
+ */
+bool TimeManager::hardLimitReached() const {
+    return timed_ && elapsedMs() >= maximum_ms_;
+}
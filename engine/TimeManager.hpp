@@ -0,0 +1,90 @@
+/**
+ * @class TimeManager
+ * @brief Decides how long a search may think, given the limits it was started with.
+ *
+ * Two budgets are derived when a search starts:
+ *  - the optimum time, checked between iterations of iterative deepening. It shrinks
+ *    while the best move stays the same, so easy moves are played quickly.
+ *  - the maximum time, a hard deadline checked during the search itself. The clock is
+ *    only polled every NODES_PER_POLL nodes, so reading it costs next to nothing.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "Types.hpp"
+
+/**
+ * @brief What a search is allowed to spend. Negative times / zero counts mean "no limit".
+ */
+struct SearchLimits {
+    int depth = MAX_PLY - 1;    // Maximum iterative deepening depth
+    int64_t time_left_ms = -1;  // Remaining clock of the side to move
+    int64_t increment_ms = 0;   // Increment per move of the side to move
+    int moves_to_go = 0;        // Moves until the next time control (0: sudden death)
+    int64_t move_time_ms = -1;  // Exact time to spend on this move
+    uint64_t nodes = 0;         // Maximum number of nodes to search
+    bool infinite = false;      // Search until stopped externally
+    bool ponder = false;        // Search the opponent's expected reply; the limits apply from ponderhit() on
+    int multi_pv = 1;           // Number of best root moves to find, each with its own principal variation
+};
+
+class TimeManager {
+    public:
+        typedef std::chrono::steady_clock Clock;
+
+        static const uint64_t NODES_PER_POLL = 1024;  // Must be a power of two
+        static const int64_t DEFAULT_MOVE_OVERHEAD_MS = 5;
+
+    private:
+        Clock::time_point start_;
+        int64_t optimum_ms_;        // Soft budget, scaled by best move stability
+        int64_t maximum_ms_;        // Hard deadline
+        int64_t move_overhead_ms_;  // Time reserved for communication latency
+        bool use_stability_;        // Whether stable best moves may end the search early
+        bool timed_;                // Whether any time limit applies at all
+
+    public:
+        TimeManager();
+
+        /**
+         * @brief Sets the time kept in reserve on every move for I/O & scheduling latency
+         */
+        void setMoveOverhead(int64_t overhead_ms);
+
+        /**
+         * @brief Starts the clock and allocates time for one move
+         *
+         * With a fixed move time, the whole budget (minus overhead) is used.
+         * With a game clock, the remaining time is spread over the moves still to play
+         * (estimated when there is no time control), plus most of the increment.
+         */
+        void start(const SearchLimits& limits);
+
+        /**
+         * @return Milliseconds elapsed since start()
+         */
+        int64_t elapsedMs() const;
+
+        /**
+         * @return True if a time limit applies to this search
+         */
+        bool isTimed() const;
+
+        /**
+         * @brief Decides, between iterations, whether to start another one
+         * @param stable_iterations How many consecutive iterations returned the same best move
+         * @return True if the search should stop now
+         */
+        bool shouldStop(int stable_iterations) const;
+
+        /**
+         * @return True once the hard deadline has passed
+         */
+        bool hardLimitReached() const;
+
+        int64_t optimumMs() const { return optimum_ms_; }
+        int64_t maximumMs() const { return maximum_ms_; }
+};
@@ -0,0 +1,266 @@
+#include "Tournament.hpp"
+#include "MoveGen.hpp"
+#include "Notation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace {
+    /**
+     * @return The Elo difference at which the stronger side is expected to score `score` (in [0, 1])
+     */
+    double eloFromScore(double score) {
+        score = std::min(std::max(score, 1e-6), 1.0 - 1e-6);
+        return -400.0 * std::log10(1.0 / score - 1.0);
+    }
+
+    /**
+     * @return The number of times the current position occurred, going back to the last irreversible move
+     * @param keys The key of every position of the game, the current one last
+     */
+    int repetitions(const std::vector<uint64_t>& keys, int halfmove_clock) {
+        const int last = static_cast<int>(keys.size()) - 1;
+        const int first = std::max(0, last - halfmove_clock);
+        int count = 0;
+        for (int i = last; i >= first; i -= 2) { count += keys[i] == keys[last]; }
+        return count;
+    }
+}
+
+// =============== EngineConfig ===============
+
+/**
+ * @brief Reads a comma-separated list of settings, eg. "name=new,depth=6,hash=8,qchecks=0".
+ *        Keys: name, depth, nodes, movetime, hash, qchecks, nnue (a weights file, loaded now).
+ *        Unlisted settings keep their value.
+ * @return False if a key or value is invalid, or the network cannot be loaded
+ */
+bool EngineConfig::parse(const std::string& settings) {
+    std::istringstream stream(settings);
+    std::string setting;
+    while (std::getline(stream, setting, ',')) {
+        const size_t equals = setting.find('=');
+        if (equals == std::string::npos) { return false; }
+        const std::string key = setting.substr(0, equals);
+        const std::string value = setting.substr(equals + 1);
+        if (key == "name") { name = value; continue; }
+        if (key == "nnue") {
+            auto loaded = std::make_shared<Nnue::Network>();
+            if (!loaded->load(value)) { return false; }
+            network = loaded;
+            continue;
+        }
+
+        char* end = nullptr;
+        const long long number = std::strtoll(value.c_str(), &end, 10);
+        if (value.empty() || *end != '\0' || number < 0) { return false; }
+        if (key == "depth") {
+            if (number < 1 || number >= MAX_PLY) { return false; }
+            limits.depth = static_cast<int>(number);
+        } else if (key == "nodes") {
+            limits.nodes = static_cast<uint64_t>(number);
+        } else if (key == "movetime") {
+            limits.move_time_ms = number ? number : -1;
+        } else if (key == "hash") {
+            if (number < 1) { return false; }
+            hash_mb = static_cast<size_t>(number);
+        } else if (key == "qchecks") {
+            quiescence_checks = number != 0;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// =============== MatchScore ===============
+
+/**
+ * @return The Elo difference matching A's score (0 when no game is finished)
+ */
+double MatchScore::elo() const {
+    if (!games()) { return 0; }
+    return eloFromScore((wins + 0.5 * draws) / games());
+}
+
+/**
+ * @return Half the width of the 95% confidence interval of elo()
+ */
+double MatchScore::eloError() const {
+    if (!games()) { return 0; }
+    const double n = static_cast<double>(games());
+    const double mean = (wins + 0.5 * draws) / n;
+    const double variance = (wins * (1 - mean) * (1 - mean) + draws * (0.5 - mean) * (0.5 - mean)
+                             + losses * mean * mean) / n;
+    const double margin = 1.96 * std::sqrt(variance / n);
+    return (eloFromScore(mean + margin) - eloFromScore(mean - margin)) / 2;
+}
+
+// =============== Tournament ===============
+
+Tournament::Tournament(const EngineConfig& a, const EngineConfig& b)
+    : engines_{a, b}, max_plies_{DEFAULT_MAX_PLIES}, pgn_{nullptr} {}
+
+/**
+ * @brief Reads openings from a file of FENs (one per line; blank lines & '#' comments skipped)
+ * @return False if the file cannot be read or holds an invalid FEN
+ */
+bool Tournament::loadOpenings(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) { return false; }
+    openings_.clear();
+    std::string line;
+    Position position;
+    while (std::getline(in, line)) {
+        const size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') { continue; }
+        line = line.substr(first, line.find_last_not_of(" \t\r") + 1 - first);
+        if (!position.setFromFen(line)) { return false; }
+        openings_.push_back(line);
+    }
+    return true;
+}
+
+/**
+ * @brief Registers a function called after every game with the score so far & games per second.
+ *        Calls are serialized, but come from the worker threads.
+ */
+void Tournament::setGameCallback(std::function<void(const MatchScore&, double)> callback) {
+    on_game_ = std::move(callback);
+}
+
+/**
+ * @brief Plays `games` games on `threads` threads (0: one per hardware thread), going
+ *        through the openings in order & again from the start if there are too few.
+ *        With no opening loaded, every game starts from the standard position.
+ * @return The final score
+ */
+MatchScore Tournament::run(uint64_t games, unsigned threads) {
+    if (threads == 0) { threads = std::max(1u, std::thread::hardware_concurrency()); }
+    threads = static_cast<unsigned>(std::min<uint64_t>(threads, std::max<uint64_t>(games, 1)));
+    score_ = MatchScore();
+    start_ = std::chrono::steady_clock::now();
+
+    std::atomic<uint64_t> next_game{0};
+    std::vector<std::thread> workers;
+    for (unsigned thread = 0; thread < threads; thread++) {
+        workers.emplace_back([&]() {
+            // Searchers are reused from game to game: only their tables are cleared
+            Searcher searchers[2] = {Searcher(std::make_shared<TranspositionTable>(engines_[0].hash_mb)),
+                                     Searcher(std::make_shared<TranspositionTable>(engines_[1].hash_mb))};
+            for (int engine = 0; engine < 2; engine++) {
+                searchers[engine].setQuiescenceChecks(engines_[engine].quiescence_checks);
+                searchers[engine].setNetwork(engines_[engine].network);
+            }
+            for (uint64_t index = next_game++; index < games; index = next_game++) { playGame(index, searchers); }
+        });
+    }
+    for (std::thread& worker : workers) { worker.join(); }
+    return score_;
+}
+
+/**
+ * @brief Plays game `index`: opening index / 2, with A as Player One if the index is even
+ * @param searchers The calling worker's searchers for A & B
+ */
+void Tournament::playGame(uint64_t index, Searcher* searchers) {
+    const int a_side = index % 2 == 0 ? PLAYER_ONE : PLAYER_TWO;
+    Position position;
+    if (!openings_.empty()) { position.setFromFen(openings_[(index / 2) % openings_.size()]); }
+    const Position start = position;
+    for (int engine = 0; engine < 2; engine++) { searchers[engine].table()->clear(); }
+
+    std::vector<EngineMove> moves;
+    std::vector<uint64_t> keys{position.key()};
+    MoveList legal;
+    UndoInfo undo;
+    Outcome outcome = DRAW;
+    std::string reason;
+    const Outcome mover_wins[2] = {PLAYER_ONE_WINS, PLAYER_TWO_WINS};
+    while (true) {
+        const Side side = position.sideToMove();
+        legal.clear();
+        MoveGen::generateLegal(position, legal);
+        if (legal.empty()) {
+            if (position.inCheck()) {
+                outcome = mover_wins[opponent(side)];
+                reason = "checkmate";
+            } else {
+                reason = "stalemate";
+            }
+            break;
+        }
+        if (!position.hasMatingMaterial()) { reason = "insufficient material"; break; }
+        if (position.halfmoveClock() >= 100) { reason = "fifty-move rule"; break; }
+        if (repetitions(keys, position.halfmoveClock()) >= 3) { reason = "threefold repetition"; break; }
+        if (static_cast<int>(moves.size()) >= max_plies_) { reason = "ply limit"; break; }
+
+        const int engine = side == a_side ? 0 : 1;
+        searchers[engine].setHistory(std::vector<uint64_t>(keys.begin(), keys.end() - 1));
+        const SearchResult result = searchers[engine].search(position, engines_[engine].limits);
+        const EngineMove move = result.best_move.isNull() ? legal[0] : result.best_move;
+        if (result.score >= MATE_BOUND) {
+            // The search proved a forced mate: playing it out cannot change the result
+            outcome = mover_wins[side];
+            reason = "forced mate announced";
+            break;
+        }
+
+        position.makeMove(move, undo);
+        moves.push_back(move);
+        keys.push_back(position.key());
+    }
+
+    std::lock_guard<std::mutex> lock(score_mutex_);
+    if (outcome == DRAW) {
+        score_.draws++;
+    } else if (outcome == mover_wins[a_side]) {
+        score_.wins++;
+    } else {
+        score_.losses++;
+    }
+    if (pgn_) { writePgn(index, start, moves, outcome, reason); }
+    if (on_game_) {
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+        on_game_(score_, score_.games() / std::max(elapsed.count(), 1e-9));
+    }
+}
+
+/**
+ * @brief Writes a finished game to the PGN stream
+ */
+void Tournament::writePgn(uint64_t index, const Position& start, const std::vector<EngineMove>& moves,
+                          Outcome outcome, const std::string& reason) {
+    static const char* const RESULTS[] = {"1-0", "0-1", "1/2-1/2"};
+    const bool a_first = index % 2 == 0;
+    std::ostream& out = *pgn_;
+    out << "[Event \"Tournament\"]\n"
+        << "[Round \"" << index + 1 << "\"]\n"
+        << "[White \"" << engines_[a_first ? 0 : 1].name << "\"]\n"
+        << "[Black \"" << engines_[a_first ? 1 : 0].name << "\"]\n"
+        << "[Result \"" << RESULTS[outcome] << "\"]\n";
+    const std::string fen = start.toFen();
+    if (!openings_.empty()) { out << "[FEN \"" << fen << "\"]\n[SetUp \"1\"]\n"; }
+    out << "[Termination \"" << reason << "\"]\n\n";
+
+    // The move number is the last field of the FEN
+    int number = std::atoi(fen.substr(fen.find_last_of(' ') + 1).c_str());
+    Position position = start;
+    UndoInfo undo;
+    for (size_t ply = 0; ply < moves.size(); ply++) {
+        if (position.sideToMove() == PLAYER_ONE) {
+            out << number << ". ";
+        } else if (ply == 0) {
+            out << number << "... ";
+        }
+        if (position.sideToMove() == PLAYER_TWO) { number++; }
+        out << Notation::toSan(position, moves[ply]) << (ply % 16 == 15 ? "\n" : " ");
+        position.makeMove(moves[ply], undo);
+    }
+    out << RESULTS[outcome] << "\n\n";
+}
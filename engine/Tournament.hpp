@@ -0,0 +1,133 @@
+/**
+ * @class Tournament
+ * @brief Plays engine-vs-engine matches on many threads, for tuning & regression testing.
+ *
+ * Two engine configurations, A and B, play every opening twice, once with each color.
+ * Worker threads take the next game from a shared counter; each worker owns one Searcher
+ * (and transposition table) per engine, cleared before every game, so games are independent.
+ *
+ * Games are played on the engine's own Position and adjudicated as soon as the outcome is
+ * certain: checkmate, stalemate, insufficient material, the fifty-move rule, threefold
+ * repetition, a forced mate announced by the side to move, or the ply limit (a draw).
+ *
+ * The result is reported from A's point of view, as an Elo difference with a 95% error bar.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Types.hpp"
+#include "Position.hpp"
+#include "Search.hpp"
+#include "Nnue.hpp"
+
+/**
+ * @brief How one side of the match searches
+ */
+struct EngineConfig {
+    std::string name = "engine";
+    SearchLimits limits;
+    size_t hash_mb = 16;
+    bool quiescence_checks = true;
+    std::shared_ptr<const Nnue::Network> network;  // Evaluates positions if set
+
+    /**
+     * @brief Reads a comma-separated list of settings, eg. "name=new,depth=6,hash=8,qchecks=0".
+     *        Keys: name, depth, nodes, movetime, hash, qchecks, nnue (a weights file, loaded now).
+     *        Unlisted settings keep their value.
+     * @return False if a key or value is invalid, or the network cannot be loaded
+     */
+    bool parse(const std::string& settings);
+};
+
+/**
+ * @brief The outcome of a match so far, from A's point of view
+ */
+struct MatchScore {
+    uint64_t wins = 0;
+    uint64_t draws = 0;
+    uint64_t losses = 0;
+
+    uint64_t games() const { return wins + draws + losses; }
+
+    /**
+     * @return The Elo difference matching A's score (0 when no game is finished)
+     */
+    double elo() const;
+
+    /**
+     * @return Half the width of the 95% confidence interval of elo()
+     */
+    double eloError() const;
+};
+
+class Tournament {
+    public:
+        static const int DEFAULT_MAX_PLIES = 400;
+
+        /**
+         * @brief How a game ended
+         */
+        enum Outcome { PLAYER_ONE_WINS, PLAYER_TWO_WINS, DRAW };
+
+    private:
+        EngineConfig engines_[2];      // A & B
+        std::vector<std::string> openings_;
+        int max_plies_;
+
+        std::mutex score_mutex_;
+        MatchScore score_;
+        std::ostream* pgn_;            // Where finished games are written, if anywhere (guarded by score_mutex_)
+        std::function<void(const MatchScore&, double)> on_game_;
+        std::chrono::steady_clock::time_point start_; // When run() started
+
+        /**
+         * @brief Plays game `index`: opening index / 2, with A as Player One if the index is even
+         * @param searchers The calling worker's searchers for A & B
+         */
+        void playGame(uint64_t index, Searcher* searchers);
+
+        /**
+         * @brief Writes a finished game to the PGN stream
+         */
+        void writePgn(uint64_t index, const Position& start, const std::vector<EngineMove>& moves,
+                      Outcome outcome, const std::string& reason);
+
+    public:
+        Tournament(const EngineConfig& a, const EngineConfig& b);
+
+        /**
+         * @brief Reads openings from a file of FENs (one per line; blank lines & '#' comments skipped)
+         * @return False if the file cannot be read or holds an invalid FEN
+         */
+        bool loadOpenings(const std::string& path);
+
+        void setMaxPlies(int max_plies) { max_plies_ = max_plies; }
+
+        /**
+         * @brief Makes finished games be written as PGN to `out` (nullptr: no PGN output)
+         */
+        void setPgnOutput(std::ostream* out) { pgn_ = out; }
+
+        /**
+         * @brief Registers a function called after every game with the score so far & games per second.
+         *        Calls are serialized, but come from the worker threads.
+         */
+        void setGameCallback(std::function<void(const MatchScore&, double)> callback);
+
+        /**
+         * @brief Plays `games` games on `threads` threads (0: one per hardware thread), going
+         *        through the openings in order & again from the start if there are too few.
+         *        With no opening loaded, every game starts from the standard position.
+         * @return The final score
+         */
+        MatchScore run(uint64_t games, unsigned threads = 0);
+};
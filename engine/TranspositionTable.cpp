@@ -0,0 +1,110 @@
+#include "TranspositionTable.hpp"
+#include "Stats.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief Parameterized constructor.
+ * @param megabytes The memory budget of the table. The number of entries is the largest power of two that fits.
+ */
+TranspositionTable::TranspositionTable(size_t megabytes) : mask_{0}, age_{0} {
+    resize(megabytes);
+}
+
+/**
+ * @brief Reallocates the table to fit in `megabytes`, discarding all entries
+ */
+void TranspositionTable::resize(size_t megabytes) {
+    size_t budget = (megabytes ? megabytes : 1) * 1024 * 1024 / sizeof(TTEntry);
+    size_t count = 1;
+    while (count * 2 <= budget) { count *= 2; }
+
+    entries_.assign(count, TTEntry{});
+    entries_.shrink_to_fit();
+    mask_ = count - 1;
+}
+
+/**
+ * @brief Empties every entry
+ */
+void TranspositionTable::clear() {
+    std::fill(entries_.begin(), entries_.end(), TTEntry{});
+    age_ = 0;
+}
+
+/**
+ * @brief Marks the start of a new search, making older entries preferred for replacement
+ */
+void TranspositionTable::newSearch() {
+    age_++;
+}
+
+/**
+ * @brief Looks up `key`
+ * @param entry Receives the stored entry on a hit
+ * @return True if an entry for `key` was found
+ */
+bool TranspositionTable::probe(uint64_t key, TTEntry& entry) const {
+    const TTEntry& slot = entries_[key & mask_];
+    Stats::increment(Stats::TT_PROBES);
+    if (slot.bound == BOUND_NONE) { return false; }
+    if (slot.key != key) {
+        Stats::increment(Stats::TT_COLLISIONS);
+        return false;
+    }
+    Stats::increment(Stats::TT_HITS);
+    entry = slot;
+    return true;
+}
+
+/**
+ * @brief Stores a search result, replacing the existing entry unless it is deeper & from the current search
+ * @param ply The distance from the root, used to store mate scores relative to this position
+ */
+void TranspositionTable::store(uint64_t key, EngineMove move, int score, int depth, Bound bound, int ply) {
+    TTEntry& slot = entries_[key & mask_];
+
+    // Keep a deeper result for the same search, unless this one is exact
+    bool same_position = slot.key == key;
+    if (slot.bound != BOUND_NONE && slot.age == age_ && depth < slot.depth && bound != BOUND_EXACT) { return; }
+
+    // Don't lose a known best move to a result that has none
+    if (move.isNull() && same_position) { move = EngineMove::fromBits(slot.move); }
+
+    slot.key = key;
+    slot.move = move.bits();
+    slot.score = static_cast<int16_t>(scoreToTable(score, ply));
+    slot.depth = static_cast<int8_t>(depth);
+    slot.bound = bound;
+    slot.age = age_;
+}
+
+/**
+ * @return Permille of sampled entries written during the current search (as reported by UCI "hashfull")
+ */
+int TranspositionTable::hashfull() const {
+    const size_t sample = std::min<size_t>(1000, entries_.size());
+    int used = 0;
+    for (size_t i = 0; i < sample; i++) {
+        if (entries_[i].bound != BOUND_NONE && entries_[i].age == age_) { used++; }
+    }
+    return static_cast<int>(used * 1000 / sample);
+}
+
+/**
+ * @brief Converts a score stored in the table back into a score relative to the root
+ */
+int TranspositionTable::scoreFromTable(int score, int ply) {
+    if (score >= MATE_BOUND) { return score - ply; }
+    if (score <= -MATE_BOUND) { return score + ply; }
+    return score;
+}
+
+/**
+ * @brief Converts a root-relative score into one relative to the position being stored
+ */
+int TranspositionTable::scoreToTable(int score, int ply) {
+    if (score >= MATE_BOUND) { return score + ply; }
+    if (score <= -MATE_BOUND) { return score - ply; }
+    return score;
+}
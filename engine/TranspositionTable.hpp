@@ -0,0 +1,90 @@
+/**
+ * @class TranspositionTable
+ * @brief A fixed-size hash table of search results, indexed by Position::key().
+ *
+ * The same position is reached through many move orders. Remembering the score,
+ * depth & best move found for each position lets the search cut off transpositions
+ * immediately and, more importantly, try the previously best move first on every
+ * iteration of iterative deepening.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Types.hpp"
+
+/**
+ * @brief How a stored score relates to the true score of the position
+ */
+enum Bound : uint8_t { BOUND_NONE = 0, BOUND_UPPER = 1, BOUND_LOWER = 2, BOUND_EXACT = 3 };
+
+struct TTEntry {
+    uint64_t key;
+    uint16_t move;
+    int16_t score;
+    int8_t depth;
+    uint8_t bound;
+    uint8_t age;
+};
+
+class TranspositionTable {
+    private:
+        std::vector<TTEntry> entries_;
+        size_t mask_;   // entries_.size() - 1 (the size is a power of two)
+        uint8_t age_;   // Incremented per search so stale entries are replaced first
+
+    public:
+        static const size_t DEFAULT_SIZE_MB = 16;
+
+        /**
+         * @brief Parameterized constructor.
+         * @param megabytes The memory budget of the table. The number of entries is the largest power of two that fits.
+         */
+        explicit TranspositionTable(size_t megabytes = DEFAULT_SIZE_MB);
+
+        /**
+         * @brief Reallocates the table to fit in `megabytes`, discarding all entries
+         */
+        void resize(size_t megabytes);
+
+        /**
+         * @brief Empties every entry
+         */
+        void clear();
+
+        /**
+         * @brief Marks the start of a new search, making older entries preferred for replacement
+         */
+        void newSearch();
+
+        /**
+         * @brief Looks up `key`
+         * @param entry Receives the stored entry on a hit
+         * @return True if an entry for `key` was found
+         */
+        bool probe(uint64_t key, TTEntry& entry) const;
+
+        /**
+         * @brief Stores a search result, replacing the existing entry unless it is deeper & from the current search
+         * @param ply The distance from the root, used to store mate scores relative to this position
+         */
+        void store(uint64_t key, EngineMove move, int score, int depth, Bound bound, int ply);
+
+        /**
+         * @return Permille of sampled entries written during the current search (as reported by UCI "hashfull")
+         */
+        int hashfull() const;
+
+        /**
+         * @brief Converts a score stored in the table back into a score relative to the root
+         */
+        static int scoreFromTable(int score, int ply);
+
+        /**
+         * @brief Converts a root-relative score into one relative to the position being stored
+         */
+        static int scoreToTable(int score, int ply);
+};
@@ -0,0 +1,101 @@
+/**
+ * @file Types.hpp
+ * @brief Small value types shared by the search engine (sides, piece types, encoded moves & scores)
+ *
+ * The engine indexes squares exactly like ChessBoard does: square = row * 8 + col,
+ * where row 0 is Player One's back rank. Player One moves up the board and moves first,
+ * so in standard chess notation Player One plays White and (row, col) maps to
+ * file ('h' - col) and rank (row + 1).
+ */
+
+#pragma once
+
+#include <cstdint>
+
+enum Side { PLAYER_ONE = 0, PLAYER_TWO = 1 };
+
+inline Side opponent(Side side) { return static_cast<Side>(side ^ 1); }
+
+enum PieceType { PAWN = 0, KNIGHT, BISHOP, ROOK, QUEEN, KING, NO_PIECE_TYPE };
+
+/**
+ * A piece is encoded as side * 6 + type, so that it fits in a single byte
+ * and can index tables directly. NO_PIECE marks an empty square.
+ */
+typedef uint8_t Piece;
+const Piece NO_PIECE = 12;
+
+inline Piece makePiece(Side side, PieceType type) { return static_cast<Piece>(side * 6 + type); }
+inline Side sideOf(Piece piece) { return static_cast<Side>(piece / 6); }
+inline PieceType typeOf(Piece piece) { return piece == NO_PIECE ? NO_PIECE_TYPE : static_cast<PieceType>(piece % 6); }
+
+/**
+ * Castling rights, one bit per side & wing, combined into a 4-bit field
+ */
+enum CastlingRight {
+    NO_CASTLING = 0,
+    PLAYER_ONE_KING_SIDE = 1,
+    PLAYER_ONE_QUEEN_SIDE = 2,
+    PLAYER_TWO_KING_SIDE = 4,
+    PLAYER_TWO_QUEEN_SIDE = 8,
+    ALL_CASTLING = 15
+};
+
+/**
+ * Scores are in centipawns from the point of view of the side to move.
+ * Mate scores are encoded as MATE_SCORE - plies_to_mate so shorter mates score higher.
+ */
+const int INFINITE_SCORE = 32000;
+const int MATE_SCORE = 31000;
+const int MATE_BOUND = MATE_SCORE - 1000; // Any score beyond this is a forced mate
+const int MAX_PLY = 128;
+
+/**
+ * @brief A chess move packed into 16 bits: from (6) | to (6) | flags (4).
+ *
+ * Unlike the `Move` history record used by ChessBoard, an EngineMove holds no
+ * pointers, so millions of them can be generated, stored and compared cheaply.
+ * The null move (all bits zero) is used to denote "no move".
+ */
+class EngineMove {
+    private:
+        uint16_t bits_;
+
+    public:
+        // Flag values stored in the upper 4 bits
+        static const int QUIET = 0;
+        static const int DOUBLE_PUSH = 1;
+        static const int KING_CASTLE = 2;        // From & to are the king's squares
+        static const int QUEEN_CASTLE = 3;
+        static const int CAPTURE = 4;
+        static const int EN_PASSANT = 5;
+        static const int PROMOTION = 8;          // + (promoted type - KNIGHT)
+        static const int PROMOTION_CAPTURE = 12; // + (promoted type - KNIGHT)
+
+        constexpr EngineMove() : bits_{0} {}
+        constexpr EngineMove(int from, int to, int flags = QUIET)
+            : bits_{static_cast<uint16_t>(from | (to << 6) | (flags << 12))} {}
+
+        static constexpr EngineMove fromBits(uint16_t bits) { EngineMove m; m.bits_ = bits; return m; }
+
+        constexpr uint16_t bits() const { return bits_; }
+        constexpr int from() const { return bits_ & 63; }
+        constexpr int to() const { return (bits_ >> 6) & 63; }
+        constexpr int flags() const { return bits_ >> 12; }
+
+        constexpr bool isNull() const { return bits_ == 0; }
+        constexpr bool isCapture() const { return flags() & CAPTURE; }
+        constexpr bool isPromotion() const { return flags() & PROMOTION; }
+        constexpr bool isEnPassant() const { return flags() == EN_PASSANT; }
+        constexpr bool isCastle() const { return flags() == KING_CASTLE || flags() == QUEEN_CASTLE; }
+
+        /**
+         * @return The type a pawn promotes to, or NO_PIECE_TYPE if this is not a promotion
+         */
+        constexpr PieceType promotion() const {
+            return isPromotion() ? static_cast<PieceType>(KNIGHT + (flags() & 3)) : NO_PIECE_TYPE;
+        }
+
+        constexpr bool operator==(const EngineMove& other) const { return bits_ == other.bits_; }
+        constexpr bool operator!=(const EngineMove& other) const { return bits_ != other.bits_; }
+};
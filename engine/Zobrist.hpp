@@ -0,0 +1,55 @@
+/**
+ * @file Zobrist.hpp
+ * @brief Random keys used to hash positions incrementally.
+ *
+ * A position's key is the XOR of one key per (piece, square) pair on the board,
+ * plus keys for the side to move, the castling rights and the en passant column.
+ * Moving a piece only needs two XORs to update the key. A second key, made of the
+ * pawns' (piece, square) keys alone, identifies the pawn structure. Keys are generated
+ * at compile time from a fixed seed, so they are identical across runs and builds.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace Zobrist {
+    /**
+     * @brief splitmix64 step: advances `state` and returns the next pseudo-random value
+     */
+    constexpr uint64_t nextRandom(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    struct Keys {
+        uint64_t piece_square[12][64];
+        uint64_t en_passant_col[8];
+        uint64_t side;
+        uint64_t castling[16];  // Indexed by the 4-bit rights field. No rights hash to 0.
+    };
+
+    constexpr Keys makeKeys() {
+        Keys keys{};
+        uint64_t state = 0x2357BD11ULL;
+        for (int piece = 0; piece < 12; piece++) {
+            for (int sq = 0; sq < 64; sq++) { keys.piece_square[piece][sq] = nextRandom(state); }
+        }
+        for (int col = 0; col < 8; col++) { keys.en_passant_col[col] = nextRandom(state); }
+        keys.side = nextRandom(state);
+
+        // Each right has its own key: a set of rights hashes to the XOR of theirs
+        uint64_t right_keys[4] = {};
+        for (uint64_t& key : right_keys) { key = nextRandom(state); }
+        for (int rights = 0; rights < 16; rights++) {
+            for (int right = 0; right < 4; right++) {
+                if (rights & (1 << right)) { keys.castling[rights] ^= right_keys[right]; }
+            }
+        }
+        return keys;
+    }
+
+    inline constexpr Keys KEYS = makeKeys();
+};
@@ -0,0 +1,20 @@
+#include "engine/Types.hpp"
+#include "engine/Bitboard.hpp"
+#include "engine/Position.hpp"
+#include "engine/MoveGen.hpp"
+#include "engine/MovePicker.hpp"
+#include "engine/Evaluation.hpp"
+#include "engine/Nnue.hpp"
+#include "engine/TranspositionTable.hpp"
+#include "engine/TimeManager.hpp"
+#include "engine/Search.hpp"
+#include "engine/Notation.hpp"
+#include "engine/PolyglotBook.hpp"
+#include "engine/Tablebase.hpp"
+#include "engine/TablebaseGenerator.hpp"
+#include "engine/Pgn.hpp"
+#include "engine/GameDatabase.hpp"
+#include "engine/PositionIndex.hpp"
+#include "engine/ReferenceCheck.hpp"
+#include "engine/Tournament.hpp"
+#include "engine/Stats.hpp"
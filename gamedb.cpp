@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+
+#include "engine_module.hpp"
+
+namespace {
+    /**
+     * @return The rating written in `text`, or 0 if it is not a number
+     */
+    uint16_t parseRating(std::string_view text) {
+        unsigned rating = 0;
+        std::from_chars(text.data(), text.data() + text.size(), rating);
+        return static_cast<uint16_t>(std::min(rating, 65535u));
+    }
+
+    /**
+     * import <games.pgn> <database> [threads]: converts a PGN file into a database
+     */
+    int importPgn(const std::string& pgn_path, const std::string& db_path, unsigned threads) {
+        PgnReader reader;
+        if (!reader.open(pgn_path)) {
+            std::cerr << "Cannot open " << pgn_path << std::endl;
+            return 1;
+        }
+        GameDb::Writer writer;
+        if (!writer.open(db_path)) {
+            std::cerr << "Cannot create " << db_path << std::endl;
+            return 1;
+        }
+
+        // Games are encoded on the parsing threads. Their ids follow the file order: thread `t` parses
+        // the t-th chunk of the file in order, so the first chunk is written as it is parsed and the
+        // others are buffered, then appended in sequence.
+        if (threads == 0) { threads = std::max(1u, std::thread::hardware_concurrency()); }
+        std::vector<std::vector<std::vector<uint8_t>>> chunks(threads);
+        bool write_failed = false;
+        PgnStats stats = reader.parseParallel([&](const PgnGame& pgn_game, unsigned thread) {
+            GameDb::Game game;
+            game.start_fen = std::string(pgn_game.start_fen);
+            game.moves = pgn_game.moves;
+            game.result = GameDb::parseResult(std::string(pgn_game.result));
+            game.ratings[PLAYER_ONE] = parseRating(pgn_game.tag("WhiteElo"));
+            game.ratings[PLAYER_TWO] = parseRating(pgn_game.tag("BlackElo"));
+
+            std::vector<uint8_t> bytes;
+            if (!GameDb::encode(game, bytes)) { return true; }
+            if (thread > 0) {
+                chunks[thread].push_back(std::move(bytes));
+                return true;
+            }
+            write_failed |= !writer.addEncoded(bytes);
+            return !write_failed;
+        }, threads);
+        for (const std::vector<std::vector<uint8_t>>& chunk : chunks) {
+            for (size_t game = 0; game < chunk.size() && !write_failed; game++) { write_failed |= !writer.addEncoded(chunk[game]); }
+        }
+
+        if (!writer.close() || write_failed) {
+            std::cerr << "Cannot write " << db_path << std::endl;
+            return 1;
+        }
+        std::cout << "Imported " << writer.size() << " games (" << stats.moves << " moves), skipped " << stats.errors << std::endl;
+        return 0;
+    }
+
+    /**
+     * show <database> <id>: prints a game in PGN
+     */
+    int showGame(const std::string& db_path, uint64_t id) {
+        GameDb::Database database;
+        GameDb::Game game;
+        if (!database.open(db_path) || !database.read(id, game)) {
+            std::cerr << "Cannot read game " << id << " of " << db_path << std::endl;
+            return 1;
+        }
+
+        if (!game.start_fen.empty()) { std::cout << "[FEN \"" << game.start_fen << "\"]" << std::endl; }
+        std::cout << "[Result \"" << GameDb::resultText(game.result) << "\"]" << std::endl << std::endl;
+        Position position = game.startPosition();
+        UndoInfo undo;
+        for (size_t ply = 0; ply < game.moves.size(); ply++) {
+            if (position.sideToMove() == PLAYER_ONE || ply == 0) {
+                std::cout << (ply / 2 + 1) << (position.sideToMove() == PLAYER_ONE ? ". " : "... ");
+            }
+            std::cout << Notation::toSan(position, game.moves[ply]) << ' ';
+            position.makeMove(game.moves[ply], undo);
+        }
+        std::cout << GameDb::resultText(game.result) << std::endl;
+        return 0;
+    }
+
+    /**
+     * index <database> <index directory>: indexes the positions of every game not indexed yet
+     */
+    int indexGames(const std::string& db_path, const std::string& directory) {
+        GameDb::Database database;
+        if (!database.open(db_path)) {
+            std::cerr << "Cannot open " << db_path << std::endl;
+            return 1;
+        }
+        mkdir(directory.c_str(), 0755);
+        PositionIndex::Writer writer;
+        if (!writer.open(directory, database)) {
+            std::cerr << "Cannot open index " << directory << ", or it indexes another database" << std::endl;
+            return 1;
+        }
+
+        const uint64_t first = writer.games();
+        GameDb::Game game;
+        for (uint64_t id = first; id < database.size(); id++) {
+            if (!database.read(id, game)) { game = GameDb::Game(); } // Keep ids aligned: index an empty game
+            if (!writer.add(game)) {
+                std::cerr << "Cannot write index " << directory << std::endl;
+                return 1;
+            }
+        }
+        if (!writer.close()) {
+            std::cerr << "Cannot write index " << directory << std::endl;
+            return 1;
+        }
+        std::cout << "Indexed games " << first << " to " << database.size() << std::endl;
+        return 0;
+    }
+
+    /**
+     * find <index directory> <fen> [limit]: lists the games reaching a position
+     */
+    int findPosition(const std::string& directory, const std::string& fen, size_t limit) {
+        PositionIndex::Reader reader;
+        Position position;
+        if (!reader.open(directory) || !position.setFromFen(fen)) {
+            std::cerr << "Cannot open index " << directory << " or read FEN" << std::endl;
+            return 1;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<PositionIndex::Occurrence> found;
+        reader.find(position, found, limit);
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        for (const PositionIndex::Occurrence& occurrence : found) {
+            std::cout << "game " << occurrence.game << " ply " << occurrence.ply << std::endl;
+        }
+        std::cout << found.size() << " occurrences in " << elapsed.count() << " us ("
+                  << reader.runs() << " runs, " << reader.entries() << " entries)" << std::endl;
+        return 0;
+    }
+}
+
+/**
+ * Converts PGN game collections to the compact binary database format, and reads them back.
+ *
+ * Usage: gamedb import <games.pgn> <database> [threads]
+ *        gamedb show <database> <game id>
+ *        gamedb count <database>
+ *        gamedb index <database> <index directory>
+ *        gamedb find <index directory> <fen> [limit]
+ */
+int main(int argc, char** argv) {
+    const std::string command = (argc > 1) ? argv[1] : "";
+    if (command == "import" && argc >= 4) {
+        return importPgn(argv[2], argv[3], (argc > 4) ? static_cast<unsigned>(std::atoi(argv[4])) : 0);
+    }
+    if (command == "show" && argc >= 4) { return showGame(argv[2], std::strtoull(argv[3], nullptr, 10)); }
+    if (command == "index" && argc >= 4) { return indexGames(argv[2], argv[3]); }
+    if (command == "find" && argc >= 4) {
+        return findPosition(argv[2], argv[3], (argc > 4) ? std::strtoull(argv[4], nullptr, 10) : SIZE_MAX);
+    }
+    if (command == "count" && argc >= 3) {
+        GameDb::Database database;
+        if (!database.open(argv[2])) {
+            std::cerr << "Cannot open " << argv[2] << std::endl;
+            return 1;
+        }
+        std::cout << database.size() << std::endl;
+        return 0;
+    }
+
+    std::cerr << "Usage: " << argv[0] << " import <games.pgn> <database> [threads]" << std::endl
+              << "       " << argv[0] << " show <database> <game id>" << std::endl
+              << "       " << argv[0] << " count <database>" << std::endl
+              << "       " << argv[0] << " index <database> <index directory>" << std::endl
+              << "       " << argv[0] << " find <index directory> <fen> [limit]" << std::endl;
+    return 1;
+}
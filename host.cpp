@@ -0,0 +1,37 @@
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "GameHost.hpp"
+
+/**
+ * Hosts many games in one process.
+ *
+ * Usage: host [-s <socket path>]
+ *   eg.  host -s /tmp/p6-host.sock
+ *
+ * Commands are read from stdin, or from every client of the Unix-domain socket if one is
+ * given. See GameHost.hpp for the protocol.
+ */
+int main(int argc, char** argv) {
+    std::string socket_path;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "-s") == 0 && i + 1 < argc) { socket_path = argv[++i]; }
+        else {
+            std::cerr << "Usage: " << argv[0] << " [-s <socket path>]" << std::endl;
+            return 1;
+        }
+    }
+
+    GameHost host;
+    if (socket_path.empty()) {
+        std::ios::sync_with_stdio(false);
+        host.serveStream(std::cin, std::cout);
+        return 0;
+    }
+    if (!host.serveSocket(socket_path)) {
+        std::cerr << "Cannot serve on " << socket_path << std::endl;
+        return 1;
+    }
+    return 0;
+}
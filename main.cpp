@@ -2,12 +2,36 @@
 #include <vector>
 #include <string>
 #include "ChessBoard.hpp"
+#include "BotPlayer.hpp"
 #include "pieces/Queen.hpp"
 
-int main() {
+/**
+ * @brief Plays Player One (human) against the engine, which ponders during the human's turns
+ */
+int playAgainstBot(ChessBoard& board) {
+    SearchLimits limits;
+    limits.move_time_ms = 1000;
+    BotPlayer bot(limits);
+
+    board.display();
+    while (true) {
+        if (board.isPlayerOneTurn()) {
+            if ((std::cin >> std::ws).peek() == EOF) { return 0; }
+            board.attemptRound();
+        } else if (!bot.playRound(board)) {
+            std::cout << "[BOT] No move to play." << std::endl;
+            return 0;
+        }
+        board.display();
+    }
+}
+
+int main(int argc, char** argv) {
     // Initialize the chessboard
     ChessBoard board("BLACK", "WHITE");
 
+    if (argc > 1 && std::string(argv[1]) == "bot") { return playAgainstBot(board); }
+
     // Display the initial board
     std::cout << "Initial Chessboard:\n";
     board.display();
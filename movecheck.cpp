@@ -0,0 +1,72 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "engine_module.hpp"
+
+/**
+ * Checks the engine's move generators against the ChessPiece::canMove() reference.
+ *
+ * Usage: movecheck [-g <generator>] [-f <fen>] [-n <games>] [-m <max plies>] [-s <seed>] [-d <perft depth>]
+ *   eg.  movecheck -g legal -n 1000 -s 7
+ *
+ * Every generator (or only the one named: pseudo-legal, staged, legal or move-rules) is compared with the
+ * reference at every position of random games from the FEN (the initial position by default),
+ * then at every node of its perft tree. The first disagreement is printed with the moves
+ * reaching it, and the exit status is 1.
+ */
+int main(int argc, char** argv) {
+    std::string generator_name, fen;
+    uint64_t games = 200;
+    int max_plies = 200;
+    uint64_t seed = 1;
+    int depth = 3;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "-g" && has_value) { generator_name = argv[++i]; }
+        else if (arg == "-f" && has_value) { fen = argv[++i]; }
+        else if (arg == "-n" && has_value) { games = std::strtoull(argv[++i], nullptr, 10); }
+        else if (arg == "-m" && has_value) { max_plies = std::atoi(argv[++i]); }
+        else if (arg == "-s" && has_value) { seed = std::strtoull(argv[++i], nullptr, 10); }
+        else if (arg == "-d" && has_value) { depth = std::atoi(argv[++i]); }
+        else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [-g <generator>] [-f <fen>] [-n <games>] [-m <max plies>] [-s <seed>] [-d <perft depth>]" << std::endl;
+            return 1;
+        }
+    }
+
+    Position root;
+    if (!fen.empty() && !root.setFromFen(fen)) {
+        std::cerr << "Invalid FEN: " << fen << std::endl;
+        return 1;
+    }
+
+    std::vector<ReferenceCheck::Generator> generators;
+    for (const ReferenceCheck::Generator& generator : ReferenceCheck::builtInGenerators()) {
+        if (generator_name.empty() || generator.name == generator_name) { generators.push_back(generator); }
+    }
+    if (generators.empty()) {
+        std::cerr << "Unknown generator: " << generator_name << std::endl;
+        return 1;
+    }
+
+    const auto report = [](const std::string& check, const ReferenceCheck::Report& result,
+                           std::chrono::steady_clock::time_point start) {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        std::cout << check << ": " << result.positions << " positions in " << elapsed.count() / 1000.0 << "s, "
+                  << (result.failed ? "MISMATCH" : "ok") << std::endl;
+        if (result.failed) { std::cout << result.mismatch.toText(); }
+        return !result.failed;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    if (!report("playouts", ReferenceCheck::checkPlayouts(root, generators, games, max_plies, seed), start)) { return 1; }
+    start = std::chrono::steady_clock::now();
+    if (!report("perft " + std::to_string(depth), ReferenceCheck::checkPerft(root, generators, depth), start)) { return 1; }
+    return 0;
+}
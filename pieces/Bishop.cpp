@@ -4,7 +4,8 @@
  * @brief Default Constructor.
  * @post Sets piece_size_ to 3 and type to "BISHOP"
  */
-Bishop::Bishop() : ChessPiece() { setSize(3); setType("BISHOP"); }
+template <class Geometry>
+BasicBishop<Geometry>::BasicBishop() : BasicChessPiece<Geometry>() { this->setSize(3); this->setType("BISHOP"); }
 
 /**
  * @brief Parameterized constructor.
@@ -13,21 +14,23 @@ Bishop::Bishop() : ChessPiece() { setSize(3); setType("BISHOP"); }
  * @param col: 0-indexed column position of the Bishop.
  * @param movingUp: Flag indicating whether the Bishop is moving up.
  */
-Bishop::Bishop(const std::string& color, const int& row, const int& col, const bool& movingUp)
-    : ChessPiece(color, row, col, movingUp, 3, "BISHOP") {}
+template <class Geometry>
+BasicBishop<Geometry>::BasicBishop(const std::string& color, const int& row, const int& col, const bool& movingUp)
+    : BasicChessPiece<Geometry>(color, row, col, movingUp, 3, "BISHOP") {}
 
-bool Bishop::canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const {
+template <class Geometry>
+bool BasicBishop<Geometry>::canMove(const int& target_row, const int& target_col, const Board& board) const {
     // Not on the board
-    if (getRow() == -1 || getColumn() == -1) { return false; }
+    if (this->getRow() == -1 || this->getColumn() == -1) { return false; }
 
     // Out of bounds target
-    if (target_row < 0 || target_row >= BOARD_LENGTH || target_col < 0 || target_col >= BOARD_LENGTH) { return false; }
+    if (!Geometry::contains(target_row, target_col)) { return false; }
 
-    ChessPiece* target_piece = board[target_row][target_col];
-    if (target_piece && target_piece->getColor() == getColor()) { return false; }
+    BasicChessPiece<Geometry>* target_piece = board[target_row][target_col];
+    if (target_piece && target_piece->getColor() == this->getColor()) { return false; }
 
-    int dx = target_row - getRow();
-    int dy = target_col - getColumn();
+    int dx = target_row - this->getRow();
+    int dy = target_col - this->getColumn();
 
     // Not a diagonal line or they lie on the same cell.
     bool not_diagonal = std::abs(dx) != std::abs(dy);
@@ -41,10 +44,13 @@ bool Bishop::canMove(const int& target_row, const int& target_col, const std::ve
     // Iterate from the target space to the original space and check if there is any obstructing ChessPiece
 
     while ((dx -= row_offset) != 0 && (dy -= col_offset) != 0) {
-        if (board[getRow() + dx][getColumn() + dy]) {
+        if (board[this->getRow() + dx][this->getColumn() + dy]) {
             return false;
         }
     }
 
     return true;
 }
+
+template class BasicBishop<StandardGeometry>;
+template class BasicBishop<CapablancaGeometry>;
@@ -6,13 +6,16 @@
 /**
  * @brief Bishop class inheriting from ChessPiece.
  */
-class Bishop : public ChessPiece {
+template <class Geometry>
+class BasicBishop : public BasicChessPiece<Geometry> {
 public:
+    using typename BasicChessPiece<Geometry>::Board;
+
     /**
      * @brief Default Constructor for Bishop. 
      * @post Sets piece_size_ to 3 and type to "BISHOP"
      */
-    Bishop();
+    BasicBishop();
 
     /**
      * @brief Parameterized constructor.
@@ -21,7 +24,12 @@ public:
      * @param col: 0-indexed column position of the Bishop.
      * @param movingUp: Flag indicating whether the Bishop is moving up on the board.
      */
-    Bishop(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false);
+    BasicBishop(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false);
+
+    bool canMove(const int& target_row, const int& target_col, const Board& board) const override;
+};
+
+extern template class BasicBishop<StandardGeometry>;
+extern template class BasicBishop<CapablancaGeometry>;
 
-    bool canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const override;
-};
\ No newline at end of file
+using Bishop = BasicBishop<StandardGeometry>;
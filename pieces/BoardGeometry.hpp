@@ -0,0 +1,62 @@
+/**
+ * @file BoardGeometry.hpp
+ * @brief The dimensions of a board, as compile-time constants.
+ *
+ * The pieces, Move & ChessBoard take a geometry as a template parameter, so that every
+ * bounds check, loop & table sized by the board is specialized at compile time. The
+ * standard 8x8 board compiles down to the same constants it always had, while wider
+ * variant boards (eg. Capablanca chess's 10x8) reuse the same code.
+ *
+ * Rows are ranks and columns are files, with Player One starting on row 0.
+ */
+
+#pragma once
+
+template <int ROWS, int COLUMNS>
+struct BoardGeometry {
+    static_assert(ROWS >= 4 && COLUMNS >= 1, "A board needs a back rank & a pawn rank per player");
+
+    static constexpr int ROW_COUNT = ROWS;
+    static constexpr int COLUMN_COUNT = COLUMNS;
+    static constexpr int CELL_COUNT = ROWS * COLUMNS;
+
+    /**
+     * @return True if `row` is on the board. A single unsigned comparison: negative rows wrap past the end.
+     */
+    static constexpr bool containsRow(int row) { return static_cast<unsigned>(row) < static_cast<unsigned>(ROWS); }
+
+    /**
+     * @return True if `col` is on the board
+     */
+    static constexpr bool containsColumn(int col) { return static_cast<unsigned>(col) < static_cast<unsigned>(COLUMNS); }
+
+    /**
+     * @return True if (row, col) is a cell of the board
+     */
+    static constexpr bool contains(int row, int col) { return containsRow(row) && containsColumn(col); }
+
+    /**
+     * @return The index of (row, col) among the CELL_COUNT cells, row by row
+     */
+    static constexpr int cell(int row, int col) { return row * COLUMNS + col; }
+
+    static constexpr int rowOf(int cell) { return cell / COLUMNS; }
+
+    static constexpr int columnOf(int cell) { return cell % COLUMNS; }
+};
+
+/**
+ * @brief The standard 8x8 board
+ */
+struct StandardGeometry : BoardGeometry<8, 8> {
+    // Back rank of Player One from column 0, mirrored for Player Two (R: rook, N: knight, B: bishop, K: king, Q: queen)
+    static constexpr const char* BACK_RANK = "RNBKQBNR";
+};
+
+/**
+ * @brief Capablanca chess's 10x8 board. Its archbishop & chancellor are not modelled,
+ *        so their starting cells (the '*' of BACK_RANK) are left empty.
+ */
+struct CapablancaGeometry : BoardGeometry<8, 10> {
+    static constexpr const char* BACK_RANK = "RN*BKQB*NR";
+};
@@ -1,5 +1,20 @@
 #include "ChessPiece.hpp"
 
+namespace {
+    /**
+     * @return The PieceKind named by a type_ string, PieceKind::NONE if there is none
+     */
+    PieceKind kindOf(const std::string& type) {
+        if (type == "PAWN") { return PieceKind::PAWN; }
+        if (type == "KNIGHT") { return PieceKind::KNIGHT; }
+        if (type == "BISHOP") { return PieceKind::BISHOP; }
+        if (type == "ROOK") { return PieceKind::ROOK; }
+        if (type == "QUEEN") { return PieceKind::QUEEN; }
+        if (type == "KING") { return PieceKind::KING; }
+        return PieceKind::NONE;
+    }
+}
+
 /**
  * @brief Default Constructor : All values 
  * Default-initializes all private members.  
@@ -9,22 +24,24 @@
  * Default type: "NONE"
  * Default size: 0
  */
-ChessPiece::ChessPiece() : color_{"BLACK"}, row_{-1}, column_{-1}, movingUp_{false}, piece_size_{0}, type_{"NULL"}, has_moved_{false} {} 
+template <class Geometry>
+BasicChessPiece<Geometry>::BasicChessPiece() : color_{"BLACK"}, row_{-1}, column_{-1}, movingUp_{false}, piece_size_{0}, type_{"NULL"}, kind_{PieceKind::NONE}, has_moved_{false} {} 
 
 /**
 * @brief Parameterized constructor.
 * @param : A const reference to the color of the Chess Piece (a string). Set the color "BLACK" if the provided string contains non-alphabetic characters. 
 *     If the string is purely alphabetic, it is converted and stored in uppercase
-* @param : The 0-indexed row position of the Chess Piece (as a const reference to an integer). Default value -1 if not provided, or if the value provided is outside the board's dimensions, [0, BOARD_LENGTH)
-* @param : The 0-indexed column position of the Chess Piece (as a const reference to an integer). Default value -1 if not provided, or if the value provided is outside the board's dimensions, [0, BOARD_LENGTH)
+* @param : The 0-indexed row position of the Chess Piece (as a const reference to an integer). Default value -1 if not provided, or if the value provided is outside the board's dimensions, [0, Geometry::ROW_COUNT)
+* @param : The 0-indexed column position of the Chess Piece (as a const reference to an integer). Default value -1 if not provided, or if the value provided is outside the board's dimensions, [0, Geometry::COLUMN_COUNT)
 * @param : A flag indicating whether the Chess Piece is moving up on the board, or not (as a const reference to a boolean). Default value false if not provided.
 * @post : The private members are set to the values of the corresponding parameters. 
 *   If either of row or col are out-of-bounds and set to -1, the other is also set to -1 (regardless of being in-bounds or not).
 *   Default piece_size: 0
 *   Default type: "NONE"
 */
-ChessPiece::ChessPiece(const std::string& color, const int& row, const int& col, const bool& movingUp, const int& size, const std::string& type) :
-    color_{"BLACK"}, row_{-1}, column_{-1}, movingUp_{movingUp}, piece_size_{size}, type_{type}, has_moved_{false} {
+template <class Geometry>
+BasicChessPiece<Geometry>::BasicChessPiece(const std::string& color, const int& row, const int& col, const bool& movingUp, const int& size, const std::string& type) :
+    color_{"BLACK"}, row_{-1}, column_{-1}, movingUp_{movingUp}, piece_size_{size}, type_{type}, kind_{kindOf(type)}, has_moved_{false} {
         // Check for fully alphabetical string & override "BLACK" if valid color
         setColor(color);
         
@@ -38,7 +55,8 @@ ChessPiece::ChessPiece(const std::string& color, const int& row, const int& col,
  * @brief Gets the color of the chess piece.
  * @return The string value stored in color_
  */
-std::string ChessPiece::getColor() const { 
+template <class Geometry>
+std::string BasicChessPiece<Geometry>::getColor() const { 
     return color_; 
 }
 
@@ -50,7 +68,8 @@ std::string ChessPiece::getColor() const {
  * @post The color_ member variable is updated to the parameter value in uppercase
  * @return True if the color was set sucessfully. False otherwise.
  */
-bool ChessPiece::setColor(const std::string& color) {
+template <class Geometry>
+bool BasicChessPiece<Geometry>::setColor(const std::string& color) {
     std::string uppercase = "";
     for (size_t i = 0; i < color.size() && std::isalpha(color[i]); i++) {
         uppercase += std::toupper(color[i]);
@@ -65,21 +84,14 @@ bool ChessPiece::setColor(const std::string& color) {
     return false;
 }
 
-/**
- * @brief Gets the row position of the chess piece.
- * @return The integer value stored in row_
- */
-int ChessPiece::getRow() const {
-    return row_;
-}
-
 /**
  * @brief Sets the row position of the chess piece 
  * @param row The new row of the piece as an integer
- *  If the supplied value is outside the board dimensions [0, BOARD_LENGTH), the ChessPiece is considered to be taken off the board, and its row AND column are set to -1 instead.
+ *  If the supplied value is outside the board dimensions [0, Geometry::ROW_COUNT), the ChessPiece is considered to be taken off the board, and its row AND column are set to -1 instead.
  */
-void ChessPiece::setRow(const int& row) {
-    if (row < 0 || row >= BOARD_LENGTH) {
+template <class Geometry>
+void BasicChessPiece<Geometry>::setRow(const int& row) {
+    if (!Geometry::containsRow(row)) {
         row_ = -1;
         column_ = -1;
         return ;
@@ -88,21 +100,14 @@ void ChessPiece::setRow(const int& row) {
     row_ = row;
 }
 
-/**
- * @brief Gets the column position of the chess piece.
- * @return The integer value stored in column_
- */
-int ChessPiece::getColumn() const {
-    return column_;
-}
-
 /**
  * @brief Sets the column position of the chess piece 
  * @param row A const reference to an integer representing the new column of the piece 
- *  If the supplied value is outside the board dimensions [0, BOARD_LENGTH), the ChessPiece is considered to be taken off the board, and its row AND column are set to -1 instead.
+ *  If the supplied value is outside the board dimensions [0, Geometry::COLUMN_COUNT), the ChessPiece is considered to be taken off the board, and its row AND column are set to -1 instead.
  */
-void ChessPiece::setColumn(const int& column) {
-    if (column < 0 || column >= BOARD_LENGTH) {
+template <class Geometry>
+void BasicChessPiece<Geometry>::setColumn(const int& column) {
+    if (!Geometry::containsColumn(column)) {
         row_ = -1;
         column_ = -1;
         return ;
@@ -111,19 +116,12 @@ void ChessPiece::setColumn(const int& column) {
     column_ = column;
 }
 
-/**
- * @brief Gets the value of the flag for if a chess piece is moving up
- * @return The boolean value stored in movingUp_
- */
-bool ChessPiece::isMovingUp() const {
-    return movingUp_;
-}
-
 /**
  * @brief Sets the movingUp flag of the chess piece 
  * @param flag A const reference to an boolean representing whether the piece is now moving up or not
  */
-void ChessPiece::setMovingUp(const bool& flag) {
+template <class Geometry>
+void BasicChessPiece<Geometry>::setMovingUp(const bool& flag) {
     movingUp_ = flag;
 }
 
@@ -135,7 +133,8 @@ void ChessPiece::setMovingUp(const bool& flag) {
      * <COLOR> PIECE is not on the board\n
      * @note "\n" just means endline in this case. Please use "std::endl," don't hardcode "\n".
      */
-void ChessPiece::display() const {
+template <class Geometry>
+void BasicChessPiece<Geometry>::display() const {
     if (row_ == -1 || column_ == -1) {
         std::cout << color_ << " piece is not on the board" << std::endl;
         return; 
@@ -148,21 +147,24 @@ void ChessPiece::display() const {
 /**
 * @brief Getter for the piece_size_ data member
 */
-int ChessPiece::size() const {
+template <class Geometry>
+int BasicChessPiece<Geometry>::size() const {
     return piece_size_;
 }
 
 /**
 * @brief Getter for the type_ data member
 */
-std::string ChessPiece::getType() const {
+template <class Geometry>
+std::string BasicChessPiece<Geometry>::getType() const {
     return type_;
 }
 
 /**
  * @brief Setter for the size_ data member
  */
-void ChessPiece::setSize(const int& size)  {
+template <class Geometry>
+void BasicChessPiece<Geometry>::setSize(const int& size)  {
     piece_size_ = size;
 }
 
@@ -170,21 +172,28 @@ void ChessPiece::setSize(const int& size)  {
 /**
  * @brief Setter for the type_ data member
  */
-void ChessPiece::setType(const std::string& type) {
+template <class Geometry>
+void BasicChessPiece<Geometry>::setType(const std::string& type) {
     type_ = type;
+    kind_ = kindOf(type);
 }
 
 /**
 * @brief Sets a ChessPiece's `has_moved_` member to true
 */
-void ChessPiece::flagMoved() {
+template <class Geometry>
+void BasicChessPiece<Geometry>::flagMoved() {
     has_moved_ = true;
 }
 
 /**
-* @brief Determines whether a ChessPiece has moved on the board
-* @return The value stored in the `has_moved_` member
-*/
-bool ChessPiece::hasMoved() const {
-    return has_moved_;
-}
\ No newline at end of file
+ * @brief Sets a ChessPiece's `has_moved_` member (eg. when restoring a saved board)
+ * @param flag A const reference to a boolean representing whether the piece has moved
+ */
+template <class Geometry>
+void BasicChessPiece<Geometry>::setMoved(const bool& flag) {
+    has_moved_ = flag;
+}
+
+template class BasicChessPiece<StandardGeometry>;
+template class BasicChessPiece<CapablancaGeometry>;
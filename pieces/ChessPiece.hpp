@@ -1,23 +1,30 @@
 /**
- * @class ChessPiece
- * @brief Represents a generic chess piece.
+ * @class BasicChessPiece
+ * @brief Represents a generic chess piece on a board of the given Geometry (see BoardGeometry.hpp).
  * 
- * This class serves as the base class for all chess pieces.
+ * This class serves as the base class for all chess pieces. ChessPiece is the piece of the standard 8x8 board.
  */
 
 #pragma once
 #include <iostream>
 #include <cctype>
 #include <vector>
+#include "BoardGeometry.hpp"
 
-class ChessPiece {
-   protected:
-      static const int BOARD_LENGTH = 8; // A constant value representing the number of rows & columns on the chessboard
+/**
+ * @brief The kind of a chess piece, for dispatching on it without a virtual call (see MoveRules.hpp)
+ */
+enum class PieceKind { NONE, PAWN, KNIGHT, BISHOP, ROOK, QUEEN, KING };
+
+template <class Geometry>
+class BasicChessPiece {
+   public:
+      using Board = std::vector<std::vector<BasicChessPiece*>>; // Cells indexed [row][col], nullptr when empty
 
    private:
       std::string color_;  // An uppercase, alphabetic string representing the color of the chess piece.
 
-      /** Consider an 8x8 grid with the following indexing:
+      /** Consider an 8x8 grid (Geometry::ROW_COUNT x Geometry::COLUMN_COUNT in general) with the following indexing:
          *  7 | * * * * * * * *
          *  6 | * * * * * * * *
          *  5 | * * * * * * * *
@@ -36,6 +43,7 @@ class ChessPiece {
       bool movingUp_;         // A boolean representing whether the piece is moving up the board (in reference to the visual above)
       int piece_size_;        // An integer representing the size of the current chess piece
       std::string type_;      // A string representing the type of the current chess piece
+      PieceKind kind_;        // The kind matching type_ (PieceKind::NONE for an unknown type)
       bool has_moved_;
 
    protected:
@@ -54,20 +62,20 @@ class ChessPiece {
     * Default row & columns: -1 (ie. represents that it has not been put on the board yet)
     * Default piece_size: 0
     */
-   ChessPiece();
+   BasicChessPiece();
 
      /**
     * @brief Parameterized constructor.
     * @param : A const reference to the color of the Chess Piece (a string). Set the color "BLACK" if the provided string contains non-alphabetic characters. 
     *     If the string is purely alphabetic, it is converted and stored in uppercase
-    * @param : The 0-indexed row position of the Chess Piece (as a const reference to an integer). Default value -1 if not provided, or if the value provided is outside the board's dimensions, [0, BOARD_LENGTH)
-    * @param : The 0-indexed column position of the Chess Piece (as a const reference to an integer). Default value -1 if not provided, or if the value provided is outside the board's dimensions, [0, BOARD_LENGTH)
+    * @param : The 0-indexed row position of the Chess Piece (as a const reference to an integer). Default value -1 if not provided, or if the value provided is outside the board's dimensions, [0, Geometry::ROW_COUNT)
+    * @param : The 0-indexed column position of the Chess Piece (as a const reference to an integer). Default value -1 if not provided, or if the value provided is outside the board's dimensions, [0, Geometry::COLUMN_COUNT)
     * @param : A flag indicating whether the Chess Piece is moving up on the board, or not (as a const reference to a boolean). Default value false if not provided.
     * @post : The private members are set to the values of the corresponding parameters. 
     *   If either of row or col are out-of-bounds and set to -1, the other is also set to -1 (regardless of being in-bounds or not).
     *   Default piece_size: 0
     */
-   ChessPiece(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false, const int& size = 0, const std::string& type="NONE");
+   BasicChessPiece(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false, const int& size = 0, const std::string& type="NONE");
 
    // =============== Getters and Setters ===============
 
@@ -91,12 +99,12 @@ class ChessPiece {
     * @brief Gets the row position of the chess piece.
     * @return The integer value stored in row_
     */
-   int getRow() const;
+   int getRow() const { return row_; }
 
    /**
     * @brief Sets the row position of the chess piece 
     * @param row A const reference to an integer representing the new row of the piece 
-    *  If the supplied value is outside the board dimensions [0, BOARD_LENGTH), the ChessPiece is considered to be taken off the board, and its row AND column are set to -1 instead.
+    *  If the supplied value is outside the board dimensions [0, Geometry::ROW_COUNT), the ChessPiece is considered to be taken off the board, and its row AND column are set to -1 instead.
     */
    void setRow(const int& row);
 
@@ -104,12 +112,12 @@ class ChessPiece {
     * @brief Gets the column position of the chess piece.
     * @return The integer value stored in column_
     */
-   int getColumn() const;
+   int getColumn() const { return column_; }
 
    /**
     * @brief Sets the column position of the chess piece 
     * @param row A const reference to an integer representing the new column of the piece 
-    *  If the supplied value is outside the board dimensions [0, BOARD_LENGTH), the ChessPiece is considered to be taken off the board, and its row AND column are set to -1 instead.
+    *  If the supplied value is outside the board dimensions [0, Geometry::COLUMN_COUNT), the ChessPiece is considered to be taken off the board, and its row AND column are set to -1 instead.
     */
    void setColumn(const int& column);
 
@@ -117,7 +125,7 @@ class ChessPiece {
     * @brief Gets the value of the flag for if a chess piece is moving up
     * @return The boolean value stored in movingUp_
     */
-   bool isMovingUp() const;
+   bool isMovingUp() const { return movingUp_; }
 
    /**
     * @brief Sets the movingUp flag of the chess piece 
@@ -145,24 +153,53 @@ class ChessPiece {
     * @brief Getter for the type_ data member
     */
    std::string getType() const;
+
+   /**
+    * @brief Getter for the kind_ data member
+    */
+   PieceKind kind() const { return kind_; }
+
+   /**
+    * @brief Determines whether `other` belongs to the same player, without copying either color
+    * @return True if both pieces have the same color
+    */
+   bool sameColor(const BasicChessPiece& other) const { return color_ == other.color_; }
+
+   /**
+    * @brief Determines whether the piece has the given (uppercase) color, without copying it
+    */
+   bool hasColor(const std::string& color) const { return color_ == color; }
    
    /**
      * @brief Determines whether the ChessPiece can move to the specified target position on the board.
      * @note This function is pure virtual, so its implementation will 
-     *       be left to its derived classes
+     *       be left to its derived classes. Each keeps its own rule, independent of MoveRules::canMove(),
+     *       so that it can serve as a reference. Callers in hot loops should use MoveRules::canMove():
+     *       it dispatches on kind() & can be inlined.
      * 
      * @return True if the ChessPiece can move to the specified position; false otherwise.
      */
-   virtual bool canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const = 0;
+   virtual bool canMove(const int& target_row, const int& target_col, const Board& board) const = 0;
 
    /**
     * @brief Determines whether a ChessPiece has moved on the board
     * @return The value stored in the `has_moved_` member
     */
-   bool hasMoved() const;
+   bool hasMoved() const { return has_moved_; }
 
    /**
     * @brief Sets a ChessPiece's `has_moved_` member to true
     */
    void flagMoved();
-};
\ No newline at end of file
+
+   /**
+    * @brief Sets a ChessPiece's `has_moved_` member (eg. when restoring a saved board)
+    * @param flag A const reference to a boolean representing whether the piece has moved
+    */
+   void setMoved(const bool& flag);
+};
+
+extern template class BasicChessPiece<StandardGeometry>;
+extern template class BasicChessPiece<CapablancaGeometry>;
+
+using ChessPiece = BasicChessPiece<StandardGeometry>;
@@ -8,13 +8,16 @@
 /**
  * @brief King class inheriting from ChessPiece.
  */
-class King : public ChessPiece {
+template <class Geometry>
+class BasicKing : public BasicChessPiece<Geometry> {
 public:
+    using typename BasicChessPiece<Geometry>::Board;
+
     /**
      * @brief Default Constructor for King. 
      * @post Sets piece_size_ to 4 and type to "KING"
      */
-    King();
+    BasicKing();
 
     /**
      * @brief Parameterized constructor.
@@ -23,7 +26,12 @@ public:
      * @param col: 0-indexed column position of the King.
      * @param movingUp: Flag indicating whether the King is moving up on the board.
      */
-    King(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false);
+    BasicKing(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false);
+
+    bool canMove(const int& target_row, const int& target_col, const Board& board) const override;
+};
+
+extern template class BasicKing<StandardGeometry>;
+extern template class BasicKing<CapablancaGeometry>;
 
-    bool canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const override;
-};
\ No newline at end of file
+using King = BasicKing<StandardGeometry>;
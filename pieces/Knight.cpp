@@ -4,7 +4,8 @@
  * @brief Default Constructor.
  * @post Sets piece_size_ to 3 and type to "KNIGHT"
  */
-Knight::Knight() : ChessPiece() { setSize(3); setType("KNIGHT"); }
+template <class Geometry>
+BasicKnight<Geometry>::BasicKnight() : BasicChessPiece<Geometry>() { this->setSize(3); this->setType("KNIGHT"); }
 
 /**
  * @brief Parameterized constructor.
@@ -13,22 +14,27 @@ Knight::Knight() : ChessPiece() { setSize(3); setType("KNIGHT"); }
  * @param col: 0-indexed column position of the Knight.
  * @param movingUp: Flag indicating whether the Knight is moving up.
  */
-Knight::Knight(const std::string& color, const int& row, const int& col, const bool& movingUp)
-    : ChessPiece(color, row, col, movingUp, 3, "KNIGHT") {}
+template <class Geometry>
+BasicKnight<Geometry>::BasicKnight(const std::string& color, const int& row, const int& col, const bool& movingUp)
+    : BasicChessPiece<Geometry>(color, row, col, movingUp, 3, "KNIGHT") {}
 
-bool Knight::canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const {
+template <class Geometry>
+bool BasicKnight<Geometry>::canMove(const int& target_row, const int& target_col, const Board& board) const {
     // Not on the board
-    if (getRow() == -1 || getColumn() == -1) { return false; }
+    if (this->getRow() == -1 || this->getColumn() == -1) { return false; }
 
     // Out of bounds target
-    if (target_row < 0 || target_row >= BOARD_LENGTH || target_col < 0 || target_col >= BOARD_LENGTH) { return false; }
+    if (!Geometry::contains(target_row, target_col)) { return false; }
 
-    ChessPiece* target_piece = board[target_row][target_col];
-    if (target_piece && target_piece->getColor() == getColor()) { return false; }
+    BasicChessPiece<Geometry>* target_piece = board[target_row][target_col];
+    if (target_piece && target_piece->getColor() == this->getColor()) { return false; }
 
-    int abs_dx = std::abs(getRow() - target_row);
-    int abs_dy = std::abs(getColumn() - target_col);
+    int abs_dx = std::abs(this->getRow() - target_row);
+    int abs_dy = std::abs(this->getColumn() - target_col);
 
     // Check for an L-shape move pattern
     return (abs_dx == 1 && abs_dy == 2) || (abs_dx == 2 && abs_dy == 1);
-}
\ No newline at end of file
+}
+
+template class BasicKnight<StandardGeometry>;
+template class BasicKnight<CapablancaGeometry>;
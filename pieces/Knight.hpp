@@ -8,13 +8,16 @@
 /**
  * @brief Knight class inheriting from ChessPiece.
  */
-class Knight : public ChessPiece {
+template <class Geometry>
+class BasicKnight : public BasicChessPiece<Geometry> {
 public:
+    using typename BasicChessPiece<Geometry>::Board;
+
     /**
      * @brief Default Constructor for Knight. 
      * @post Sets piece_size_ to 3 and type to "KNIGHT"
      */
-    Knight();
+    BasicKnight();
 
     /**
      * @brief Parameterized constructor.
@@ -23,7 +26,12 @@ public:
      * @param col: 0-indexed column position of the Knight.
      * @param movingUp: Flag indicating whether the Knight is moving up on the board.
      */
-    Knight(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false);
+    BasicKnight(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false);
+
+    bool canMove(const int& target_row, const int& target_col, const Board& board) const override;
+};
+
+extern template class BasicKnight<StandardGeometry>;
+extern template class BasicKnight<CapablancaGeometry>;
 
-    bool canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const override;
-};
\ No newline at end of file
+using Knight = BasicKnight<StandardGeometry>;
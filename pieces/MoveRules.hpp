@@ -0,0 +1,176 @@
+/**
+ * @file MoveRules.hpp
+ * @brief The movement rule of each piece, as inline functions dispatched on PieceKind.
+ *
+ * ChessPiece::canMove() is a virtual call through a heap pointer, which the compiler can
+ * neither inline nor see through, so a loop asking many pieces where they can go pays a
+ * call per question and gets no optimization across them. MoveRules::canMove() switches
+ * on the piece's kind() instead, and every rule is an inline function over the piece's
+ * inline getters: called from a loop, the whole rule is inlined into it.
+ *
+ * The pieces' canMove() overrides keep their own, independent implementation of each
+ * rule. They are the slow reference ReferenceCheck compares against, so they must not
+ * forward here: ChessBoard::move() takes this path, and movecheck checks it agrees.
+ *
+ * Only the six built-in classes take the static path. Any other ChessPiece subclass,
+ * including one that reuses a built-in type string, is still asked its own canMove().
+ */
+
+#pragma once
+
+#include <cstdlib>
+#include <typeinfo>
+#include "ChessPiece.hpp"
+#include "Pawn.hpp"
+#include "Knight.hpp"
+#include "Bishop.hpp"
+#include "Rook.hpp"
+#include "Queen.hpp"
+#include "King.hpp"
+
+namespace MoveRules {
+    /**
+     * @return True if `piece` is on the board, (target_row, target_col) is too, and it does
+     *         not hold a piece of the same color: the conditions shared by every rule
+     */
+    template <class Geometry>
+    inline bool canReach(const BasicChessPiece<Geometry>& piece, int target_row, int target_col,
+                         const typename BasicChessPiece<Geometry>::Board& board) {
+        if (piece.getRow() == -1 || piece.getColumn() == -1) { return false; }
+        if (!Geometry::contains(target_row, target_col)) { return false; }
+        const BasicChessPiece<Geometry>* target_piece = board[target_row][target_col];
+        return !target_piece || !target_piece->sameColor(piece);
+    }
+
+    /**
+     * @return True if no piece stands strictly between (row, col) & (target_row, target_col),
+     *         which must share a row, a column or a diagonal
+     */
+    template <class Geometry>
+    inline bool pathClear(int row, int col, int target_row, int target_col,
+                          const typename BasicChessPiece<Geometry>::Board& board) {
+        const int row_step = (target_row > row) - (target_row < row);
+        const int col_step = (target_col > col) - (target_col < col);
+        for (row += row_step, col += col_step; row != target_row || col != target_col; row += row_step, col += col_step) {
+            if (board[row][col]) { return false; }
+        }
+        return true;
+    }
+
+    /**
+     * @brief One row forward onto an empty cell, two from the starting cell if both are empty,
+     *        or one row forward diagonally onto an enemy piece
+     */
+    template <class Geometry>
+    inline bool pawn(const BasicChessPiece<Geometry>& piece, int target_row, int target_col,
+                     const typename BasicChessPiece<Geometry>::Board& board) {
+        if (!canReach(piece, target_row, target_col, board)) { return false; }
+        const BasicChessPiece<Geometry>* target_piece = board[target_row][target_col];
+        const int row = piece.getRow();
+        const int direction = piece.isMovingUp() ? 1 : -1;
+
+        if (!target_piece && piece.getColumn() == target_col) {
+            if (row + direction == target_row) { return true; }
+            return !piece.hasMoved() && row + direction * 2 == target_row && !board[row + direction][target_col];
+        }
+        return target_piece && std::abs(piece.getColumn() - target_col) == 1 && row + direction == target_row;
+    }
+
+    /**
+     * @brief An L-shape: two cells one way & one the other
+     */
+    template <class Geometry>
+    inline bool knight(const BasicChessPiece<Geometry>& piece, int target_row, int target_col,
+                       const typename BasicChessPiece<Geometry>::Board& board) {
+        if (!canReach(piece, target_row, target_col, board)) { return false; }
+        const int abs_dx = std::abs(piece.getRow() - target_row);
+        const int abs_dy = std::abs(piece.getColumn() - target_col);
+        return (abs_dx == 1 && abs_dy == 2) || (abs_dx == 2 && abs_dy == 1);
+    }
+
+    /**
+     * @brief Any distance along a diagonal, without jumping over a piece
+     */
+    template <class Geometry>
+    inline bool bishop(const BasicChessPiece<Geometry>& piece, int target_row, int target_col,
+                       const typename BasicChessPiece<Geometry>::Board& board) {
+        if (!canReach(piece, target_row, target_col, board)) { return false; }
+        const int dx = target_row - piece.getRow();
+        const int dy = target_col - piece.getColumn();
+        if (dx == 0 || std::abs(dx) != std::abs(dy)) { return false; }
+        return pathClear<Geometry>(piece.getRow(), piece.getColumn(), target_row, target_col, board);
+    }
+
+    /**
+     * @brief Any distance along a row or a column, without jumping over a piece
+     */
+    template <class Geometry>
+    inline bool rook(const BasicChessPiece<Geometry>& piece, int target_row, int target_col,
+                     const typename BasicChessPiece<Geometry>::Board& board) {
+        if (!canReach(piece, target_row, target_col, board)) { return false; }
+        const int dx = target_row - piece.getRow();
+        const int dy = target_col - piece.getColumn();
+        if ((dx == 0) == (dy == 0)) { return false; } // Staying put, or not a straight line
+        return pathClear<Geometry>(piece.getRow(), piece.getColumn(), target_row, target_col, board);
+    }
+
+    /**
+     * @brief Any distance along a row, a column or a diagonal, without jumping over a piece
+     */
+    template <class Geometry>
+    inline bool queen(const BasicChessPiece<Geometry>& piece, int target_row, int target_col,
+                      const typename BasicChessPiece<Geometry>::Board& board) {
+        if (!canReach(piece, target_row, target_col, board)) { return false; }
+        const int dx = target_row - piece.getRow();
+        const int dy = target_col - piece.getColumn();
+        if (dx == 0 && dy == 0) { return false; }
+        if (dx != 0 && dy != 0 && std::abs(dx) != std::abs(dy)) { return false; }
+        return pathClear<Geometry>(piece.getRow(), piece.getColumn(), target_row, target_col, board);
+    }
+
+    /**
+     * @brief One cell in any direction
+     */
+    template <class Geometry>
+    inline bool king(const BasicChessPiece<Geometry>& piece, int target_row, int target_col,
+                     const typename BasicChessPiece<Geometry>::Board& board) {
+        if (!canReach(piece, target_row, target_col, board)) { return false; }
+        return (target_row != piece.getRow() || target_col != piece.getColumn())
+            && std::abs(target_row - piece.getRow()) <= 1 && std::abs(target_col - piece.getColumn()) <= 1;
+    }
+
+    /**
+     * @brief Statically dispatched equivalent of piece.canMove(target_row, target_col, board)
+     * @return True if `piece` can move to (target_row, target_col); false otherwise.
+     *         Any piece that is not exactly one of the built-in classes (eg. a subclass with a rule
+     *         of its own, whatever its type string) is asked its virtual canMove() instead.
+     */
+    template <class Geometry>
+    inline bool canMove(const BasicChessPiece<Geometry>& piece, int target_row, int target_col,
+                        const typename BasicChessPiece<Geometry>::Board& board) {
+        const std::type_info& type = typeid(piece);
+        switch (piece.kind()) {
+            case PieceKind::PAWN:
+                if (type == typeid(BasicPawn<Geometry>)) { return pawn(piece, target_row, target_col, board); }
+                break;
+            case PieceKind::KNIGHT:
+                if (type == typeid(BasicKnight<Geometry>)) { return knight(piece, target_row, target_col, board); }
+                break;
+            case PieceKind::BISHOP:
+                if (type == typeid(BasicBishop<Geometry>)) { return bishop(piece, target_row, target_col, board); }
+                break;
+            case PieceKind::ROOK:
+                if (type == typeid(BasicRook<Geometry>)) { return rook(piece, target_row, target_col, board); }
+                break;
+            case PieceKind::QUEEN:
+                if (type == typeid(BasicQueen<Geometry>)) { return queen(piece, target_row, target_col, board); }
+                break;
+            case PieceKind::KING:
+                if (type == typeid(BasicKing<Geometry>)) { return king(piece, target_row, target_col, board); }
+                break;
+            default:
+                break;
+        }
+        return piece.canMove(target_row, target_col, board);
+    }
+};
@@ -5,26 +5,29 @@
 #include <vector>
 #include "ChessPiece.hpp"
 
-class Pawn : public ChessPiece {
+template <class Geometry>
+class BasicPawn : public BasicChessPiece<Geometry> {
     public:
+        using typename BasicChessPiece<Geometry>::Board;
+
         /**
          * @brief Default Constructor. All boolean values are default initialized to false.
          * @note Remember to construct the base-class as well
          */
-        Pawn();
+        BasicPawn();
 
         /**
         * @brief Parameterized constructor.
         * @param : A const reference to the color of the Pawn (a string). Set the color "BLACK" if the provided string contains non-alphabetic characters. 
         *     If the string is purely alphabetic, it is converted and stored in uppercase.
         *     NOTE: We do not supply a default value for color, the first parameter. Notice that if we do, we override the default constructor.
-        * @param : The 0-indexed row position of the Pawn (as a const reference to an integer). Default value -1 if not provided, or if the value provided is outside the board's dimensions, [0, BOARD_LENGTH)
-        * @param : The 0-indexed column position of the Pawn (as a const reference to an integer). Default value -1 if not provided, or if the value provided is outside the board's dimensions, [0, BOARD_LENGTH)
+        * @param : The 0-indexed row position of the Pawn (as a const reference to an integer). Default value -1 if not provided, or if the value provided is outside the board's dimensions, [0, Geometry::ROW_COUNT)
+        * @param : The 0-indexed column position of the Pawn (as a const reference to an integer). Default value -1 if not provided, or if the value provided is outside the board's dimensions, [0, Geometry::COLUMN_COUNT)
         * @param : A flag indicating whether the Pawn is moving up on the board, or not (as a const reference to a boolean). Default value false if not provided.
         * @post : The private members are set to the values of the corresponding parameters. 
         *   If either of row or col are out-of-bounds and set to -1, the other is also set to -1 (regardless of being in-bounds or not).
         */
-        Pawn(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false);
+        BasicPawn(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false);
 
         /**
          * @brief Gets the value of the flag for the Pawn can double jump
@@ -42,5 +45,10 @@ class Pawn : public ChessPiece {
          */
         bool canPromote() const;
 
-        bool canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const override;
-};
\ No newline at end of file
+        bool canMove(const int& target_row, const int& target_col, const Board& board) const override;
+};
+
+extern template class BasicPawn<StandardGeometry>;
+extern template class BasicPawn<CapablancaGeometry>;
+
+using Pawn = BasicPawn<StandardGeometry>;
@@ -4,7 +4,8 @@
  * @brief Default Constructor.
  * @post Sets piece_size_ to 9 and type to "QUEEN"
  */
-Queen::Queen() : ChessPiece() { setSize(4); setType("QUEEN"); }
+template <class Geometry>
+BasicQueen<Geometry>::BasicQueen() : BasicChessPiece<Geometry>() { this->setSize(4); this->setType("QUEEN"); }
 
 /**
  * @brief Parameterized constructor.
@@ -13,21 +14,23 @@ Queen::Queen() : ChessPiece() { setSize(4); setType("QUEEN"); }
  * @param col: 0-indexed column position of the Queen.
  * @param movingUp: Flag indicating whether the Queen is moving up.
  */
-Queen::Queen(const std::string& color, const int& row, const int& col, const bool& movingUp)
-    : ChessPiece(color, row, col, movingUp, 4, "QUEEN") {}
+template <class Geometry>
+BasicQueen<Geometry>::BasicQueen(const std::string& color, const int& row, const int& col, const bool& movingUp)
+    : BasicChessPiece<Geometry>(color, row, col, movingUp, 4, "QUEEN") {}
 
-bool Queen::canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const {
+template <class Geometry>
+bool BasicQueen<Geometry>::canMove(const int& target_row, const int& target_col, const Board& board) const {
     // Not on the board
-    if (getRow() == -1 || getColumn() == -1) { return false; }
+    if (this->getRow() == -1 || this->getColumn() == -1) { return false; }
 
     // Out of bounds target
-    if (target_row < 0 || target_row >= BOARD_LENGTH || target_col < 0 || target_col >= BOARD_LENGTH) { return false; }
+    if (!Geometry::contains(target_row, target_col)) { return false; }
 
-    ChessPiece* target_piece = board[target_row][target_col];
-    if (target_piece && target_piece->getColor() == getColor()) { return false; }
+    BasicChessPiece<Geometry>* target_piece = board[target_row][target_col];
+    if (target_piece && target_piece->getColor() == this->getColor()) { return false; }
 
-    int dx = target_row - getRow();
-    int dy = target_col - getColumn();
+    int dx = target_row - this->getRow();
+    int dy = target_col - this->getColumn();
 
     // Must move either straight or diagonal
     bool no_movement = (dx == 0) && (dy == 0);
@@ -42,11 +45,19 @@ bool Queen::canMove(const int& target_row, const int& target_col, const std::vec
     int col_offset = (dy) ? dy / std::abs(dy) : 0;
 
     // Iterate from the target space to the original space and check if there is any obstructing Chess Piece
-    while ((dx -= row_offset) != 0 && (dy -= col_offset) != 0) {
-        if (board[getRow() + dx][getColumn() + dy]) {
+    // Step both offsets together: on a straight line one of them stays 0 throughout
+    dx -= row_offset;
+    dy -= col_offset;
+    while (dx != 0 || dy != 0) {
+        if (board[this->getRow() + dx][this->getColumn() + dy]) {
             return false;
         }
+        dx -= row_offset;
+        dy -= col_offset;
     }
 
     return true;
 }
+
+template class BasicQueen<StandardGeometry>;
+template class BasicQueen<CapablancaGeometry>;
@@ -8,13 +8,16 @@
 /**
  * @brief Queen class inheriting from ChessPiece.
  */
-class Queen : public ChessPiece {
+template <class Geometry>
+class BasicQueen : public BasicChessPiece<Geometry> {
 public:
+    using typename BasicChessPiece<Geometry>::Board;
+
     /**
      * @brief Default Constructor for Queen. 
      * @post Sets piece_size_ to 4 and type to "QUEEN"
      */
-    Queen();
+    BasicQueen();
 
     /**
      * @brief Parameterized constructor.
@@ -23,7 +26,12 @@ public:
      * @param col: 0-indexed column position of the Queen.
      * @param movingUp: Flag indicating whether the Queen is moving up on the board.
      */
-    Queen(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false);
+    BasicQueen(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false);
+
+    bool canMove(const int& target_row, const int& target_col, const Board& board) const override;
+};
+
+extern template class BasicQueen<StandardGeometry>;
+extern template class BasicQueen<CapablancaGeometry>;
 
-    bool canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const override;
-};
\ No newline at end of file
+using Queen = BasicQueen<StandardGeometry>;
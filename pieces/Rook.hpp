@@ -6,30 +6,33 @@
 #include "ChessPiece.hpp"
 
 
-class Rook : public ChessPiece {
+template <class Geometry>
+class BasicRook : public BasicChessPiece<Geometry> {
     private: 
         int castle_moves_left_; // Default to 3
 
     public:
+        using typename BasicChessPiece<Geometry>::Board;
+
         /**
          * @brief Default Constructor. By default, Rooks have 3 available castle moves to make
          * @note Remember to default construct the base-class as well
          */
-        Rook();
+        BasicRook();
 
         /**
         * @brief Parameterized constructor. Rememeber to use the arguments to construct the underlying ChessPiece.
         * @param : A const reference to the color of the Rook (a string). Set the color "BLACK" if the provided string contains non-alphabetic characters. 
         *     If the string is purely alphabetic, it is converted and stored in uppercase
         *     NOTE: We do not supply a default value for color, the first parameter. Notice that if we do, we override the default constructor.
-        * @param : The 0-indexed row position of the Rook (as a const reference to an integer). Default value -1 if not provided, or if the value provided is outside the board's dimensions, [0, BOARD_LENGTH)
-        * @param : The 0-indexed column position of the Rook (as a const reference to an integer). Default value -1 if not provided, or if the value provided is outside the board's dimensions, [0, BOARD_LENGTH)
+        * @param : The 0-indexed row position of the Rook (as a const reference to an integer). Default value -1 if not provided, or if the value provided is outside the board's dimensions, [0, Geometry::ROW_COUNT)
+        * @param : The 0-indexed column position of the Rook (as a const reference to an integer). Default value -1 if not provided, or if the value provided is outside the board's dimensions, [0, Geometry::COLUMN_COUNT)
         * @param : A flag indicating whether the Rook is moving up on the board, or not (as a const reference to a boolean). Default value false if not provided.
         * @param : An integer representing how many castle moves it can make. Default to 3 if no value provided.
         * @post : The private members are set to the values of the corresponding parameters. 
         *   If either of row or col are out-of-bounds and set to -1, the other is also set to -1 (regardless of being in-bounds or not).
         */
-        Rook(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false, const int& castle_move_capacity = 3);
+        BasicRook(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false, const int& castle_move_capacity = 3);
 
     
        /**
@@ -41,7 +44,7 @@ class Rook : public ChessPiece {
          * @param ChessPiece A chess piece with which the rook may / may not be able to castle with
          * @return True if the rook can castle with the given piece. False otherwise.
          */
-        bool canCastle(const ChessPiece& target) const;
+        bool canCastle(const BasicChessPiece<Geometry>& target) const;
         
 
         /**
@@ -54,5 +57,10 @@ class Rook : public ChessPiece {
          * If it is adjacent, see if it can castle with the piece. 
          * If it is non-adj. 
          */
-        bool canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const override;
-};
\ No newline at end of file
+        bool canMove(const int& target_row, const int& target_col, const Board& board) const override;
+};
+
+extern template class BasicRook<StandardGeometry>;
+extern template class BasicRook<CapablancaGeometry>;
+
+using Rook = BasicRook<StandardGeometry>;
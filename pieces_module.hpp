@@ -1,7 +1,9 @@
+#include "pieces/BoardGeometry.hpp"
 #include "pieces/ChessPiece.hpp"
 #include "pieces/Pawn.hpp"
 #include "pieces/Rook.hpp"
 #include "pieces/Queen.hpp"
 #include "pieces/King.hpp"
 #include "pieces/Bishop.hpp"
-#include "pieces/Knight.hpp"
\ No newline at end of file
+#include "pieces/Knight.hpp"
+#include "pieces/MoveRules.hpp"
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#include "SessionPool.hpp"
+
+namespace {
+    // One cycle of the benchmark: both knights out & back, then Player Two's last move undone & replayed
+    const char* const BENCH_LINES[] = { "0 1", "2 2", "7 1", "5 2", "2 2", "0 1", "5 2", "7 1", "undo", "5 2", "7 1" };
+    const int BENCH_MOVES = 5;
+
+    /**
+     * @brief Plays `rounds` benchmark cycles in each of `count` sessions, all interleaved
+     * @return The process exit code: 1 if a session did not end where the cycles lead
+     */
+    int benchmark(int count, int rounds, unsigned threads) {
+        std::atomic<uint64_t> output_bytes{0};
+        SessionPool pool(threads, [&](int, const std::string& output) { output_bytes += output.size(); });
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; i++) { pool.open(); }
+        pool.drain();
+        const double open_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; round++) {
+            for (const char* line : BENCH_LINES) {
+                for (int session = 0; session < count; session++) { pool.post(session, line); }
+            }
+        }
+        pool.drain();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        int misplaced = 0;
+        for (int session = 0; session < count; session++) {
+            const ChessBoard& board = pool.session(session).board();
+            const ChessPiece* knight = board.getPieceAt(0, 1);
+            if (!board.isPlayerOneTurn() || !knight || knight->kind() != PieceKind::KNIGHT) { misplaced++; }
+        }
+
+        const double moves = static_cast<double>(count) * rounds * BENCH_MOVES;
+        std::cout << count << " sessions opened in " << open_seconds << "s\n"
+                  << moves << " moves (" << static_cast<double>(count) * rounds << " undos) in " << seconds << "s: "
+                  << (seconds * 1e6 / moves) << " us per move, " << output_bytes << " bytes of output\n"
+                  << (misplaced ? std::to_string(misplaced) + " sessions misplaced" : "all sessions ok") << std::endl;
+        return misplaced ? 1 : 0;
+    }
+}
+
+/**
+ * Runs ChessBoard games as GameSessions on a thread pool.
+ *
+ * Usage: sessions [-t <threads>] [-b <sessions> [-r <rounds>]]
+ *   eg.  sessions -t 4 -b 20000 -r 10
+ *
+ * Without -b, reads commands on stdin: `open` starts a session, & `<session> <input>`
+ * hands a line of input (eg. "1 0", or anything else to undo) to a session. Output is
+ * printed with the session it comes from, as "<session>: <text>".
+ * With -b, plays scripted knight moves in that many sessions at once & reports the time per move.
+ */
+int main(int argc, char** argv) {
+    unsigned threads = 0;
+    int bench_sessions = 0, rounds = 10;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "-t" && has_value) { threads = static_cast<unsigned>(std::atoi(argv[++i])); }
+        else if (arg == "-b" && has_value) { bench_sessions = std::atoi(argv[++i]); }
+        else if (arg == "-r" && has_value) { rounds = std::atoi(argv[++i]); }
+        else {
+            std::cerr << "Usage: " << argv[0] << " [-t <threads>] [-b <sessions> [-r <rounds>]]" << std::endl;
+            return 1;
+        }
+    }
+    if (bench_sessions > 0) { return benchmark(bench_sessions, rounds, threads); }
+
+    std::mutex output_mutex;
+    SessionPool pool(threads, [&](int session, const std::string& output) {
+        std::istringstream lines(output);
+        std::string line;
+        std::lock_guard<std::mutex> lock(output_mutex);
+        while (std::getline(lines, line)) { std::cout << session << ": " << line << '\n'; }
+        std::cout.flush();
+    });
+
+    std::string line;
+    while (std::getline(std::cin, line) && line != "quit") {
+        if (line == "open") {
+            pool.open();
+            continue;
+        }
+        std::istringstream args(line);
+        int session = -1;
+        std::string input;
+        args >> session;
+        std::getline(args >> std::ws, input);
+        if (!pool.post(session, input)) {
+            std::lock_guard<std::mutex> lock(output_mutex);
+            std::cout << "error unknown session" << std::endl;
+        }
+    }
+    pool.drain();
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "engine_module.hpp"
+
+/**
+ * Generates endgame tablebases by retrograde analysis.
+ *
+ * Usage: tbgen [-d <directory>] [-j <threads>] <signature>...
+ *   eg.  tbgen -d tables KQK KRK KPK KRPKR
+ *
+ * Tables already present in the directory are reused instead of being generated again.
+ */
+int main(int argc, char** argv) {
+    std::string directory = ".";
+    unsigned threads = 0;
+    std::vector<std::string> signatures;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "-d" && i + 1 < argc) { directory = argv[++i]; }
+        else if (arg == "-j" && i + 1 < argc) { threads = static_cast<unsigned>(std::atoi(argv[++i])); }
+        else { signatures.push_back(arg); }
+    }
+    if (signatures.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [-d <directory>] [-j <threads>] <signature>..." << std::endl;
+        return 1;
+    }
+
+    Tablebase::Tablebases tables;
+    tables.loadDirectory(directory);
+
+    TablebaseGenerator generator(directory, tables, threads);
+    const auto start = std::chrono::steady_clock::now();
+    generator.setProgressCallback([start](const std::string& message) {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        std::cout << "[" << elapsed.count() / 1000.0 << "s] " << message << std::endl;
+    });
+
+    for (const std::string& signature : signatures) {
+        if (!generator.generate(signature)) {
+            std::cerr << "Cannot generate " << signature << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
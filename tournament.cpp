@@ -0,0 +1,83 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "engine_module.hpp"
+
+/**
+ * Plays a self-play match between two engine configurations.
+ *
+ * Usage: tournament [-n <games>] [-j <threads>] [-o <openings>] [-p <games.pgn>] [-m <max plies>]
+ *                   [-a <settings>] [-b <settings>]
+ *   eg.  tournament -n 2000 -j 8 -o openings.fen -a name=qchecks,depth=5 -b name=plain,depth=5,qchecks=0
+ *
+ * Settings are those of EngineConfig::parse(); both engines default to a depth of 4.
+ * The score of A, its Elo difference with a 95% error bar & the games per second are
+ * printed every 100 games and at the end, followed by the hot-path counters when built with STATS=1.
+ */
+int main(int argc, char** argv) {
+    EngineConfig engines[2];
+    engines[0].name = "A";
+    engines[1].name = "B";
+    for (EngineConfig& engine : engines) { engine.limits.depth = 4; }
+    uint64_t games = 100;
+    unsigned threads = 0;
+    std::string openings_path, pgn_path;
+    int max_plies = Tournament::DEFAULT_MAX_PLIES;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "-n" && has_value) { games = std::strtoull(argv[++i], nullptr, 10); }
+        else if (arg == "-j" && has_value) { threads = static_cast<unsigned>(std::atoi(argv[++i])); }
+        else if (arg == "-o" && has_value) { openings_path = argv[++i]; }
+        else if (arg == "-p" && has_value) { pgn_path = argv[++i]; }
+        else if (arg == "-m" && has_value) { max_plies = std::atoi(argv[++i]); }
+        else if ((arg == "-a" || arg == "-b") && has_value) {
+            if (!engines[arg == "-a" ? 0 : 1].parse(argv[++i])) {
+                std::cerr << "Invalid engine settings: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [-n <games>] [-j <threads>] [-o <openings>] [-p <games.pgn>]"
+                      << " [-m <max plies>] [-a <settings>] [-b <settings>]" << std::endl;
+            return 1;
+        }
+    }
+
+    Tournament tournament(engines[0], engines[1]);
+    tournament.setMaxPlies(max_plies);
+    if (!openings_path.empty() && !tournament.loadOpenings(openings_path)) {
+        std::cerr << "Cannot read openings from " << openings_path << std::endl;
+        return 1;
+    }
+    std::ofstream pgn;
+    if (!pgn_path.empty()) {
+        pgn.open(pgn_path, std::ios::trunc);
+        if (!pgn) {
+            std::cerr << "Cannot create " << pgn_path << std::endl;
+            return 1;
+        }
+        tournament.setPgnOutput(&pgn);
+    }
+
+    auto report = [&](const MatchScore& score, double games_per_second) {
+        std::cout << engines[0].name << " vs " << engines[1].name << ": +" << score.wins << " =" << score.draws
+                  << " -" << score.losses << " (" << score.games() << "/" << games << ")  Elo "
+                  << std::fixed << std::setprecision(1) << score.elo() << " +/- " << score.eloError()
+                  << "  " << std::setprecision(2) << games_per_second << " games/s" << std::endl;
+    };
+    tournament.setGameCallback([&](const MatchScore& score, double games_per_second) {
+        if (score.games() % 100 == 0 && score.games() != games) { report(score, games_per_second); }
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    const MatchScore score = tournament.run(games, threads);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    report(score, score.games() / std::max(elapsed.count(), 1e-9));
+    if (Stats::ENABLED) { std::cout << Stats::collect().toTable(); }
+    return 0;
+}
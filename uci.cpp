@@ -0,0 +1,7 @@
+#include "UciEngine.hpp"
+
+int main() {
+    // Run the engine as a UCI process: commands on stdin, responses on stdout
+    UciEngine engine(std::cin, std::cout);
+    return engine.run();
+}